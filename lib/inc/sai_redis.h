@@ -14,6 +14,7 @@ extern "C" {
 #include "sai_redis_internal.h"
 
 #include "swss/redisclient.h"
+#include "swss/redisreply.h"
 #include "swss/dbconnector.h"
 #include "swss/producertable.h"
 #include "swss/consumertable.h"
@@ -59,6 +60,7 @@ extern volatile bool g_record;
 extern volatile bool g_useTempView;
 extern volatile bool g_asicInitViewMode;
 extern volatile bool g_logrotate;
+extern volatile bool g_latencyTrace;
 
 extern service_method_table_t                       g_services;
 extern std::shared_ptr<swss::ProducerTable>         g_asicState;
@@ -219,11 +221,31 @@ sai_status_t redis_generic_get_route_entry(
         _In_ uint32_t attr_count,
         _Out_ sai_attribute_t *attr_list);
 
+/**
+ * @brief Pushes latency trace stamp of operation which is about to be sent to
+ * syncd, when latency tracing is enabled.
+ */
+void redis_trace_stamp();
+
 // notifications
 
 void handle_notification(
         _In_ const std::string &notification,
         _In_ const std::string &data,
-        _In_ const std::vector<swss::FieldValueTuple> &values);
+        _Inout_ std::vector<swss::FieldValueTuple> &values);
+
+size_t get_notification_priority(
+        _In_ const std::string &notification);
+
+size_t get_notification_priority_count();
+
+bool is_notification_priority_critical(
+        _In_ size_t priority);
+
+void record_notification_latency(
+        _In_ const std::string &notification,
+        _Inout_ std::vector<swss::FieldValueTuple> &values);
+
+void log_notification_latency();
 
 #endif // __SAI_REDIS__
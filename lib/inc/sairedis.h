@@ -7,17 +7,83 @@ extern "C" {
 
 #define SYNCD_INIT_VIEW  "INIT_VIEW"
 #define SYNCD_APPLY_VIEW "APPLY_VIEW"
+#define SYNCD_DUMP_LATENCY "DUMP_LATENCY"
+#define SYNCD_LATENCY_TRACE_ENABLE "LATENCY_TRACE_ENABLE"
+#define SYNCD_LATENCY_TRACE_DISABLE "LATENCY_TRACE_DISABLE"
+#define SYNCD_DUMP_PROFILE "DUMP_PROFILE"
 #define ASIC_STATE_TABLE "ASIC_STATE"
 #define TEMP_PREFIX      "TEMP_"
 
+/**
+ * @brief Notification field with time when syncd received notification from
+ * SAI, in nanoseconds of monotonic clock.
+ */
+#define SYNCD_NOTIFICATION_TIMESTAMP "timestamp"
+
+/**
+ * @brief Notification field with sequence number assigned by syncd when
+ * notification was received from SAI. Sequence is per notification type,
+ * so consumer can detect missed notifications.
+ */
+#define SYNCD_NOTIFICATION_SEQUENCE "sequence"
+
+/**
+ * @brief Notification field with time when syncd sent notification, in
+ * nanoseconds of monotonic clock.
+ */
+#define SYNCD_NOTIFICATION_SEND_TIMESTAMP "send_timestamp"
+
+/**
+ * @brief Redis list in ASIC DB with latency trace stamps pushed by sairedis
+ * when SAI_REDIS_SWITCH_ATTR_LATENCY_TRACE is enabled.
+ *
+ * Stamp is pushed right before stamped operation is sent to ASIC_STATE, so
+ * stamps are in the same order as stamped operations and syncd pops one
+ * stamp for each of them. Value is in format "sequence:send_timestamp",
+ * where send timestamp is in nanoseconds of monotonic clock. Stamps are kept
+ * out of operation values, so they never reach ASIC view.
+ */
+#define SAI_REDIS_TRACE_TABLE "SAI_REDIS_TRACE"
+
 typedef enum _sai_redis_notify_syncd_t
 {
     SAI_REDIS_NOTIFY_SYNCD_INIT_VIEW,
 
-    SAI_REDIS_NOTIFY_SYNCD_APPLY_VIEW
+    SAI_REDIS_NOTIFY_SYNCD_APPLY_VIEW,
+
+    SAI_REDIS_NOTIFY_SYNCD_DUMP_LATENCY,
+
+    /**
+     * @brief Dump statistics of vendor SAI calls and trace of calls since
+     * previous dump. Syncd must be started with SAI profiler enabled.
+     */
+    SAI_REDIS_NOTIFY_SYNCD_DUMP_PROFILE
 
 } sai_redis_notify_syncd_t;
 
+typedef enum _sai_redis_validation_level_t
+{
+    /**
+     * @brief All API calls are fully validated.
+     */
+    SAI_REDIS_VALIDATION_LEVEL_FULL,
+
+    /**
+     * @brief Every Nth API call is fully validated, other calls only keep
+     * bookkeeping.
+     */
+    SAI_REDIS_VALIDATION_LEVEL_SAMPLING,
+
+    /**
+     * @brief Only object existence and references are checked.
+     *
+     * Intended for trusted clients on hot paths like routes. When check
+     * fails, call is fully validated to report actual error.
+     */
+    SAI_REDIS_VALIDATION_LEVEL_BOOKKEEPING
+
+} sai_redis_validation_level_t;
+
 typedef enum _sai_redis_switch_attr_t
 {
     /**
@@ -101,6 +167,41 @@ typedef enum _sai_redis_switch_attr_t
      */
     SAI_REDIS_SWITCH_ATTR_PERFORM_LOG_ROTATE,
 
+    /**
+     * @brief Enable latency tracing.
+     *
+     * When enabled, every create, remove and set operation (including bulk)
+     * sent to syncd is stamped with monotonic sequence number and send
+     * timestamp, so syncd can measure time spent in ASIC_STATE queue and end
+     * to end latency per object type and api. Stamps are sent in
+     * SAI_REDIS_TRACE_TABLE list. Syncd is notified before tracing starts and
+     * after it stops, so it pops stamps only when they are pushed.
+     *
+     * Syncd stage histograms are published to COUNTERS_DB
+     * SYNCD_LATENCY_STATS table, and can be dumped together with recent
+     * operations by SAI_REDIS_NOTIFY_SYNCD_DUMP_LATENCY.
+     *
+     * @type bool
+     * @flags CREATE_AND_SET
+     * @default false
+     */
+    SAI_REDIS_SWITCH_ATTR_LATENCY_TRACE,
+
+    /**
+     * @brief Set meta validation level.
+     *
+     * List contains object type, validation level (sai_redis_validation_level_t)
+     * and optional sample rate, required for sampling level. Object type
+     * SAI_OBJECT_TYPE_NULL sets level on all object types.
+     *
+     * Level is per process, it applies to all switches.
+     *
+     * @type sai_u32_list_t
+     * @flags CREATE_AND_SET
+     * @default empty
+     */
+    SAI_REDIS_SWITCH_ATTR_VALIDATION_LEVEL,
+
 } sai_redis_switch_attr_t;
 
 /*
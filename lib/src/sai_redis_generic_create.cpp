@@ -231,6 +231,8 @@ sai_status_t internal_redis_generic_create(
         recordLine("c|" + key + "|" + joinFieldValues(entry));
     }
 
+    redis_trace_stamp();
+
     g_asicState->set(key, entry, "create");
 
     // we assume create will always succeed which may not be true
@@ -385,6 +387,8 @@ sai_status_t internal_redis_bulk_generic_create(
 
     if (entries.size())
     {
+        redis_trace_stamp();
+
         g_asicState->set(key, entries, "bulkcreate");
     }
 
@@ -184,6 +184,7 @@ sai_status_t internal_redis_generic_get(
 
     // get is special, it will not put data
     // into asic view, only to message queue
+
     g_asicState->set(key, entry, "get");
 
     // wait for response
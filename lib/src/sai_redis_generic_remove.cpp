@@ -19,6 +19,8 @@ sai_status_t internal_redis_generic_remove(
         recordLine("r|" + key);
     }
 
+    redis_trace_stamp();
+
     g_asicState->del(key, "remove");
 
     return SAI_STATUS_SUCCESS;
@@ -26,6 +26,8 @@ sai_status_t internal_redis_generic_set(
         recordLine("s|" + key + "|" + joinFieldValues(entry));
     }
 
+    redis_trace_stamp();
+
     g_asicState->set(key, entry, "set");
 
     return SAI_STATUS_SUCCESS;
@@ -107,6 +109,8 @@ sai_status_t internal_redis_bulk_generic_set(
 
     if (entries.size())
     {
+        redis_trace_stamp();
+
         g_asicState->set(key, entries, "bulkset");
     }
 
@@ -1,9 +1,14 @@
 #include "sai_redis.h"
 #include "sairedis.h"
 
+#include "meta/saiworkerpool.h"
+
 #include "swss/selectableevent.h"
 #include <string.h>
 
+#include <chrono>
+#include <deque>
+
 std::mutex g_apimutex;
 
 service_method_table_t g_services;
@@ -21,6 +26,52 @@ std::shared_ptr<swss::ConsumerTable>        g_redisGetConsumer;
 std::shared_ptr<swss::NotificationConsumer> g_redisNotifications;
 std::shared_ptr<swss::RedisClient>          g_redisClient;
 
+volatile bool g_latencyTrace = false;
+
+/*
+ * Sequence number of last stamped operation, all operations are sent under
+ * g_apimutex.
+ */
+uint64_t g_traceSequence = 0;
+
+/*
+ * Stamps are popped by syncd only after it was notified that tracing is
+ * enabled, if it's not popping them (for example after syncd restart), stop
+ * tracing instead of growing the list without limit.
+ */
+#define SAI_REDIS_TRACE_MAX_PENDING (64 * 1024)
+
+void redis_trace_stamp()
+{
+    SWSS_LOG_ENTER();
+
+    if (!g_latencyTrace)
+    {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+
+    uint64_t timestamp = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+
+    std::string stamp = std::to_string(++g_traceSequence) + ":" + std::to_string(timestamp);
+
+    swss::RedisCommand rpush;
+
+    rpush.format("RPUSH %s %s", SAI_REDIS_TRACE_TABLE, stamp.c_str());
+
+    swss::RedisReply r(g_db.get(), rpush, REDIS_REPLY_INTEGER);
+
+    if (r.getContext()->integer > SAI_REDIS_TRACE_MAX_PENDING)
+    {
+        SWSS_LOG_ERROR("syncd is not popping latency trace stamps, disabling latency trace");
+
+        g_latencyTrace = false;
+
+        g_redisClient->del(SAI_REDIS_TRACE_TABLE);
+    }
+}
+
 void clear_local_state()
 {
     SWSS_LOG_ENTER();
@@ -53,6 +104,54 @@ void clear_local_state()
     redis_clear_switch_ids();
 }
 
+/*
+ * Maximum number of notifications which are read from redis before they are
+ * dispatched by priority.
+ */
+#define NOTIFICATION_DISPATCH_BATCH         1024
+
+#define NOTIFICATION_LATENCY_LOG_INTERVAL   60
+
+typedef struct _pending_notification_t
+{
+    std::string op;
+    std::string data;
+    std::vector<swss::FieldValueTuple> values;
+
+} pending_notification_t;
+
+/**
+ * @brief Dispatches read notifications in priority order.
+ *
+ * @param criticalOnly Dispatch only notifications which can't be missed,
+ * used on shutdown when rest of batch will be dropped.
+ */
+static void dispatch_notifications(
+        _Inout_ std::vector<std::deque<pending_notification_t>> &pending,
+        _In_ bool criticalOnly)
+{
+    SWSS_LOG_ENTER();
+
+    for (size_t priority = 0; priority < pending.size(); priority++)
+    {
+        auto &queue = pending[priority];
+
+        if (criticalOnly && !queue.empty() && !is_notification_priority_critical(priority))
+        {
+            SWSS_LOG_NOTICE("dropping %zu notifications on shutdown", queue.size());
+        }
+        else
+        {
+            for (auto &ntf: queue)
+            {
+                handle_notification(ntf.op, ntf.data, ntf.values);
+            }
+        }
+
+        queue.clear();
+    }
+}
+
 void ntf_thread()
 {
     SWSS_LOG_ENTER();
@@ -62,6 +161,10 @@ void ntf_thread()
     s.addSelectable(g_redisNotifications.get());
     s.addSelectable(&g_redisNotificationTrheadEvent);
 
+    std::vector<std::deque<pending_notification_t>> pending(get_notification_priority_count());
+
+    auto lastLatencyLog = std::chrono::steady_clock::now();
+
     while (g_run)
     {
         swss::Selectable *sel;
@@ -70,25 +173,49 @@ void ntf_thread()
 
         int result = s.select(&sel, &fd);
 
-        if (sel == &g_redisNotificationTrheadEvent)
-        {
-            // user requested shutdown_switch
-            break;
-        }
+        /*
+         * Read all notifications which already arrived without blocking, so
+         * higher priority notifications can be dispatched ahead of lower
+         * priority ones, like port state change during fdb learning storm.
+         */
 
-        if (result == swss::Select::OBJECT)
+        for (size_t count = 0; count < NOTIFICATION_DISPATCH_BATCH; count++)
         {
-            swss::KeyOpFieldsValuesTuple kco;
+            if (sel == &g_redisNotificationTrheadEvent)
+            {
+                // user requested shutdown_switch, notifications already
+                // read from this batch can't be read again
+
+                dispatch_notifications(pending, true);
 
-            std::string op;
-            std::string data;
-            std::vector<swss::FieldValueTuple> values;
+                return;
+            }
 
-            g_redisNotifications->pop(op, data, values);
+            if (result != swss::Select::OBJECT)
+            {
+                break;
+            }
 
-            SWSS_LOG_DEBUG("notification: op = %s, data = %s", op.c_str(), data.c_str());
+            pending_notification_t ntf;
 
-            handle_notification(op, data, values);
+            g_redisNotifications->pop(ntf.op, ntf.data, ntf.values);
+
+            SWSS_LOG_DEBUG("notification: op = %s, data = %s", ntf.op.c_str(), ntf.data.c_str());
+
+            pending.at(get_notification_priority(ntf.op)).push_back(std::move(ntf));
+
+            result = s.select(&sel, &fd, 0);
+        }
+
+        dispatch_notifications(pending, false);
+
+        auto now = std::chrono::steady_clock::now();
+
+        if (now - lastLatencyLog >= std::chrono::seconds(NOTIFICATION_LATENCY_LOG_INTERVAL))
+        {
+            log_notification_latency();
+
+            lastLatencyLog = now;
         }
     }
 }
@@ -126,6 +253,12 @@ sai_status_t sai_api_initialize(
 
     clear_local_state();
 
+    /*
+     * Pool exists only while api is initialized, it's released in uninitialize.
+     */
+
+    meta_set_worker_pool(std::make_shared<WorkerPool>(std::thread::hardware_concurrency()));
+
     g_asicInitViewMode = false;
 
     g_useTempView = false;
@@ -165,6 +298,8 @@ sai_status_t sai_api_uninitialize(void)
 
     notification_thread->join();
 
+    meta_set_worker_pool(nullptr);
+
     g_apiInitialized = false;
 
     return SAI_STATUS_SUCCESS;
@@ -1,7 +1,12 @@
 #include "sai_redis.h"
+#include "sairedis.h"
 #include "meta/saiserialize.h"
 #include "meta/saiattributelist.h"
 
+#include <algorithm>
+#include <chrono>
+#include <functional>
+
 /*
  * NOTE: currently we only support 1 set of notifications per all switches,
  * this will need to be corrected later.
@@ -208,44 +213,282 @@ void handle_queue_deadlock_event(
     sai_deserialize_free_queue_deadlock_ntf(count, ntfData);
 }
 
-void handle_notification(
-        _In_ const std::string &notification,
-        _In_ const std::string &data,
-        _In_ const std::vector<swss::FieldValueTuple> &values)
+typedef std::function<void(const std::string&, const std::vector<swss::FieldValueTuple>&)> notification_handler_fn;
+
+typedef struct _notification_type_t
 {
-    SWSS_LOG_ENTER();
+    std::string name;
 
-    if (g_record)
-    {
-        recordLine("n|" + notification + "|" + data + "|" + joinFieldValues(values));
-    }
+    notification_handler_fn handler;
+
+    /**
+     * @brief Missed notification of this type leaves state out of sync with
+     * hardware, so it's logged as error right away.
+     */
+    bool critical;
+
+} notification_type_t;
+
+/*
+ * Notification types in strict priority order, same as in syncd. Shutdown
+ * request, port state and queue deadlock are dispatched ahead of fdb events.
+ */
+static const std::vector<notification_type_t> g_notificationTypes =
+{
+    { "switch_shutdown_request",    [](const std::string &data, const std::vector<swss::FieldValueTuple>&) { handle_switch_shutdown_request(data); }, true },
+    { "port_state_change",          [](const std::string &data, const std::vector<swss::FieldValueTuple>&) { handle_port_state_change(data); }, true },
+    { "queue_deadlock",             [](const std::string &data, const std::vector<swss::FieldValueTuple>&) { handle_queue_deadlock_event(data); }, true },
+    { "switch_state_change",        [](const std::string &data, const std::vector<swss::FieldValueTuple>&) { handle_switch_state_change(data); }, true },
+    { "fdb_event",                  [](const std::string &data, const std::vector<swss::FieldValueTuple>&) { handle_fdb_event(data); }, false },
+    { "packet_event",               handle_packet_event, false },
+};
+
+typedef struct _notification_latency_t
+{
+    uint64_t count;
+
+    uint64_t sum;
 
-    if (notification == "switch_state_change")
+    uint64_t max;
+
+    void record(
+            _In_ uint64_t start,
+            _In_ uint64_t end)
     {
-        handle_switch_state_change(data);
+        SWSS_LOG_ENTER();
+
+        if (start == 0 || end < start)
+        {
+            return;
+        }
+
+        uint64_t latency = (end - start) / 1000;
+
+        count++;
+        sum += latency;
+        max = std::max(max, latency);
     }
-    else if (notification == "fdb_event")
+
+} notification_latency_t;
+
+typedef struct _notification_stage_latency_t
+{
+    /*
+     * SAI callback in syncd to syncd send.
+     */
+    notification_latency_t syncd;
+
+    /*
+     * Syncd send to handle_notification.
+     */
+    notification_latency_t delivery;
+
+    /*
+     * SAI callback in syncd to handle_notification.
+     */
+    notification_latency_t total;
+
+} notification_stage_latency_t;
+
+/*
+ * Latency of notifications stages in microseconds, per notification type.
+ * Accessed only from notifications thread.
+ */
+static std::vector<notification_stage_latency_t> g_notificationLatency(g_notificationTypes.size() + 1);
+
+/*
+ * Last sequence number received per notification type. Accessed only from
+ * notifications thread.
+ */
+static std::vector<uint64_t> g_notificationLastSequence(g_notificationTypes.size() + 1);
+
+size_t get_notification_priority(
+        _In_ const std::string &notification)
+{
+    SWSS_LOG_ENTER();
+
+    for (size_t idx = 0; idx < g_notificationTypes.size(); idx++)
     {
-        handle_fdb_event(data);
+        if (g_notificationTypes[idx].name == notification)
+        {
+            return idx;
+        }
     }
-    else if (notification == "port_state_change")
+
+    /*
+     * Unknown notifications have lowest priority.
+     */
+
+    return g_notificationTypes.size();
+}
+
+size_t get_notification_priority_count()
+{
+    SWSS_LOG_ENTER();
+
+    return g_notificationTypes.size() + 1;
+}
+
+bool is_notification_priority_critical(
+        _In_ size_t priority)
+{
+    SWSS_LOG_ENTER();
+
+    return priority < g_notificationTypes.size() && g_notificationTypes[priority].critical;
+}
+
+/**
+ * @brief Checks for gaps in per type sequence assigned by syncd.
+ *
+ * Gap means critical notification was dropped somewhere between SAI callback
+ * in syncd and this process. Fdb events are coalesced by syncd, so gaps in
+ * them are expected and they are not checked.
+ */
+void check_notification_sequence(
+        _In_ const std::string &notification,
+        _In_ uint64_t sequence)
+{
+    SWSS_LOG_ENTER();
+
+    size_t priority = get_notification_priority(notification);
+
+    if (sequence == 0 || !is_notification_priority_critical(priority))
     {
-        handle_port_state_change(data);
+        return;
     }
-    else if (notification == "switch_shutdown_request")
+
+    uint64_t &last = g_notificationLastSequence[priority];
+
+    if (last != 0 && sequence > last + 1)
     {
-        handle_switch_shutdown_request(data);
+        SWSS_LOG_ERROR("missed %lu %s notifications (sequence %lu after %lu), state may be out of sync",
+                sequence - last - 1,
+                notification.c_str(),
+                sequence,
+                last);
     }
-    else if (notification == "packet_event")
+
+    /*
+     * Sequence going back means syncd was restarted.
+     */
+
+    last = sequence;
+}
+
+void record_notification_latency(
+        _In_ const std::string &notification,
+        _Inout_ std::vector<swss::FieldValueTuple> &values)
+{
+    SWSS_LOG_ENTER();
+
+    uint64_t timestamp = 0;
+    uint64_t sendTimestamp = 0;
+    uint64_t sequence = 0;
+
+    /*
+     * Stamps are only used for latency measurement, so they are removed in
+     * place before notification is passed to handlers.
+     */
+
+    auto stamp = [&](const swss::FieldValueTuple &fv) {
+        const std::string &field = fvField(fv);
+
+        if (field == SYNCD_NOTIFICATION_TIMESTAMP)
+        {
+            timestamp = std::stoull(fvValue(fv));
+        }
+        else if (field == SYNCD_NOTIFICATION_SEND_TIMESTAMP)
+        {
+            sendTimestamp = std::stoull(fvValue(fv));
+        }
+        else if (field == SYNCD_NOTIFICATION_SEQUENCE)
+        {
+            sequence = std::stoull(fvValue(fv));
+        }
+        else
+        {
+            return false;
+        }
+
+        return true;
+    };
+
+    values.erase(std::remove_if(values.begin(), values.end(), stamp), values.end());
+
+    check_notification_sequence(notification, sequence);
+
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+
+    uint64_t handleTimestamp = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+
+    notification_stage_latency_t &stats = g_notificationLatency.at(get_notification_priority(notification));
+
+    stats.syncd.record(timestamp, sendTimestamp);
+    stats.delivery.record(sendTimestamp, handleTimestamp);
+    stats.total.record(timestamp, handleTimestamp);
+}
+
+void log_notification_latency()
+{
+    SWSS_LOG_ENTER();
+
+    for (size_t idx = 0; idx < g_notificationTypes.size(); idx++)
     {
-        handle_packet_event(data, values);
+        notification_stage_latency_t &stats = g_notificationLatency[idx];
+
+        const std::vector<std::pair<const char*, const notification_latency_t*>> stages =
+        {
+            { "syncd",      &stats.syncd },
+            { "delivery",   &stats.delivery },
+            { "total",      &stats.total },
+        };
+
+        for (const auto &stage: stages)
+        {
+            if (stage.second->count == 0)
+            {
+                continue;
+            }
+
+            SWSS_LOG_NOTICE("%s %s latency: count %lu, mean %lu us, max %lu us",
+                    g_notificationTypes[idx].name.c_str(),
+                    stage.first,
+                    stage.second->count,
+                    stage.second->sum / stage.second->count,
+                    stage.second->max);
+        }
+
+        stats = notification_stage_latency_t();
     }
-    else if (notification == "queue_deadlock")
+}
+
+void handle_notification(
+        _In_ const std::string &notification,
+        _In_ const std::string &data,
+        _Inout_ std::vector<swss::FieldValueTuple> &values)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Notification carries sequence number and timestamps from SAI callback
+     * in syncd, which are removed here after latency is recorded.
+     */
+
+    record_notification_latency(notification, values);
+
+    if (g_record)
     {
-        handle_queue_deadlock_event(data);
+        recordLine("n|" + notification + "|" + data + "|" + joinFieldValues(values));
     }
-    else
+
+    size_t priority = get_notification_priority(notification);
+
+    if (priority >= g_notificationTypes.size())
     {
         SWSS_LOG_ERROR("unknow notification: %s", notification.c_str());
+
+        return;
     }
+
+    g_notificationTypes[priority].handler(data, values);
 }
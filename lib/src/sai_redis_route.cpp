@@ -102,18 +102,20 @@ sai_status_t sai_bulk_create_route_entry(
                 sai_serialize_route_entry(route_entry[idx]));
     }
 
+    meta_sai_bulk_create_route_entry(
+            object_count,
+            route_entry,
+            attr_count,
+            attr_list,
+            type,
+            object_statuses,
+            &redis_dummy_create_route_entry);
+
     for (uint32_t idx = 0; idx < object_count; ++idx)
     {
-        sai_status_t status =
-            meta_sai_create_route_entry(
-                    &route_entry[idx],
-                    attr_count[idx],
-                    attr_list[idx],
-                    &redis_dummy_create_route_entry);
-
-        object_statuses[idx] = status;
+        sai_status_t status = object_statuses[idx];
 
-        if (status != SAI_STATUS_SUCCESS)
+        if (status != SAI_STATUS_SUCCESS && status != SAI_STATUS_NOT_EXECUTED)
         {
             // TODO add attr id and value
 
@@ -111,6 +111,16 @@ sai_status_t sai_redis_notify_syncd(
             g_asicInitViewMode = false;
             break;
 
+        case SAI_REDIS_NOTIFY_SYNCD_DUMP_LATENCY:
+            SWSS_LOG_NOTICE("sending syncd DUMP latency");
+            op = SYNCD_DUMP_LATENCY;
+            break;
+
+        case SAI_REDIS_NOTIFY_SYNCD_DUMP_PROFILE:
+            SWSS_LOG_NOTICE("sending syncd DUMP profile");
+            op = SYNCD_DUMP_PROFILE;
+            break;
+
         default:
             SWSS_LOG_ERROR("invalid notify syncd attr value %d", attr->value.s32);
             return SAI_STATUS_FAILURE;
@@ -136,6 +146,82 @@ sai_status_t sai_redis_notify_syncd(
     return SAI_STATUS_SUCCESS;
 }
 
+sai_status_t sai_redis_set_latency_trace(
+        _In_ bool enable)
+{
+    SWSS_LOG_ENTER();
+
+    if (enable == g_latencyTrace)
+    {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    /*
+     * Syncd pops stamp for each stamped operation, so it must know about
+     * tracing before first stamp is pushed, and must stop popping only after
+     * last stamped operation.
+     */
+
+    if (!enable)
+    {
+        g_latencyTrace = false;
+    }
+
+    sai_status_t status = sai_redis_internal_notify_syncd(enable ? SYNCD_LATENCY_TRACE_ENABLE : SYNCD_LATENCY_TRACE_DISABLE);
+
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("notify syncd latency trace failed: %s", sai_serialize_status(status).c_str());
+        return status;
+    }
+
+    g_latencyTrace = enable;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_redis_set_validation_level(
+        _In_ const sai_attribute_t *attr)
+{
+    SWSS_LOG_ENTER();
+
+    const sai_u32_list_t& list = attr->value.u32list;
+
+    if (list.list == NULL || list.count < 2 || list.count > 3)
+    {
+        SWSS_LOG_ERROR("validation level expects object type, level and optional sample rate");
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    sai_object_type_t object_type = (sai_object_type_t)list.list[0];
+
+    uint32_t sample_rate = list.count > 2 ? list.list[2] : 0;
+
+    sai_meta_validation_level_t level;
+
+    switch (list.list[1])
+    {
+        case SAI_REDIS_VALIDATION_LEVEL_FULL:
+            level = SAI_META_VALIDATION_LEVEL_FULL;
+            break;
+
+        case SAI_REDIS_VALIDATION_LEVEL_SAMPLING:
+            level = SAI_META_VALIDATION_LEVEL_SAMPLING;
+            break;
+
+        case SAI_REDIS_VALIDATION_LEVEL_BOOKKEEPING:
+            level = SAI_META_VALIDATION_LEVEL_BOOKKEEPING;
+            break;
+
+        default:
+            SWSS_LOG_ERROR("invalid validation level %u", list.list[1]);
+            return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return meta_set_validation_level(object_type, level, sample_rate);
+}
+
 sai_status_t redis_create_switch(
         _Out_ sai_object_id_t* switch_id,
         _In_ uint32_t attr_count,
@@ -272,6 +358,12 @@ sai_status_t redis_set_switch_attribute(
             case SAI_REDIS_SWITCH_ATTR_RECORDING_OUTPUT_DIR:
                 return setRecordingOutputDir(*attr);
 
+            case SAI_REDIS_SWITCH_ATTR_LATENCY_TRACE:
+                return sai_redis_set_latency_trace(attr->value.booldata);
+
+            case SAI_REDIS_SWITCH_ATTR_VALIDATION_LEVEL:
+                return sai_redis_set_validation_level(attr);
+
             default:
                 break;
         }
@@ -1,10 +1,14 @@
 #include "sai_meta.h"
 #include "sai_extra.h"
 #include "saiserialize.h"
+#include "saislaballocator.h"
+#include "sairoutetrie.h"
+#include "saiworkerpool.h"
 
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <arpa/inet.h>
 
 #include <iostream>
 #include <vector>
@@ -13,8 +17,23 @@
 #include <memory>
 #include <map>
 #include <iterator>
+#include <algorithm>
+#include <exception>
+#include <functional>
 
 // TODO move to metadata utils
+bool is_ipv4_mask_valid(
+        _In_ sai_ip4_t mask)
+{
+    uint32_t host = ntohl(mask);
+
+    // contiguous mask complemented is 2^n-1
+
+    uint32_t inverted = ~host;
+
+    return (inverted & (inverted + 1)) == 0;
+}
+
 bool is_ipv6_mask_valid(
         _In_ const uint8_t* mask)
 {
@@ -67,10 +86,49 @@ std::vector<const sai_attr_metadata_t*> get_attributes_metadata(
     return attrs;
 }
 
+/**
+ * @brief Checks whether attribute value of given type points to allocated
+ * memory (list), which must be deep copied and freed.
+ */
+static bool meta_is_allocated_value_type(
+        _In_ sai_attr_value_type_t type)
+{
+    SWSS_LOG_ENTER();
+
+    switch (type)
+    {
+        case SAI_ATTR_VALUE_TYPE_OBJECT_LIST:
+        case SAI_ATTR_VALUE_TYPE_UINT8_LIST:
+        case SAI_ATTR_VALUE_TYPE_INT8_LIST:
+        case SAI_ATTR_VALUE_TYPE_UINT16_LIST:
+        case SAI_ATTR_VALUE_TYPE_INT16_LIST:
+        case SAI_ATTR_VALUE_TYPE_UINT32_LIST:
+        case SAI_ATTR_VALUE_TYPE_INT32_LIST:
+        case SAI_ATTR_VALUE_TYPE_VLAN_LIST:
+        case SAI_ATTR_VALUE_TYPE_QOS_MAP_LIST:
+        case SAI_ATTR_VALUE_TYPE_TUNNEL_MAP_LIST:
+        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
+        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_UINT8_LIST:
+        case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
 class SaiAttrWrapper
 {
     public:
 
+        SaiAttrWrapper():
+            m_meta(NULL)
+        {
+            SWSS_LOG_ENTER();
+
+            memset(&m_attr, 0, sizeof(m_attr));
+        }
+
         SaiAttrWrapper(
                 _In_ const sai_attr_metadata_t* meta,
                 _In_ const sai_attribute_t& attr):
@@ -81,6 +139,15 @@ class SaiAttrWrapper
 
             m_attr.id = attr.id;
 
+            /*
+             * Scalar values are stored by value, no allocation is needed.
+             */
+
+            if (!meta_is_allocated_value_type(meta->attrvaluetype))
+            {
+                return;
+            }
+
             /*
              * We are making serialize and deserialize to get copy of
              * attribute, it may be a list so we need to allocate new memory.
@@ -95,16 +162,39 @@ class SaiAttrWrapper
             sai_deserialize_attr_value(s, *meta, m_attr, false);
         }
 
-        ~SaiAttrWrapper()
+        SaiAttrWrapper(
+                _Inout_ SaiAttrWrapper&& other):
+            m_meta(other.m_meta),
+            m_attr(other.m_attr)
         {
             SWSS_LOG_ENTER();
 
-            /*
-             * On destructor we need to call free to dealocate possible
-             * alocated list on constructor.
-             */
+            other.m_meta = NULL;
+        }
+
+        SaiAttrWrapper& operator=(
+                _Inout_ SaiAttrWrapper&& other)
+        {
+            SWSS_LOG_ENTER();
+
+            if (this != &other)
+            {
+                release();
+
+                m_meta = other.m_meta;
+                m_attr = other.m_attr;
+
+                other.m_meta = NULL;
+            }
+
+            return *this;
+        }
 
-            sai_deserialize_free_attribute_value(m_meta->attrvaluetype, m_attr);
+        ~SaiAttrWrapper()
+        {
+            SWSS_LOG_ENTER();
+
+            release();
         }
 
         const sai_attribute_t* getattr() const
@@ -117,10 +207,147 @@ class SaiAttrWrapper
         SaiAttrWrapper(const SaiAttrWrapper&);
         SaiAttrWrapper& operator=(const SaiAttrWrapper&);
 
+        void release()
+        {
+            SWSS_LOG_ENTER();
+
+            /*
+             * On destructor we need to call free to dealocate possible
+             * alocated list on constructor.
+             */
+
+            if (m_meta != NULL && meta_is_allocated_value_type(m_meta->attrvaluetype))
+            {
+                sai_deserialize_free_attribute_value(m_meta->attrvaluetype, m_attr);
+            }
+
+            m_meta = NULL;
+        }
+
         const sai_attr_metadata_t* m_meta;
         sai_attribute_t m_attr;
 };
 
+/**
+ * @def SAI_META_INLINE_ATTR_COUNT
+ *
+ * Number of attributes stored inline in object entry, most objects in large
+ * numbers (routes, neighbors, next hops) have only few attributes.
+ */
+#define SAI_META_INLINE_ATTR_COUNT 2
+
+/**
+ * @brief Attributes of single object in local database.
+ *
+ * First attributes are stored inline in object entry and rest in overflow
+ * vector, so small objects need no extra allocations. Number of attributes
+ * on object is small, so linear search is used.
+ */
+class SaiObjectAttrs
+{
+    public:
+
+        SaiObjectAttrs():
+            m_count(0)
+        {
+            SWSS_LOG_ENTER();
+
+            // empty
+        }
+
+        SaiObjectAttrs(
+                _Inout_ SaiObjectAttrs&& other) = default;
+
+    public:
+
+        const SaiAttrWrapper* get(
+                _In_ sai_attr_id_t id) const
+        {
+            SWSS_LOG_ENTER();
+
+            for (size_t idx = 0; idx < size(); ++idx)
+            {
+                const SaiAttrWrapper& wrapper = at(idx);
+
+                if (wrapper.getattr()->id == id)
+                {
+                    return &wrapper;
+                }
+            }
+
+            return NULL;
+        }
+
+        void set(
+                _In_ const sai_attr_metadata_t& md,
+                _In_ const sai_attribute_t& attr)
+        {
+            SWSS_LOG_ENTER();
+
+            SaiAttrWrapper wrapper(&md, attr);
+
+            for (size_t idx = 0; idx < size(); ++idx)
+            {
+                if (at(idx).getattr()->id == attr.id)
+                {
+                    at(idx) = std::move(wrapper);
+                    return;
+                }
+            }
+
+            if (m_count < SAI_META_INLINE_ATTR_COUNT)
+            {
+                m_inline[m_count++] = std::move(wrapper);
+                return;
+            }
+
+            m_overflow.push_back(std::move(wrapper));
+        }
+
+        size_t size() const
+        {
+            SWSS_LOG_ENTER();
+
+            return m_count + m_overflow.size();
+        }
+
+        const SaiAttrWrapper& at(
+                _In_ size_t idx) const
+        {
+            SWSS_LOG_ENTER();
+
+            return idx < SAI_META_INLINE_ATTR_COUNT ? m_inline[idx] : m_overflow[idx - SAI_META_INLINE_ATTR_COUNT];
+        }
+
+    private:
+
+        SaiObjectAttrs(const SaiObjectAttrs&);
+        SaiObjectAttrs& operator=(const SaiObjectAttrs&);
+
+        SaiAttrWrapper& at(
+                _In_ size_t idx)
+        {
+            SWSS_LOG_ENTER();
+
+            return idx < SAI_META_INLINE_ATTR_COUNT ? m_inline[idx] : m_overflow[idx - SAI_META_INLINE_ATTR_COUNT];
+        }
+
+        uint32_t m_count;
+
+        SaiAttrWrapper m_inline[SAI_META_INLINE_ATTR_COUNT];
+
+        std::vector<SaiAttrWrapper> m_overflow;
+};
+
+/*
+ * Entry footprint is attribute count (padded to attribute alignment), inline
+ * attributes and empty overflow vector, make sure nothing else was added.
+ */
+
+static_assert(sizeof(SaiObjectAttrs) <=
+        sizeof(uint64_t) + SAI_META_INLINE_ATTR_COUNT * sizeof(SaiAttrWrapper) + sizeof(std::vector<SaiAttrWrapper>),
+        "unexpected size of SaiObjectAttrs");
+
 std::string get_attr_info(const sai_attr_metadata_t& md)
 {
     /*
@@ -144,8 +371,192 @@ std::string get_attr_info(const sai_attr_metadata_t& md)
  */
 
 static std::unordered_map<sai_object_id_t,int32_t> ObjectReferences;
-static std::unordered_map<std::string,std::string> AttributeKeys;
-std::unordered_map<std::string,std::unordered_map<sai_attr_id_t,std::shared_ptr<SaiAttrWrapper>>> ObjectAttrHash;
+static std::unordered_map<sai_object_meta_key_t,std::string,SaiObjectMetaKeyHash,SaiObjectMetaKeyEqual> AttributeKeys;
+static std::unordered_map<std::string,sai_object_meta_key_t> AttributeKeysIndex;
+
+/*
+ * Entries of object database are allocated from slab, since there may be
+ * millions of them (routes) and all have the same size.
+ */
+
+static std::unordered_map<
+    sai_object_meta_key_t,
+    SaiObjectAttrs,
+    SaiObjectMetaKeyHash,
+    SaiObjectMetaKeyEqual,
+    SaiSlabAllocator<std::pair<const sai_object_meta_key_t, SaiObjectAttrs>>> ObjectAttrHash;
+
+/*
+ * Route entries per virtual router, used for prefix queries. Tries are built
+ * on first query and only then maintained on route create and remove, so
+ * route programming doesn't pay for them when nobody queries. Tries point to
+ * route entries in ObjectAttrHash keys, so trie is updated while hash entry
+ * exists and hash is changed only when trie update succeeded.
+ */
+
+static std::unordered_map<sai_object_id_t, SaiRouteTrie> RouteTries;
+
+static bool RouteTriesBuilt = false;
+
+// META KEY HASH FUNCTIONS
+
+static inline void meta_key_hash_combine(
+        _Inout_ size_t& seed,
+        _In_ uint64_t value)
+{
+    SWSS_LOG_ENTER();
+
+    seed ^= std::hash<uint64_t>()(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+static inline void meta_key_hash_ip_address(
+        _Inout_ size_t& seed,
+        _In_ sai_ip_addr_family_t family,
+        _In_ const sai_ip_addr_t& addr)
+{
+    SWSS_LOG_ENTER();
+
+    meta_key_hash_combine(seed, family);
+
+    if (family == SAI_IP_ADDR_FAMILY_IPV4)
+    {
+        meta_key_hash_combine(seed, addr.ip4);
+        return;
+    }
+
+    uint64_t parts[2];
+
+    memcpy(parts, addr.ip6, sizeof(parts));
+
+    meta_key_hash_combine(seed, parts[0]);
+    meta_key_hash_combine(seed, parts[1]);
+}
+
+static inline bool meta_key_ip_address_equal(
+        _In_ sai_ip_addr_family_t family,
+        _In_ const sai_ip_addr_t& a,
+        _In_ const sai_ip_addr_t& b)
+{
+    SWSS_LOG_ENTER();
+
+    if (family == SAI_IP_ADDR_FAMILY_IPV4)
+    {
+        return a.ip4 == b.ip4;
+    }
+
+    return memcmp(a.ip6, b.ip6, sizeof(a.ip6)) == 0;
+}
+
+size_t SaiObjectMetaKeyHash::operator()(
+        _In_ const sai_object_meta_key_t& meta_key) const
+{
+    SWSS_LOG_ENTER();
+
+    size_t seed = 0;
+
+    meta_key_hash_combine(seed, meta_key.objecttype);
+
+    switch (meta_key.objecttype)
+    {
+        case SAI_OBJECT_TYPE_FDB_ENTRY:
+            {
+                const sai_fdb_entry_t& fe = meta_key.objectkey.key.fdb_entry;
+
+                uint64_t mac = 0;
+
+                memcpy(&mac, fe.mac_address, sizeof(sai_mac_t));
+
+                meta_key_hash_combine(seed, fe.switch_id);
+                meta_key_hash_combine(seed, mac);
+                meta_key_hash_combine(seed, fe.vlan_id);
+                meta_key_hash_combine(seed, fe.bridge_type);
+                meta_key_hash_combine(seed, fe.bridge_id);
+            }
+            break;
+
+        case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+            {
+                const sai_neighbor_entry_t& ne = meta_key.objectkey.key.neighbor_entry;
+
+                meta_key_hash_combine(seed, ne.switch_id);
+                meta_key_hash_combine(seed, ne.rif_id);
+                meta_key_hash_ip_address(seed, ne.ip_address.addr_family, ne.ip_address.addr);
+            }
+            break;
+
+        case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+            {
+                const sai_route_entry_t& re = meta_key.objectkey.key.route_entry;
+
+                meta_key_hash_combine(seed, re.switch_id);
+                meta_key_hash_combine(seed, re.vr_id);
+                meta_key_hash_ip_address(seed, re.destination.addr_family, re.destination.addr);
+                meta_key_hash_ip_address(seed, re.destination.addr_family, re.destination.mask);
+            }
+            break;
+
+        default:
+
+            meta_key_hash_combine(seed, meta_key.objectkey.key.object_id);
+            break;
+    }
+
+    return seed;
+}
+
+bool SaiObjectMetaKeyEqual::operator()(
+        _In_ const sai_object_meta_key_t& a,
+        _In_ const sai_object_meta_key_t& b) const
+{
+    SWSS_LOG_ENTER();
+
+    if (a.objecttype != b.objecttype)
+    {
+        return false;
+    }
+
+    switch (a.objecttype)
+    {
+        case SAI_OBJECT_TYPE_FDB_ENTRY:
+            {
+                const sai_fdb_entry_t& fa = a.objectkey.key.fdb_entry;
+                const sai_fdb_entry_t& fb = b.objectkey.key.fdb_entry;
+
+                return fa.switch_id == fb.switch_id &&
+                    memcmp(fa.mac_address, fb.mac_address, sizeof(sai_mac_t)) == 0 &&
+                    fa.vlan_id == fb.vlan_id &&
+                    fa.bridge_type == fb.bridge_type &&
+                    fa.bridge_id == fb.bridge_id;
+            }
+
+        case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+            {
+                const sai_neighbor_entry_t& na = a.objectkey.key.neighbor_entry;
+                const sai_neighbor_entry_t& nb = b.objectkey.key.neighbor_entry;
+
+                return na.switch_id == nb.switch_id &&
+                    na.rif_id == nb.rif_id &&
+                    na.ip_address.addr_family == nb.ip_address.addr_family &&
+                    meta_key_ip_address_equal(na.ip_address.addr_family, na.ip_address.addr, nb.ip_address.addr);
+            }
+
+        case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+            {
+                const sai_route_entry_t& ra = a.objectkey.key.route_entry;
+                const sai_route_entry_t& rb = b.objectkey.key.route_entry;
+
+                return ra.switch_id == rb.switch_id &&
+                    ra.vr_id == rb.vr_id &&
+                    ra.destination.addr_family == rb.destination.addr_family &&
+                    meta_key_ip_address_equal(ra.destination.addr_family, ra.destination.addr, rb.destination.addr) &&
+                    meta_key_ip_address_equal(ra.destination.addr_family, ra.destination.mask, rb.destination.mask);
+            }
+
+        default:
+
+            return a.objectkey.key.object_id == b.objectkey.key.object_id;
+    }
+}
 
 // GENERIC REFERENCE FUNCTIONS
 
@@ -288,26 +699,12 @@ void object_reference_remove(
     ObjectReferences.erase(oid);
 }
 
-bool object_exists(
-        _In_ const std::string& key)
-{
-    SWSS_LOG_ENTER();
-
-    bool exists = ObjectAttrHash.find(key) != ObjectAttrHash.end();
-
-    SWSS_LOG_DEBUG("%s %s", key.c_str(), exists ? "exists" : "missing");
-
-    return exists;
-}
-
 bool object_exists(
         _In_ const sai_object_meta_key_t& meta_key)
 {
     SWSS_LOG_ENTER();
 
-    std::string key = sai_serialize_object_meta_key(meta_key);
-
-    return object_exists(key);
+    return ObjectAttrHash.find(meta_key) != ObjectAttrHash.end();
 }
 
 sai_status_t meta_init_db()
@@ -319,8 +716,17 @@ sai_status_t meta_init_db()
      */
 
     ObjectReferences.clear();
+    RouteTries.clear();
+    RouteTriesBuilt = false;
     ObjectAttrHash.clear();
     AttributeKeys.clear();
+    AttributeKeysIndex.clear();
+
+    SWSS_LOG_INFO("object entry footprint: %zu bytes key, %zu bytes attributes (%d inline, %zu bytes each)",
+            sizeof(sai_object_meta_key_t),
+            sizeof(SaiObjectAttrs),
+            SAI_META_INLINE_ATTR_COUNT,
+            sizeof(SaiAttrWrapper));
 
     return SAI_STATUS_SUCCESS;
 }
@@ -331,20 +737,18 @@ const sai_attribute_t* get_object_previous_attr(
 {
     SWSS_LOG_ENTER();
 
-    std::string key = sai_serialize_object_meta_key(meta_key);
-
-    auto it = ObjectAttrHash.find(key);
+    auto it = ObjectAttrHash.find(meta_key);
 
     if (it == ObjectAttrHash.end())
     {
-        SWSS_LOG_ERROR("object key %s not found", key.c_str());
+        SWSS_LOG_ERROR("object key %s not found", sai_serialize_object_meta_key(meta_key).c_str());
 
         return NULL;
     }
 
-    auto ita = it->second.find(md.attrid);
+    const SaiAttrWrapper* wrapper = it->second.get(md.attrid);
 
-    if (ita == it->second.end())
+    if (wrapper == NULL)
     {
         /*
          * Attribute id not found.
@@ -358,7 +762,7 @@ const sai_attribute_t* get_object_previous_attr(
      * attribute list that could be already freed.
      */
 
-    return ita->second->getattr();
+    return wrapper->getattr();
 }
 
 void set_object(
@@ -368,35 +772,39 @@ void set_object(
 {
     SWSS_LOG_ENTER();
 
-    std::string key = sai_serialize_object_meta_key(meta_key);
+    auto it = ObjectAttrHash.find(meta_key);
 
-    if (!object_exists(key))
+    if (it == ObjectAttrHash.end())
     {
-        SWSS_LOG_THROW("FATAL: object %s don't exists", key.c_str());
+        SWSS_LOG_THROW("FATAL: object %s don't exists", sai_serialize_object_meta_key(meta_key).c_str());
     }
 
-    META_LOG_DEBUG(md, "set attribute %d on %s", attr->id, key.c_str());
+    META_LOG_DEBUG(md, "set attribute %d", attr->id);
 
-    ObjectAttrHash[key][attr->id] = std::make_shared<SaiAttrWrapper>(&md, *attr);
+    it->second.set(md, *attr);
 }
 
-const std::vector<std::shared_ptr<SaiAttrWrapper>> get_object_attributes(
+const std::vector<const SaiAttrWrapper*> get_object_attributes(
         _In_ const sai_object_meta_key_t& meta_key)
 {
-    std::string key = sai_serialize_object_meta_key(meta_key);
+    SWSS_LOG_ENTER();
+
+    auto it = ObjectAttrHash.find(meta_key);
 
-    if (!object_exists(key))
+    if (it == ObjectAttrHash.end())
     {
-        SWSS_LOG_THROW("FATAL: object %s don't exists", key.c_str());
+        SWSS_LOG_THROW("FATAL: object %s don't exists", sai_serialize_object_meta_key(meta_key).c_str());
     }
 
-    std::vector<std::shared_ptr<SaiAttrWrapper>> attrs;
+    std::vector<const SaiAttrWrapper*> attrs;
+
+    const auto& objattrs = it->second;
 
-    const auto& hash = ObjectAttrHash[key];
+    attrs.reserve(objattrs.size());
 
-    for (auto it = hash.begin(); it != hash.end(); ++it)
+    for (size_t idx = 0; idx < objattrs.size(); ++idx)
     {
-        attrs.push_back(it->second);
+        attrs.push_back(&objattrs.at(idx));
     }
 
     return attrs;
@@ -407,16 +815,31 @@ void remove_object(
 {
     SWSS_LOG_ENTER();
 
-    std::string key = sai_serialize_object_meta_key(meta_key);
+    auto it = ObjectAttrHash.find(meta_key);
 
-    if (!object_exists(key))
+    if (it == ObjectAttrHash.end())
     {
-        SWSS_LOG_THROW("FATAL: object %s don't exists", key.c_str());
+        SWSS_LOG_THROW("FATAL: object %s don't exists", sai_serialize_object_meta_key(meta_key).c_str());
     }
 
-    SWSS_LOG_DEBUG("removing object %s", key.c_str());
+    if (RouteTriesBuilt && meta_key.objecttype == SAI_OBJECT_TYPE_ROUTE_ENTRY)
+    {
+        const sai_route_entry_t& route_entry = meta_key.objectkey.key.route_entry;
+
+        auto trie = RouteTries.find(route_entry.vr_id);
+
+        if (trie == RouteTries.end() || !trie->second.remove(route_entry))
+        {
+            SWSS_LOG_THROW("FATAL: route %s not in route trie", sai_serialize_object_meta_key(meta_key).c_str());
+        }
+
+        if (trie->second.size() == 0)
+        {
+            RouteTries.erase(trie);
+        }
+    }
 
-    ObjectAttrHash.erase(key);
+    ObjectAttrHash.erase(it);
 }
 
 void create_object(
@@ -424,17 +847,37 @@ void create_object(
 {
     SWSS_LOG_ENTER();
 
-    std::string key = sai_serialize_object_meta_key(meta_key);
+    auto it = ObjectAttrHash.emplace(meta_key, SaiObjectAttrs());
 
-    if (object_exists(key))
+    if (!it.second)
     {
-        SWSS_LOG_THROW("FATAL: object %s already exists", key.c_str());
+        SWSS_LOG_THROW("FATAL: object %s already exists", sai_serialize_object_meta_key(meta_key).c_str());
     }
 
-    SWSS_LOG_DEBUG("creating object %s", key.c_str());
+    if (RouteTriesBuilt && meta_key.objecttype == SAI_OBJECT_TYPE_ROUTE_ENTRY)
+    {
+        /*
+         * Trie keeps pointer to route entry in hash key, which is stable
+         * until hash entry is erased.
+         */
 
-    ObjectAttrHash[key] = {};
-}
+        const sai_route_entry_t& route_entry = it.first->first.objectkey.key.route_entry;
+
+        auto& trie = RouteTries[route_entry.vr_id];
+
+        if (!trie.insert(route_entry))
+        {
+            if (trie.size() == 0)
+            {
+                RouteTries.erase(meta_key.objectkey.key.route_entry.vr_id);
+            }
+
+            ObjectAttrHash.erase(it.first);
+
+            SWSS_LOG_THROW("FATAL: route %s can't be inserted to route trie", sai_serialize_object_meta_key(meta_key).c_str());
+        }
+    }
+}
 
 sai_status_t meta_generic_validation_objlist(
         _In_ const sai_attr_metadata_t& md,
@@ -607,25 +1050,36 @@ std::string construct_key(
     SWSS_LOG_ENTER();
 
     /*
-     * Use map to make sure that keys will be always sorded by id.
+     * Key attributes are visited in object type metadata order, so key is
+     * canonical regardless of order of attributes passed by user. Attribute
+     * names contain object type, so keys of different object types will not
+     * collide in one index.
      */
 
-    std::map<int32_t, std::string> keys;
+    const sai_object_type_info_t* info = sai_metadata_get_object_type_info(meta_key.objecttype);
 
-    for (uint32_t idx = 0; idx < attr_count; ++idx)
+    std::string key;
+
+    for (size_t idx = 0; info->attrmetadata[idx] != NULL; ++idx)
     {
-        const sai_attribute_t* attr = &attr_list[idx];
+        const auto& md = *info->attrmetadata[idx];
 
-        const auto& md = *sai_metadata_get_attr_metadata(meta_key.objecttype, attr->id);
+        if (!HAS_FLAG_KEY(md.flags))
+        {
+            continue;
+        }
 
-        const sai_attribute_value_t& value = attr->value;
+        const sai_attribute_t* attr = sai_metadata_get_attr_by_id(md.attrid, attr_count, attr_list);
 
-        if (!HAS_FLAG_KEY(md.flags))
+        if (attr == NULL)
         {
             continue;
         }
 
-        std::string name = md.attridname + std::string(":");
+        const sai_attribute_value_t& value = attr->value;
+
+        key += md.attridname;
+        key += ":";
 
         switch (md.attrvaluetype)
         {
@@ -635,48 +1089,41 @@ std::string construct_key(
 
                 for (uint32_t i = 0; i < value.u32list.count; ++i)
                 {
-                    name += std::to_string(value.u32list.list[i]);
+                    key += std::to_string(value.u32list.list[i]);
 
                     if (i != value.u32list.count - 1)
                     {
-                        name += ",";
+                        key += ",";
                     }
                 }
 
                 break;
 
             case SAI_ATTR_VALUE_TYPE_INT32:
-                name += std::to_string(value.s32); // if enum then get enum name?
+                key += std::to_string(value.s32); // if enum then get enum name?
                 break;
 
             case SAI_ATTR_VALUE_TYPE_UINT32:
-                name += std::to_string(value.u32);
+                key += std::to_string(value.u32);
                 break;
 
             case SAI_ATTR_VALUE_TYPE_UINT8:
-                name += std::to_string(value.u8);
+                key += std::to_string(value.u8);
                 break;
 
             case SAI_ATTR_VALUE_TYPE_UINT16:
-                name += std::to_string(value.u16);
+                key += std::to_string(value.u16);
                 break;
 
             case SAI_ATTR_VALUE_TYPE_OBJECT_ID:
-                name += sai_serialize_object_id(value.oid);
+                key += sai_serialize_object_id(value.oid);
                 break;
 
             default:
                 META_LOG_THROW(md, "FATAL: marked as key, but have invalid serialization type");
         }
 
-        keys[md.attrid] = name;
-    }
-
-    std::string key;
-
-    for (auto& k: keys)
-    {
-        key += k.second + ";";
+        key += ";";
     }
 
     SWSS_LOG_DEBUG("constructed key: %s", key.c_str());
@@ -812,43 +1259,374 @@ sai_status_t meta_generic_validate_non_object_on_create(
          * NULL in allowed objects list.
          */
 
-        bool allowed = false;
+        bool allowed = false;
+
+        for (size_t k = 0 ; k < m->allowedobjecttypeslength; k++)
+        {
+            if (ot == m->allowedobjecttypes[k])
+            {
+                allowed = true;
+                break;
+            }
+        }
+
+        if (!allowed)
+        {
+            SWSS_LOG_ERROR("object id 0x%lx is %s, but it's not allowed on member %s",
+                    oid, sai_serialize_object_type(ot).c_str(), m->membername);
+
+            return SAI_STATUS_INVALID_PARAMETER;
+        }
+
+        sai_object_id_t oid_switch_id = sai_switch_id_query(oid);
+
+        if (!object_reference_exists(oid_switch_id))
+        {
+            SWSS_LOG_ERROR("switch id 0x%lx don't exists", oid_switch_id);
+
+            return SAI_STATUS_INVALID_PARAMETER;
+        }
+
+        if (switch_id != oid_switch_id)
+        {
+            SWSS_LOG_ERROR("oid 0x%lx is on switch 0x%lx but required switch is 0x%lx", oid, oid_switch_id, switch_id);
+
+            return SAI_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+// VALIDATION LEVEL
+
+typedef struct _meta_validation_level_entry_t
+{
+    sai_meta_validation_level_t level;
+
+    uint32_t sample_rate;
+
+    uint64_t calls;
+
+} meta_validation_level_entry_t;
+
+/*
+ * Zero initialized, so all object types are fully validated by default.
+ */
+
+static meta_validation_level_entry_t ValidationLevels[SAI_OBJECT_TYPE_MAX];
+
+sai_status_t meta_set_validation_level(
+        _In_ sai_object_type_t object_type,
+        _In_ sai_meta_validation_level_t level,
+        _In_ uint32_t sample_rate)
+{
+    SWSS_LOG_ENTER();
+
+    if (object_type >= SAI_OBJECT_TYPE_MAX)
+    {
+        SWSS_LOG_ERROR("invalid object type: %d", object_type);
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    switch (level)
+    {
+        case SAI_META_VALIDATION_LEVEL_FULL:
+        case SAI_META_VALIDATION_LEVEL_BOOKKEEPING:
+            break;
+
+        case SAI_META_VALIDATION_LEVEL_SAMPLING:
+
+            if (sample_rate == 0)
+            {
+                SWSS_LOG_ERROR("sample rate must be non zero for sampling validation level");
+
+                return SAI_STATUS_INVALID_PARAMETER;
+            }
+
+            break;
+
+        default:
+
+            SWSS_LOG_ERROR("invalid validation level: %d", level);
+
+            return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    for (int ot = SAI_OBJECT_TYPE_NULL; ot < (int)SAI_OBJECT_TYPE_MAX; ++ot)
+    {
+        if (object_type != SAI_OBJECT_TYPE_NULL && (int)object_type != ot)
+        {
+            continue;
+        }
+
+        ValidationLevels[ot].level = level;
+        ValidationLevels[ot].sample_rate = sample_rate;
+        ValidationLevels[ot].calls = 0;
+    }
+
+    SWSS_LOG_NOTICE("validation level on %s set to %d, sample rate %u",
+            object_type == SAI_OBJECT_TYPE_NULL ? "all object types" : sai_serialize_object_type(object_type).c_str(),
+            level,
+            sample_rate);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Checks whether current call on object type should be fully validated.
+ */
+static bool meta_full_validation(
+        _In_ sai_object_type_t object_type)
+{
+    SWSS_LOG_ENTER();
+
+    meta_validation_level_entry_t& entry = ValidationLevels[object_type];
+
+    switch (entry.level)
+    {
+        case SAI_META_VALIDATION_LEVEL_BOOKKEEPING:
+            return false;
+
+        case SAI_META_VALIDATION_LEVEL_SAMPLING:
+            return (entry.calls++ % entry.sample_rate) == 0;
+
+        default:
+            return true;
+    }
+}
+
+/**
+ * @brief Checks whether validation decision on object type depends on
+ * number of previous calls, in that case calls must be validated in order.
+ */
+static bool meta_validation_sampled(
+        _In_ sai_object_type_t object_type)
+{
+    SWSS_LOG_ENTER();
+
+    return ValidationLevels[object_type].level == SAI_META_VALIDATION_LEVEL_SAMPLING;
+}
+
+static bool meta_bookkeeping_oid_exists(
+        _In_ sai_object_id_t oid)
+{
+    SWSS_LOG_ENTER();
+
+    return oid == SAI_NULL_OBJECT_ID || object_reference_exists(oid);
+}
+
+/**
+ * @brief Checks list which post operations will deep copy.
+ */
+static bool meta_bookkeeping_list_valid(
+        _In_ uint32_t count,
+        _In_ const void* list)
+{
+    SWSS_LOG_ENTER();
+
+    return count <= MAX_LIST_COUNT && (count == 0 || list != NULL);
+}
+
+static bool meta_bookkeeping_objlist_exists(
+        _In_ const sai_object_list_t& list)
+{
+    SWSS_LOG_ENTER();
+
+    if (!meta_bookkeeping_list_valid(list.count, list.list))
+    {
+        return false;
+    }
+
+    for (uint32_t idx = 0; idx < list.count; ++idx)
+    {
+        if (!meta_bookkeeping_oid_exists(list.list[idx]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Checks done when full validation is skipped.
+ *
+ * Only checks required by post operations to keep local database consistent
+ * are performed: object existence, attribute ids having metadata and flags
+ * allowing operation, lists being valid so they can be copied, object ids in
+ * attribute values being known, so references can be increased, and key
+ * attributes being unique and not changed by set, so key index stays
+ * consistent.
+ *
+ * @param create True for create, object must not exist.
+ * @param values True if attribute values are input (create, set).
+ */
+static bool meta_generic_validation_bookkeeping(
+        _In_ const sai_object_meta_key_t& meta_key,
+        _In_ bool create,
+        _In_ bool values,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+{
+    SWSS_LOG_ENTER();
+
+    auto info = sai_metadata_get_object_type_info(meta_key.objecttype);
+
+    if (create)
+    {
+        if (info->isnonobjectid && object_exists(meta_key))
+        {
+            return false;
+        }
+    }
+    else if (!object_exists(meta_key))
+    {
+        return false;
+    }
+
+    if (attr_list == NULL)
+    {
+        return attr_count == 0 && create;
+    }
+
+    if (!create && attr_count < 1)
+    {
+        return false;
+    }
+
+    bool haskeys = false;
+
+    for (uint32_t idx = 0; idx < attr_count; ++idx)
+    {
+        const sai_attribute_t* attr = &attr_list[idx];
+
+        auto mdp = sai_metadata_get_attr_metadata(meta_key.objecttype, attr->id);
+
+        if (mdp == NULL)
+        {
+            return false;
+        }
+
+        if (HAS_FLAG_KEY(mdp->flags))
+        {
+            haskeys = true;
+        }
+
+        if (!values)
+        {
+            continue;
+        }
+
+        if (HAS_FLAG_READ_ONLY(mdp->flags))
+        {
+            return false;
+        }
+
+        if (!create && (HAS_FLAG_CREATE_ONLY(mdp->flags) || HAS_FLAG_KEY(mdp->flags)))
+        {
+            return false;
+        }
+
+        const sai_attribute_value_t& value = attr->value;
+
+        bool known = true;
+
+        switch (mdp->attrvaluetype)
+        {
+            case SAI_ATTR_VALUE_TYPE_OBJECT_ID:
+                known = meta_bookkeeping_oid_exists(value.oid);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_OBJECT_LIST:
+                known = meta_bookkeeping_objlist_exists(value.objlist);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_ID:
+                known = !value.aclfield.enable || meta_bookkeeping_oid_exists(value.aclfield.data.oid);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
+                known = !value.aclfield.enable || meta_bookkeeping_objlist_exists(value.aclfield.data.objlist);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_ID:
+                known = !value.aclaction.enable || meta_bookkeeping_oid_exists(value.aclaction.parameter.oid);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
+                known = !value.aclaction.enable || meta_bookkeeping_objlist_exists(value.aclaction.parameter.objlist);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_UINT8_LIST:
+                known = !value.aclfield.enable ||
+                    (meta_bookkeeping_list_valid(value.aclfield.data.u8list.count, value.aclfield.data.u8list.list) &&
+                     meta_bookkeeping_list_valid(value.aclfield.mask.u8list.count, value.aclfield.mask.u8list.list));
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_UINT8_LIST:
+                known = meta_bookkeeping_list_valid(value.u8list.count, value.u8list.list);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_INT8_LIST:
+                known = meta_bookkeeping_list_valid(value.s8list.count, value.s8list.list);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_UINT16_LIST:
+                known = meta_bookkeeping_list_valid(value.u16list.count, value.u16list.list);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_INT16_LIST:
+                known = meta_bookkeeping_list_valid(value.s16list.count, value.s16list.list);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_UINT32_LIST:
+                known = meta_bookkeeping_list_valid(value.u32list.count, value.u32list.list);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_INT32_LIST:
+                known = meta_bookkeeping_list_valid(value.s32list.count, value.s32list.list);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_VLAN_LIST:
+                known = meta_bookkeeping_list_valid(value.vlanlist.count, value.vlanlist.list);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_QOS_MAP_LIST:
+                known = meta_bookkeeping_list_valid(value.qosmap.count, value.qosmap.list);
+                break;
 
-        for (size_t k = 0 ; k < m->allowedobjecttypeslength; k++)
-        {
-            if (ot == m->allowedobjecttypes[k])
-            {
-                allowed = true;
+            case SAI_ATTR_VALUE_TYPE_TUNNEL_MAP_LIST:
+                known = meta_bookkeeping_list_valid(value.tunnelmap.count, value.tunnelmap.list);
+                break;
+
+            default:
                 break;
-            }
         }
 
-        if (!allowed)
+        if (!known)
         {
-            SWSS_LOG_ERROR("object id 0x%lx is %s, but it's not allowed on member %s",
-                    oid, sai_serialize_object_type(ot).c_str(), m->membername);
-
-            return SAI_STATUS_INVALID_PARAMETER;
+            return false;
         }
+    }
 
-        sai_object_id_t oid_switch_id = sai_switch_id_query(oid);
-
-        if (!object_reference_exists(oid_switch_id))
-        {
-            SWSS_LOG_ERROR("switch id 0x%lx don't exists", oid_switch_id);
+    /*
+     * Key index is updated in post create, so duplicate key would silently
+     * overwrite other object entry.
+     */
 
-            return SAI_STATUS_INVALID_PARAMETER;
-        }
+    if (create && haskeys)
+    {
+        std::string key = construct_key(meta_key, attr_count, attr_list);
 
-        if (switch_id != oid_switch_id)
+        if (AttributeKeysIndex.find(key) != AttributeKeysIndex.end())
         {
-            SWSS_LOG_ERROR("oid 0x%lx is on switch 0x%lx but required switch is 0x%lx", oid, oid_switch_id, switch_id);
-
-            return SAI_STATUS_INVALID_PARAMETER;
+            return false;
         }
     }
 
-    return SAI_STATUS_SUCCESS;
+    return true;
 }
 
 sai_status_t meta_generic_validation_create(
@@ -859,6 +1637,12 @@ sai_status_t meta_generic_validation_create(
 {
     SWSS_LOG_ENTER();
 
+    if (!meta_full_validation(meta_key.objecttype) &&
+            meta_generic_validation_bookkeeping(meta_key, true, true, attr_count, attr_list))
+    {
+        return SAI_STATUS_SUCCESS;
+    }
+
     if (attr_count > MAX_LIST_COUNT)
     {
         SWSS_LOG_ERROR("create attribute count is too large %u > then max list count %u", attr_count, MAX_LIST_COUNT);
@@ -1304,11 +2088,9 @@ sai_status_t meta_generic_validation_create(
     if (info->isnonobjectid)
     {
         // just sanity check if object already exists
-        std::string key = sai_serialize_object_meta_key(meta_key);
-
-        if (object_exists(key))
+        if (object_exists(meta_key))
         {
-            SWSS_LOG_ERROR("object key %s already exists", key.c_str());
+            SWSS_LOG_ERROR("object key %s already exists", sai_serialize_object_meta_key(meta_key).c_str());
 
             return SAI_STATUS_ITEM_ALREADY_EXISTS;
         }
@@ -1531,16 +2313,17 @@ sai_status_t meta_generic_validation_create(
     {
         std::string key = construct_key(meta_key, attr_count, attr_list);
 
-        for (auto& it: AttributeKeys)
-        {
-            // since we didn't created oid yet, we don't know if attribute key exists, check all
+        // since we didn't created oid yet, we can only check if key is used by other object
 
-            if (it.second == key)
-            {
-                SWSS_LOG_ERROR("attribute key %s already exists, can't create", key.c_str());
+        auto it = AttributeKeysIndex.find(key);
 
-                return SAI_STATUS_INVALID_PARAMETER;
-            }
+        if (it != AttributeKeysIndex.end())
+        {
+            SWSS_LOG_ERROR("attribute key %s already exists on %s, can't create",
+                    key.c_str(),
+                    sai_serialize_object_meta_key(it->second).c_str());
+
+            return SAI_STATUS_INVALID_PARAMETER;
         }
     }
 
@@ -1552,11 +2335,9 @@ sai_status_t meta_generic_validation_remove(
 {
     SWSS_LOG_ENTER();
 
-    std::string key = sai_serialize_object_meta_key(meta_key);
-
-    if (!object_exists(key))
+    if (!object_exists(meta_key))
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", sai_serialize_object_meta_key(meta_key).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -1623,6 +2404,12 @@ sai_status_t meta_generic_validation_set(
 {
     SWSS_LOG_ENTER();
 
+    if (!meta_full_validation(meta_key.objecttype) &&
+            meta_generic_validation_bookkeeping(meta_key, false, true, attr ? 1 : 0, attr))
+    {
+        return SAI_STATUS_SUCCESS;
+    }
+
     if (attr == NULL)
     {
         SWSS_LOG_ERROR("attribute pointer is NULL");
@@ -1986,11 +2773,9 @@ sai_status_t meta_generic_validation_set(
 
     // check if object on which we perform operation exists
 
-    std::string key = sai_serialize_object_meta_key(meta_key);
-
-    if (!object_exists(key))
+    if (!object_exists(meta_key))
     {
-        META_LOG_ERROR(md, "object key %s doesn't exist", key.c_str());
+        META_LOG_ERROR(md, "object key %s doesn't exist", sai_serialize_object_meta_key(meta_key).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -1999,7 +2784,7 @@ sai_status_t meta_generic_validation_set(
 
     if (info->isnonobjectid)
     {
-        SWSS_LOG_DEBUG("object key exists: %s", key.c_str());
+        SWSS_LOG_DEBUG("object key exists: %s", sai_serialize_object_meta_key(meta_key).c_str());
     }
     else
     {
@@ -2037,6 +2822,12 @@ sai_status_t meta_generic_validation_get(
 {
     SWSS_LOG_ENTER();
 
+    if (!meta_full_validation(meta_key.objecttype) &&
+            meta_generic_validation_bookkeeping(meta_key, false, false, attr_count, attr_list))
+    {
+        return SAI_STATUS_SUCCESS;
+    }
+
     if (attr_count < 1)
     {
         SWSS_LOG_ERROR("expected at least 1 attribute when calling get, zero given");
@@ -2103,10 +2894,8 @@ sai_status_t meta_generic_validation_get(
             // (this will not respect create_only with default)
             if (get_object_previous_attr(meta_key, md) == NULL)
             {
-                std::string key = sai_serialize_object_meta_key(meta_key);
-
                 // XXX produces too much noise
-                // META_LOG_WARN(md, "get for conditional, but not found in local db, object %s created on switch ?", key.c_str());
+                // META_LOG_WARN(md, "get for conditional, but not found in local db, object %s created on switch ?", sai_serialize_object_meta_key(meta_key).c_str());
             }
             else
             {
@@ -2253,11 +3042,9 @@ sai_status_t meta_generic_validation_get(
         }
     }
 
-    std::string key = sai_serialize_object_meta_key(meta_key);
-
-    if (!object_exists(key))
+    if (!object_exists(meta_key))
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", sai_serialize_object_meta_key(meta_key).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -2266,7 +3053,7 @@ sai_status_t meta_generic_validation_get(
 
     if (info->isnonobjectid)
     {
-        SWSS_LOG_DEBUG("object key exists: %s", key.c_str());
+        SWSS_LOG_DEBUG("object key exists: %s", sai_serialize_object_meta_key(meta_key).c_str());
     }
     else
     {
@@ -2307,11 +3094,9 @@ void meta_generic_validation_post_create(
 {
     SWSS_LOG_ENTER();
 
-    std::string key = sai_serialize_object_meta_key(meta_key);
-
-    if (object_exists(key))
+    if (object_exists(meta_key))
     {
-        SWSS_LOG_ERROR("object key %s already exists (vendor bug?)", key.c_str());
+        SWSS_LOG_ERROR("object key %s already exists (vendor bug?)", sai_serialize_object_meta_key(meta_key).c_str());
 
         // this may produce inconsistency
     }
@@ -2400,7 +3185,7 @@ void meta_generic_validation_post_create(
         } while (false);
     }
 
-    bool haskeys;
+    bool haskeys = false;
 
     for (uint32_t idx = 0; idx < attr_count; ++idx)
     {
@@ -2535,9 +3320,11 @@ void meta_generic_validation_post_create(
 
     if (haskeys)
     {
-        std::string ok = sai_serialize_object_meta_key(meta_key);
+        std::string key = construct_key(meta_key, attr_count, attr_list);
 
-        AttributeKeys[ok] = construct_key(meta_key, attr_count, attr_list);
+        AttributeKeysIndex[key] = meta_key;
+
+        AttributeKeys[meta_key] = key;
     }
 }
 
@@ -2696,13 +3483,15 @@ void meta_generic_validation_post_remove(
 
     remove_object(meta_key);
 
-    std::string ok = sai_serialize_object_meta_key(meta_key);
+    auto it = AttributeKeys.find(meta_key);
 
-    if (AttributeKeys.find(ok) != AttributeKeys.end())
+    if (it != AttributeKeys.end())
     {
-        SWSS_LOG_DEBUG("erasing attributes key %s", AttributeKeys[ok].c_str());
+        SWSS_LOG_DEBUG("erasing attributes key %s", it->second.c_str());
+
+        AttributeKeysIndex.erase(it->second);
 
-        AttributeKeys.erase(ok);
+        AttributeKeys.erase(it);
     }
 }
 
@@ -2733,10 +3522,8 @@ void meta_generic_validation_post_set(
              * If default value type will be internal then we should warn.
              */
 
-            std::string key = sai_serialize_object_meta_key(meta_key);
-
             // XXX produces too much noise
-            // META_LOG_WARN(md, "post set, not in local db, FIX snoop!: %s", key.c_str());
+            // META_LOG_WARN(md, "post set, not in local db, FIX snoop!: %s", sai_serialize_object_meta_key(meta_key).c_str());
         }
     }
 
@@ -2948,10 +3735,8 @@ void meta_generic_validation_post_get_objlist(
     {
         if (get_object_previous_attr(meta_key, md) == NULL)
         {
-            std::string key = sai_serialize_object_meta_key(meta_key);
-
             // XXX produces too much noise
-            // META_LOG_WARN(md, "post get, not in local db, FIX snoop!: %s", key.c_str());
+            // META_LOG_WARN(md, "post get, not in local db, FIX snoop!: %s", sai_serialize_object_meta_key(meta_key).c_str());
         }
     }
 
@@ -3303,13 +4088,11 @@ sai_status_t meta_sai_validate_fdb_entry(
 
     sai_object_meta_key_t meta_key_fdb = { .objecttype = SAI_OBJECT_TYPE_FDB_ENTRY, .objectkey = { .key = { .fdb_entry = *fdb_entry } } };
 
-    std::string key_fdb = sai_serialize_object_meta_key(meta_key_fdb);
-
     if (create)
     {
-        if (object_exists(key_fdb))
+        if (object_exists(meta_key_fdb))
         {
-            SWSS_LOG_ERROR("object key %s already exists", key_fdb.c_str());
+            SWSS_LOG_ERROR("object key %s already exists", sai_serialize_object_meta_key(meta_key_fdb).c_str());
 
             return SAI_STATUS_ITEM_ALREADY_EXISTS;
         }
@@ -3319,9 +4102,9 @@ sai_status_t meta_sai_validate_fdb_entry(
 
     // set, get, remove
 
-    if (!object_exists(key_fdb) && !get)
+    if (!object_exists(meta_key_fdb) && !get)
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key_fdb.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", sai_serialize_object_meta_key(meta_key_fdb).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -3589,24 +4372,20 @@ sai_status_t meta_sai_validate_neighbor_entry(
 
     sai_object_meta_key_t meta_key_rif = { .objecttype = expected, .objectkey = { .key = { .object_id = rif } } };
 
-    std::string key_rif = sai_serialize_object_meta_key(meta_key_rif);
-
-    if (!object_exists(key_rif))
+    if (!object_exists(meta_key_rif))
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key_rif.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", sai_serialize_object_meta_key(meta_key_rif).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
     sai_object_meta_key_t meta_key_neighbor = { .objecttype = SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, .objectkey = { .key = { .neighbor_entry = *neighbor_entry } } };
 
-    std::string key_neighbor = sai_serialize_object_meta_key(meta_key_neighbor);
-
     if (create)
     {
-        if (object_exists(key_neighbor))
+        if (object_exists(meta_key_neighbor))
         {
-            SWSS_LOG_ERROR("object key %s already exists", key_neighbor.c_str());
+            SWSS_LOG_ERROR("object key %s already exists", sai_serialize_object_meta_key(meta_key_neighbor).c_str());
 
             return SAI_STATUS_ITEM_ALREADY_EXISTS;
         }
@@ -3616,9 +4395,9 @@ sai_status_t meta_sai_validate_neighbor_entry(
 
     // set, get, remove
 
-    if (!object_exists(key_neighbor))
+    if (!object_exists(meta_key_neighbor))
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key_neighbor.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", sai_serialize_object_meta_key(meta_key_neighbor).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -3845,6 +4624,14 @@ sai_status_t meta_sai_validate_route_entry(
     switch (family)
     {
         case SAI_IP_ADDR_FAMILY_IPV4:
+
+            if (!is_ipv4_mask_valid(route_entry->destination.mask.ip4))
+            {
+                SWSS_LOG_ERROR("invalid ipv4 mask: 0x%x", ntohl(route_entry->destination.mask.ip4));
+
+                return SAI_STATUS_INVALID_PARAMETER;
+            }
+
             break;
 
         case SAI_IP_ADDR_FAMILY_IPV6:
@@ -3896,11 +4683,9 @@ sai_status_t meta_sai_validate_route_entry(
 
     sai_object_meta_key_t meta_key_vr = { .objecttype = expected, .objectkey = { .key = { .object_id = vr } } };
 
-    std::string key_vr = sai_serialize_object_meta_key(meta_key_vr);
-
-    if (!object_exists(key_vr))
+    if (!object_exists(meta_key_vr))
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key_vr.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", sai_serialize_object_meta_key(meta_key_vr).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -3909,13 +4694,11 @@ sai_status_t meta_sai_validate_route_entry(
 
     sai_object_meta_key_t meta_key_route = { .objecttype = SAI_OBJECT_TYPE_ROUTE_ENTRY, .objectkey = { .key = { .route_entry = *route_entry } } };
 
-    std::string key_route = sai_serialize_object_meta_key(meta_key_route);
-
     if (create)
     {
-        if (object_exists(key_route))
+        if (object_exists(meta_key_route))
         {
-            SWSS_LOG_ERROR("object key %s already exists", key_route.c_str());
+            SWSS_LOG_ERROR("object key %s already exists", sai_serialize_object_meta_key(meta_key_route).c_str());
 
             return SAI_STATUS_ITEM_ALREADY_EXISTS;
         }
@@ -3925,9 +4708,9 @@ sai_status_t meta_sai_validate_route_entry(
 
     // set, get, remove
 
-    if (!object_exists(key_route))
+    if (!object_exists(meta_key_route))
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key_route.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", sai_serialize_object_meta_key(meta_key_route).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -4132,6 +4915,299 @@ sai_status_t meta_sai_get_route_entry(
     return status;
 }
 
+/**
+ * @def META_BULK_PARALLEL_ENTRIES
+ *
+ * Minimum number of entries validated by single thread in bulk operations,
+ * smaller batches are validated in caller thread.
+ */
+#define META_BULK_PARALLEL_ENTRIES 512
+
+/**
+ * @brief Pool validating bulk entries, set by meta user, so threads are
+ * created only by processes which want parallel validation.
+ */
+static std::shared_ptr<WorkerPool> BulkValidationPool;
+
+void meta_set_worker_pool(
+        _In_ std::shared_ptr<WorkerPool> pool)
+{
+    SWSS_LOG_ENTER();
+
+    BulkValidationPool = pool;
+}
+
+/**
+ * @brief Executes job for each index in parallel on contiguous ranges.
+ *
+ * Job must not throw.
+ */
+static void meta_parallel_for(
+        _In_ size_t count,
+        _In_ const std::function<void(size_t)>& job)
+{
+    SWSS_LOG_ENTER();
+
+    if (count < 2 * META_BULK_PARALLEL_ENTRIES ||
+            BulkValidationPool == nullptr ||
+            BulkValidationPool->getConcurrency() <= 1)
+    {
+        for (size_t idx = 0; idx < count; ++idx)
+        {
+            job(idx);
+        }
+
+        return;
+    }
+
+    size_t rangesCount = std::min(BulkValidationPool->getConcurrency(), count / META_BULK_PARALLEL_ENTRIES);
+
+    size_t range = (count + rangesCount - 1) / rangesCount;
+
+    BulkValidationPool->run(rangesCount, [&](size_t rangeIdx) {
+        for (size_t idx = rangeIdx * range; idx < std::min(count, (rangeIdx + 1) * range); ++idx)
+        {
+            job(idx);
+        }
+    });
+}
+
+void meta_sai_bulk_create_route_entry(
+        _In_ uint32_t object_count,
+        _In_ const sai_route_entry_t *route_entry,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t *const *attr_list,
+        _In_ sai_bulk_op_type_t type,
+        _Inout_ sai_status_t *object_statuses,
+        _In_ sai_create_route_entry_fn create)
+{
+    SWSS_LOG_ENTER();
+
+    if (meta_validation_sampled(SAI_OBJECT_TYPE_ROUTE_ENTRY))
+    {
+        /*
+         * Sampling decision depends on order of calls, so validate serially.
+         */
+
+        for (uint32_t idx = 0; idx < object_count; ++idx)
+        {
+            object_statuses[idx] = meta_sai_create_route_entry(&route_entry[idx], attr_count[idx], attr_list[idx], create);
+
+            if (object_statuses[idx] != SAI_STATUS_SUCCESS && type == SAI_BULK_OP_TYPE_STOP_ON_ERROR)
+            {
+                break;
+            }
+        }
+
+        return;
+    }
+
+    /*
+     * First phase is read only validation of each entry against current
+     * local database, which can be done in parallel. Only dependency between
+     * route entries in batch is the same route present multiple times, which
+     * is checked in second phase.
+     */
+
+    std::vector<sai_status_t> entryValidation(object_count);
+
+    std::vector<sai_status_t> attrValidation(object_count);
+
+    std::vector<std::exception_ptr> exceptions(object_count);
+
+    meta_parallel_for(object_count, [&](size_t idx) {
+        try
+        {
+            entryValidation[idx] = meta_sai_validate_route_entry(&route_entry[idx], true);
+
+            if (entryValidation[idx] == SAI_STATUS_SUCCESS)
+            {
+                sai_object_meta_key_t meta_key = { .objecttype = SAI_OBJECT_TYPE_ROUTE_ENTRY, .objectkey = { .key = { .route_entry = route_entry[idx] } } };
+
+                attrValidation[idx] = meta_generic_validation_create(meta_key, route_entry[idx].switch_id, attr_count[idx], attr_list[idx]);
+            }
+        }
+        catch (...)
+        {
+            exceptions[idx] = std::current_exception();
+        }
+    });
+
+    /*
+     * Second phase creates objects and updates references in order, same as
+     * serial path would.
+     */
+
+    for (uint32_t idx = 0; idx < object_count; ++idx)
+    {
+        if (exceptions[idx])
+        {
+            std::rethrow_exception(exceptions[idx]);
+        }
+
+        sai_object_meta_key_t meta_key = { .objecttype = SAI_OBJECT_TYPE_ROUTE_ENTRY, .objectkey = { .key = { .route_entry = route_entry[idx] } } };
+
+        sai_status_t status = entryValidation[idx];
+
+        if (status == SAI_STATUS_SUCCESS && object_exists(meta_key))
+        {
+            /*
+             * Route was created by previous entry in this batch.
+             */
+
+            SWSS_LOG_ERROR("object key %s already exists", sai_serialize_object_meta_key(meta_key).c_str());
+
+            status = SAI_STATUS_ITEM_ALREADY_EXISTS;
+        }
+
+        if (status == SAI_STATUS_SUCCESS)
+        {
+            status = attrValidation[idx];
+        }
+
+        if (status == SAI_STATUS_SUCCESS)
+        {
+            if (create == NULL)
+            {
+                SWSS_LOG_ERROR("create function pointer is NULL");
+
+                status = SAI_STATUS_FAILURE;
+            }
+            else
+            {
+                status = create(&route_entry[idx], attr_count[idx], attr_list[idx]);
+
+                if (status == SAI_STATUS_SUCCESS)
+                {
+                    meta_generic_validation_post_create(meta_key, route_entry[idx].switch_id, attr_count[idx], attr_list[idx]);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("create status: %s", sai_serialize_status(status).c_str());
+                }
+            }
+        }
+
+        object_statuses[idx] = status;
+
+        if (status != SAI_STATUS_SUCCESS && type == SAI_BULK_OP_TYPE_STOP_ON_ERROR)
+        {
+            break;
+        }
+    }
+}
+
+void meta_build_route_tries()
+{
+    SWSS_LOG_ENTER();
+
+    if (RouteTriesBuilt)
+    {
+        return;
+    }
+
+    for (const auto& kvp: ObjectAttrHash)
+    {
+        if (kvp.first.objecttype != SAI_OBJECT_TYPE_ROUTE_ENTRY)
+        {
+            continue;
+        }
+
+        const sai_route_entry_t& route_entry = kvp.first.objectkey.key.route_entry;
+
+        if (!RouteTries[route_entry.vr_id].insert(route_entry))
+        {
+            RouteTries.clear();
+
+            SWSS_LOG_THROW("FATAL: route %s can't be inserted to route trie", sai_serialize_object_meta_key(kvp.first).c_str());
+        }
+    }
+
+    SWSS_LOG_INFO("built route tries for %zu virtual routers", RouteTries.size());
+
+    RouteTriesBuilt = true;
+}
+
+sai_status_t meta_get_route_entries(
+        _In_ sai_object_id_t vr_id,
+        _In_ const sai_ip_prefix_t *prefix,
+        _Inout_ uint32_t *count,
+        _Out_ sai_route_entry_t *list)
+{
+    SWSS_LOG_ENTER();
+
+    if (count == NULL)
+    {
+        SWSS_LOG_ERROR("count pointer is NULL");
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (*count && list == NULL)
+    {
+        SWSS_LOG_ERROR("list pointer is NULL, but count is %u", *count);
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    meta_build_route_tries();
+
+    std::vector<sai_route_entry_t> routes;
+
+    auto it = RouteTries.find(vr_id);
+
+    if (it != RouteTries.end())
+    {
+        if (prefix == NULL)
+        {
+            it->second.getRoutes(routes);
+        }
+        else
+        {
+            it->second.getRoutes(*prefix, routes);
+        }
+    }
+
+    if (routes.size() > *count)
+    {
+        *count = (uint32_t)routes.size();
+
+        return SAI_STATUS_BUFFER_OVERFLOW;
+    }
+
+    *count = (uint32_t)routes.size();
+
+    std::copy(routes.begin(), routes.end(), list);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t meta_lookup_route_entry(
+        _In_ sai_object_id_t vr_id,
+        _In_ const sai_ip_address_t *address,
+        _Out_ sai_route_entry_t *route_entry)
+{
+    SWSS_LOG_ENTER();
+
+    if (address == NULL || route_entry == NULL)
+    {
+        SWSS_LOG_ERROR("address or route_entry pointer is NULL");
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    meta_build_route_tries();
+
+    auto it = RouteTries.find(vr_id);
+
+    if (it == RouteTries.end() || !it->second.lookup(*address, *route_entry))
+    {
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
 // GENERIC
 
 sai_status_t meta_sai_validate_oid(
@@ -4203,11 +5279,9 @@ sai_status_t meta_sai_validate_oid(
 
     sai_object_meta_key_t meta_key_oid = { .objecttype = expected, .objectkey = { .key = { .object_id = oid } } };
 
-    std::string key_oid = sai_serialize_object_meta_key(meta_key_oid);
-
-    if (!object_exists(key_oid))
+    if (!object_exists(meta_key_oid))
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key_oid.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", sai_serialize_object_meta_key(meta_key_oid).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -4446,15 +5520,13 @@ void meta_sai_on_fdb_event_single(
 
     const sai_object_meta_key_t meta_key_fdb = { .objecttype = SAI_OBJECT_TYPE_FDB_ENTRY, .objectkey = { .key = { .fdb_entry = data.fdb_entry } } };
 
-    std::string key_fdb = sai_serialize_object_meta_key(meta_key_fdb);
-
     switch (data.event_type)
     {
         case SAI_FDB_EVENT_LEARNED:
 
-            if (object_exists(key_fdb))
+            if (object_exists(meta_key_fdb))
             {
-                SWSS_LOG_WARN("object key %s alearedy exists, but received LEARNED event", key_fdb.c_str());
+                SWSS_LOG_WARN("object key %s alearedy exists, but received LEARNED event", sai_serialize_object_meta_key(meta_key_fdb).c_str());
                 break;
             }
 
@@ -4484,7 +5556,7 @@ void meta_sai_on_fdb_event_single(
                 }
                 else
                 {
-                    SWSS_LOG_ERROR("failed to insert %s received in notification: %s", key_fdb.c_str(), sai_serialize_status(status).c_str());
+                    SWSS_LOG_ERROR("failed to insert %s received in notification: %s", sai_serialize_object_meta_key(meta_key_fdb).c_str(), sai_serialize_status(status).c_str());
                 }
             }
 
@@ -4493,9 +5565,9 @@ void meta_sai_on_fdb_event_single(
         case SAI_FDB_EVENT_AGED:
         case SAI_FDB_EVENT_FLUSHED:
 
-            if (!object_exists(key_fdb))
+            if (!object_exists(meta_key_fdb))
             {
-                SWSS_LOG_WARN("object key %s doesn't exist but received AGED/FLUSHED event", key_fdb.c_str());
+                SWSS_LOG_WARN("object key %s doesn't exist but received AGED/FLUSHED event", sai_serialize_object_meta_key(meta_key_fdb).c_str());
                 break;
             }
 
@@ -6,6 +6,34 @@ extern "C" {
 #include "saimetadata.h"
 }
 
+#include <cstddef>
+#include <memory>
+
+class WorkerPool;
+
+/**
+ * @brief Hash of object meta key.
+ *
+ * Local meta database is keyed by binary meta key, so serialization to string
+ * is not needed on every lookup. Only fields relevant for given object type
+ * are hashed, for IP addresses only bytes of address family in use.
+ */
+struct SaiObjectMetaKeyHash
+{
+    size_t operator()(
+            _In_ const sai_object_meta_key_t& meta_key) const;
+};
+
+/**
+ * @brief Equality of object meta keys, consistent with SaiObjectMetaKeyHash.
+ */
+struct SaiObjectMetaKeyEqual
+{
+    bool operator()(
+            _In_ const sai_object_meta_key_t& a,
+            _In_ const sai_object_meta_key_t& b) const;
+};
+
 #define MAX_LIST_COUNT 0x1000
 
 #define DEFAULT_VLAN_NUMBER 1
@@ -14,6 +42,58 @@ extern "C" {
 
 extern sai_status_t meta_init_db();
 
+/**
+ * @brief Level of validation performed on API calls for object type.
+ */
+typedef enum _sai_meta_validation_level_t
+{
+    /**
+     * @brief All attributes and conditions are validated.
+     */
+    SAI_META_VALIDATION_LEVEL_FULL,
+
+    /**
+     * @brief Every Nth call is fully validated, other calls only keep
+     * bookkeeping.
+     */
+    SAI_META_VALIDATION_LEVEL_SAMPLING,
+
+    /**
+     * @brief Only object existence and references are checked, this keeps
+     * local database consistent (reference counts, previous values).
+     *
+     * If bookkeeping check fails, full validation is performed to report
+     * actual reason.
+     */
+    SAI_META_VALIDATION_LEVEL_BOOKKEEPING,
+
+} sai_meta_validation_level_t;
+
+/**
+ * @brief Sets validation level.
+ *
+ * @param object_type Object type, SAI_OBJECT_TYPE_NULL sets level on all
+ * object types.
+ * @param level Validation level.
+ * @param sample_rate For sampling level, every sample_rate call is fully
+ * validated.
+ */
+extern sai_status_t meta_set_validation_level(
+        _In_ sai_object_type_t object_type,
+        _In_ sai_meta_validation_level_t level,
+        _In_ uint32_t sample_rate);
+
+/**
+ * @brief Sets worker pool validating large bulk operations in parallel.
+ *
+ * Without pool (default) bulk operations are validated in caller thread.
+ * Setting NULL releases previously set pool.
+ *
+ * @param pool Worker pool, or NULL.
+ */
+extern void meta_set_worker_pool(
+        _In_ std::shared_ptr<WorkerPool> pool);
+
 // GENERIC FUNCTION POINTERS
 
 typedef sai_status_t (*sai_create_generic_fn)(
@@ -120,6 +200,25 @@ extern sai_status_t meta_sai_create_route_entry(
         _In_ const sai_attribute_t *attr_list,
         _In_ sai_create_route_entry_fn create);
 
+/**
+ * @brief Validates and creates route entries in bulk.
+ *
+ * Statuses are the same as if meta_sai_create_route_entry would be called
+ * for each entry in order. Statuses of entries not executed because of
+ * SAI_BULK_OP_TYPE_STOP_ON_ERROR are not modified.
+ *
+ * Large batches are validated in parallel, only creation and reference
+ * updates are done serially.
+ */
+extern void meta_sai_bulk_create_route_entry(
+        _In_ uint32_t object_count,
+        _In_ const sai_route_entry_t *route_entry,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t *const *attr_list,
+        _In_ sai_bulk_op_type_t type,
+        _Inout_ sai_status_t *object_statuses,
+        _In_ sai_create_route_entry_fn create);
+
 extern sai_status_t meta_sai_remove_route_entry(
         _In_ const sai_route_entry_t* route_entry,
         _In_ sai_remove_route_entry_fn remove);
@@ -135,6 +234,34 @@ extern sai_status_t meta_sai_get_route_entry(
         _Inout_ sai_attribute_t *attr_list,
         _In_ sai_get_route_entry_attribute_fn get);
 
+/**
+ * @brief Gets route entries of virtual router from local database.
+ *
+ * @param vr_id Virtual router.
+ * @param prefix Only routes covered by this prefix (including prefix itself)
+ * are returned, if NULL all routes of virtual router are returned.
+ * @param count On input size of list, on output number of routes.
+ * @param list Route entries.
+ *
+ * @return SAI_STATUS_BUFFER_OVERFLOW if list is too small, count is set to
+ * required size.
+ */
+extern sai_status_t meta_get_route_entries(
+        _In_ sai_object_id_t vr_id,
+        _In_ const sai_ip_prefix_t *prefix,
+        _Inout_ uint32_t *count,
+        _Out_ sai_route_entry_t *list);
+
+/**
+ * @brief Finds longest prefix match route entry for address in virtual router.
+ *
+ * @return SAI_STATUS_ITEM_NOT_FOUND if no route matches.
+ */
+extern sai_status_t meta_lookup_route_entry(
+        _In_ sai_object_id_t vr_id,
+        _In_ const sai_ip_address_t *address,
+        _Out_ sai_route_entry_t *route_entry);
+
 // NOTIFICATIONS
 
 extern void meta_sai_on_fdb_event(
@@ -61,6 +61,8 @@ std::vector<swss::FieldValueTuple> SaiAttributeList::serialize_attr_list(
 {
     std::vector<swss::FieldValueTuple> entry;
 
+    entry.reserve(attr_count);
+
     for (uint32_t index = 0; index < attr_count; ++index)
     {
         const sai_attribute_t *attr = &attr_list[index];
@@ -73,13 +75,9 @@ std::vector<swss::FieldValueTuple> SaiAttributeList::serialize_attr_list(
             throw std::runtime_error("failed to get metadata");
         }
 
-        std::string str_attr_id = sai_serialize_attr_id(*meta);
-
-        std::string str_attr_value = sai_serialize_attr_value(*meta, *attr, countOnly);
-
-        swss::FieldValueTuple fvt(str_attr_id, str_attr_value);
+        entry.emplace_back(sai_serialize_attr_id(*meta), std::string());
 
-        entry.push_back(fvt);
+        sai_serialize_append_attr_value(fvValue(entry.back()), *meta, *attr, countOnly);
     }
 
     return std::move(entry);
@@ -0,0 +1,546 @@
+#include "sairoutetrie.h"
+
+#include "swss/logger.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+static inline uint8_t trie_get_bit(
+        _In_ const uint8_t* bits,
+        _In_ uint8_t index)
+{
+    SWSS_LOG_ENTER();
+
+    return (uint8_t)((bits[index / 8] >> (7 - index % 8)) & 1);
+}
+
+/**
+ * @brief Gets length of common prefix of two bit strings, up to length.
+ */
+static uint8_t trie_common_length(
+        _In_ const uint8_t* a,
+        _In_ const uint8_t* b,
+        _In_ uint8_t length)
+{
+    SWSS_LOG_ENTER();
+
+    uint8_t index = 0;
+
+    // compare whole bytes first
+
+    while (index + 8 <= length && a[index / 8] == b[index / 8])
+    {
+        index = (uint8_t)(index + 8);
+    }
+
+    while (index < length && trie_get_bit(a, index) == trie_get_bit(b, index))
+    {
+        index++;
+    }
+
+    return index;
+}
+
+static bool trie_route_equal(
+        _In_ const sai_route_entry_t& a,
+        _In_ const sai_route_entry_t& b)
+{
+    SWSS_LOG_ENTER();
+
+    if (a.switch_id != b.switch_id || a.vr_id != b.vr_id)
+    {
+        return false;
+    }
+
+    if (a.destination.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+    {
+        return a.destination.addr.ip4 == b.destination.addr.ip4;
+    }
+
+    return memcmp(a.destination.addr.ip6, b.destination.addr.ip6, sizeof(sai_ip6_t)) == 0;
+}
+
+bool SaiRouteTrie::getKey(
+        _In_ const sai_ip_prefix_t& prefix,
+        _Out_ Key& key)
+{
+    SWSS_LOG_ENTER();
+
+    memset(&key, 0, sizeof(key));
+
+    const uint8_t* addr;
+    const uint8_t* mask;
+    uint8_t bytes;
+
+    switch (prefix.addr_family)
+    {
+        case SAI_IP_ADDR_FAMILY_IPV4:
+            addr = (const uint8_t*)&prefix.addr.ip4;
+            mask = (const uint8_t*)&prefix.mask.ip4;
+            bytes = 4;
+            break;
+
+        case SAI_IP_ADDR_FAMILY_IPV6:
+            addr = prefix.addr.ip6;
+            mask = prefix.mask.ip6;
+            bytes = 16;
+            break;
+
+        default:
+            SWSS_LOG_ERROR("invalid prefix family: %d", prefix.addr_family);
+            return false;
+    }
+
+    bool zeros = false;
+
+    for (uint8_t idx = 0; idx < bytes; idx++)
+    {
+        key.bits[idx] = addr[idx] & mask[idx];
+
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            bool one = (mask[idx] >> (7 - bit)) & 1;
+
+            if (zeros && one)
+            {
+                SWSS_LOG_ERROR("mask is not contiguous");
+                return false;
+            }
+
+            zeros |= !one;
+
+            if (one)
+            {
+                key.length++;
+            }
+        }
+    }
+
+    return true;
+}
+
+SaiRouteTrie::SlabPtr<SaiRouteTrie::Node> SaiRouteTrie::createNode(
+        _In_ const Key& key,
+        _In_ uint8_t length)
+{
+    SWSS_LOG_ENTER();
+
+    SlabPtr<Node> node = slabNew<Node>();
+
+    // keep only first length bits
+
+    for (uint8_t idx = 0; idx < sizeof(key.bits); idx++)
+    {
+        int bits = length - idx * 8;
+
+        if (bits >= 8)
+        {
+            node->key.bits[idx] = key.bits[idx];
+        }
+        else if (bits > 0)
+        {
+            node->key.bits[idx] = (uint8_t)(key.bits[idx] & (0xff << (8 - bits)));
+        }
+        else
+        {
+            node->key.bits[idx] = 0;
+        }
+    }
+
+    node->key.length = length;
+
+    return node;
+}
+
+SaiRouteTrie::SlabPtr<SaiRouteTrie::Node>& SaiRouteTrie::getRoot(
+        _In_ sai_ip_addr_family_t family)
+{
+    SWSS_LOG_ENTER();
+
+    return (family == SAI_IP_ADDR_FAMILY_IPV4) ? m_ipv4 : m_ipv6;
+}
+
+const SaiRouteTrie::Node* SaiRouteTrie::getRoot(
+        _In_ sai_ip_addr_family_t family) const
+{
+    SWSS_LOG_ENTER();
+
+    return (family == SAI_IP_ADDR_FAMILY_IPV4) ? m_ipv4.get() : m_ipv6.get();
+}
+
+bool SaiRouteTrie::insert(
+        _In_ const sai_route_entry_t& route_entry)
+{
+    SWSS_LOG_ENTER();
+
+    Key key;
+
+    if (!getKey(route_entry.destination, key))
+    {
+        return false;
+    }
+
+    SlabPtr<Node>* slot = &getRoot(route_entry.destination.addr_family);
+
+    while (true)
+    {
+        if (!*slot)
+        {
+            *slot = createNode(key, key.length);
+            break;
+        }
+
+        Node* node = slot->get();
+
+        uint8_t common = trie_common_length(node->key.bits, key.bits, std::min(node->key.length, key.length));
+
+        if (common == node->key.length)
+        {
+            if (common == key.length)
+            {
+                break;
+            }
+
+            slot = &node->children[trie_get_bit(key.bits, common)];
+            continue;
+        }
+
+        /*
+         * Node prefix diverges from key, split it. New node is either route
+         * node itself (key is prefix of node) or branching node.
+         */
+
+        SlabPtr<Node> old = std::move(*slot);
+
+        *slot = createNode(key, common);
+
+        (*slot)->children[trie_get_bit(old->key.bits, common)] = std::move(old);
+
+        if (common != key.length)
+        {
+            slot = &(*slot)->children[trie_get_bit(key.bits, common)];
+
+            *slot = createNode(key, key.length);
+        }
+
+        break;
+    }
+
+    Entry* entry = &(*slot)->entry;
+
+    if (entry->route != NULL)
+    {
+        while (true)
+        {
+            if (trie_route_equal(*entry->route, route_entry))
+            {
+                return false;
+            }
+
+            if (!entry->next)
+            {
+                break;
+            }
+
+            entry = entry->next.get();
+        }
+
+        entry->next = slabNew<Entry>();
+
+        entry = entry->next.get();
+    }
+
+    entry->route = &route_entry;
+
+    m_size++;
+
+    return true;
+}
+
+bool SaiRouteTrie::removeEntry(
+        _Inout_ Entry& head,
+        _In_ const sai_route_entry_t& route_entry)
+{
+    SWSS_LOG_ENTER();
+
+    if (head.route == NULL)
+    {
+        return false;
+    }
+
+    if (trie_route_equal(*head.route, route_entry))
+    {
+        // move next entry inline to node
+
+        SlabPtr<Entry> next = std::move(head.next);
+
+        head.route = next ? next->route : NULL;
+        head.next = next ? std::move(next->next) : nullptr;
+
+        return true;
+    }
+
+    for (SlabPtr<Entry>* slot = &head.next; *slot; slot = &(*slot)->next)
+    {
+        if (trie_route_equal(*(*slot)->route, route_entry))
+        {
+            *slot = std::move((*slot)->next);
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool SaiRouteTrie::removeNode(
+        _Inout_ SlabPtr<Node>& slot,
+        _In_ const Key& key,
+        _In_ const sai_route_entry_t& route_entry)
+{
+    SWSS_LOG_ENTER();
+
+    Node* node = slot.get();
+
+    if (node == NULL ||
+            node->key.length > key.length ||
+            trie_common_length(node->key.bits, key.bits, node->key.length) != node->key.length)
+    {
+        return false;
+    }
+
+    bool removed = false;
+
+    if (node->key.length == key.length)
+    {
+        removed = removeEntry(node->entry, route_entry);
+    }
+    else
+    {
+        removed = removeNode(node->children[trie_get_bit(key.bits, node->key.length)], key, route_entry);
+    }
+
+    if (!removed || node->entry.route != NULL)
+    {
+        return removed;
+    }
+
+    // node without routes is only needed when it's branching
+
+    if (node->children[0] && node->children[1])
+    {
+        return true;
+    }
+
+    SlabPtr<Node> child = std::move(node->children[node->children[0] ? 0 : 1]);
+
+    slot = std::move(child);
+
+    return true;
+}
+
+bool SaiRouteTrie::remove(
+        _In_ const sai_route_entry_t& route_entry)
+{
+    SWSS_LOG_ENTER();
+
+    Key key;
+
+    if (!getKey(route_entry.destination, key))
+    {
+        return false;
+    }
+
+    if (!removeNode(getRoot(route_entry.destination.addr_family), key, route_entry))
+    {
+        return false;
+    }
+
+    m_size--;
+
+    return true;
+}
+
+const SaiRouteTrie::Node* SaiRouteTrie::findNode(
+        _In_ const sai_route_entry_t& route_entry) const
+{
+    SWSS_LOG_ENTER();
+
+    Key key;
+
+    if (!getKey(route_entry.destination, key))
+    {
+        return NULL;
+    }
+
+    const Node* node = getRoot(route_entry.destination.addr_family);
+
+    while (node &&
+            node->key.length <= key.length &&
+            trie_common_length(node->key.bits, key.bits, node->key.length) == node->key.length)
+    {
+        if (node->key.length == key.length)
+        {
+            return node;
+        }
+
+        node = node->children[trie_get_bit(key.bits, node->key.length)].get();
+    }
+
+    return NULL;
+}
+
+bool SaiRouteTrie::exists(
+        _In_ const sai_route_entry_t& route_entry) const
+{
+    SWSS_LOG_ENTER();
+
+    const Node* node = findNode(route_entry);
+
+    if (node == NULL || node->entry.route == NULL)
+    {
+        return false;
+    }
+
+    for (const Entry* entry = &node->entry; entry; entry = entry->next.get())
+    {
+        if (trie_route_equal(*entry->route, route_entry))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void SaiRouteTrie::collectRoutes(
+        _In_ const Node* node,
+        _Inout_ std::vector<sai_route_entry_t>& routes)
+{
+    SWSS_LOG_ENTER();
+
+    if (node == NULL)
+    {
+        return;
+    }
+
+    if (node->entry.route != NULL)
+    {
+        for (const Entry* entry = &node->entry; entry; entry = entry->next.get())
+        {
+            routes.push_back(*entry->route);
+        }
+    }
+
+    collectRoutes(node->children[0].get(), routes);
+    collectRoutes(node->children[1].get(), routes);
+}
+
+void SaiRouteTrie::getRoutes(
+        _In_ const sai_ip_prefix_t& prefix,
+        _Inout_ std::vector<sai_route_entry_t>& routes) const
+{
+    SWSS_LOG_ENTER();
+
+    Key key;
+
+    if (!getKey(prefix, key))
+    {
+        return;
+    }
+
+    const Node* node = getRoot(prefix.addr_family);
+
+    while (node)
+    {
+        if (node->key.length >= key.length)
+        {
+            if (trie_common_length(node->key.bits, key.bits, key.length) == key.length)
+            {
+                collectRoutes(node, routes);
+            }
+
+            return;
+        }
+
+        if (trie_common_length(node->key.bits, key.bits, node->key.length) != node->key.length)
+        {
+            return;
+        }
+
+        node = node->children[trie_get_bit(key.bits, node->key.length)].get();
+    }
+}
+
+void SaiRouteTrie::getRoutes(
+        _Inout_ std::vector<sai_route_entry_t>& routes) const
+{
+    SWSS_LOG_ENTER();
+
+    collectRoutes(m_ipv4.get(), routes);
+    collectRoutes(m_ipv6.get(), routes);
+}
+
+bool SaiRouteTrie::lookup(
+        _In_ const sai_ip_address_t& address,
+        _Out_ sai_route_entry_t& route_entry) const
+{
+    SWSS_LOG_ENTER();
+
+    Key key;
+
+    memset(&key, 0, sizeof(key));
+
+    switch (address.addr_family)
+    {
+        case SAI_IP_ADDR_FAMILY_IPV4:
+            memcpy(key.bits, &address.addr.ip4, sizeof(address.addr.ip4));
+            key.length = 32;
+            break;
+
+        case SAI_IP_ADDR_FAMILY_IPV6:
+            memcpy(key.bits, address.addr.ip6, sizeof(address.addr.ip6));
+            key.length = 128;
+            break;
+
+        default:
+            SWSS_LOG_ERROR("invalid address family: %d", address.addr_family);
+            return false;
+    }
+
+    const Node* best = NULL;
+
+    const Node* node = getRoot(address.addr_family);
+
+    while (node && trie_common_length(node->key.bits, key.bits, node->key.length) == node->key.length)
+    {
+        if (node->entry.route != NULL)
+        {
+            best = node;
+        }
+
+        if (node->key.length == key.length)
+        {
+            break;
+        }
+
+        node = node->children[trie_get_bit(key.bits, node->key.length)].get();
+    }
+
+    if (best == NULL)
+    {
+        return false;
+    }
+
+    route_entry = *best->entry.route;
+
+    return true;
+}
+
+size_t SaiRouteTrie::size() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_size;
+}
@@ -0,0 +1,196 @@
+#ifndef __SAI_ROUTE_TRIE__
+#define __SAI_ROUTE_TRIE__
+
+extern "C" {
+#include "sai.h"
+}
+
+#include "saislaballocator.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Route entries of single virtual router kept in path compressed
+ * binary trie, separate for IPv4 and IPv6.
+ *
+ * Trie answers structural questions which hash of route entries can't, like
+ * which routes are covered by prefix or what is longest prefix match for
+ * address. Mask of route must be contiguous.
+ *
+ * Routes which differ only in host bits (address bits not covered by mask)
+ * are distinct route entries in meta database, so they share trie node.
+ *
+ * Trie doesn't copy route entries, it keeps pointers to them. Meta database
+ * passes route entry from key of object hash, so route is stored only once.
+ *
+ * Nodes and linked entries are allocated from slab pools, like meta database
+ * entries, since trie of large route table has node per route.
+ *
+ * Trie is not thread safe, it's protected by same lock as meta database.
+ */
+class SaiRouteTrie
+{
+    public:
+
+        SaiRouteTrie() = default;
+
+        ~SaiRouteTrie() = default;
+
+    public:
+
+        /**
+         * @brief Inserts route entry.
+         *
+         * Route entry must stay valid until it's removed from trie.
+         *
+         * @return False if route entry already exists or prefix is invalid.
+         */
+        bool insert(
+                _In_ const sai_route_entry_t& route_entry);
+
+        /**
+         * @brief Removes route entry.
+         *
+         * @return False if route entry doesn't exist.
+         */
+        bool remove(
+                _In_ const sai_route_entry_t& route_entry);
+
+        bool exists(
+                _In_ const sai_route_entry_t& route_entry) const;
+
+        /**
+         * @brief Gets all route entries covered by prefix (including prefix
+         * itself), in trie order.
+         */
+        void getRoutes(
+                _In_ const sai_ip_prefix_t& prefix,
+                _Inout_ std::vector<sai_route_entry_t>& routes) const;
+
+        /**
+         * @brief Gets all route entries, IPv4 first.
+         */
+        void getRoutes(
+                _Inout_ std::vector<sai_route_entry_t>& routes) const;
+
+        /**
+         * @brief Finds longest prefix match route for address.
+         *
+         * @return True if matching route was found.
+         */
+        bool lookup(
+                _In_ const sai_ip_address_t& address,
+                _Out_ sai_route_entry_t& route_entry) const;
+
+        size_t size() const;
+
+    private:
+
+        SaiRouteTrie(const SaiRouteTrie&);
+        SaiRouteTrie& operator=(const SaiRouteTrie&);
+
+        /**
+         * @brief Deleter returning object to slab pool of its type.
+         */
+        template <typename T>
+        struct SlabDeleter
+        {
+            void operator()(
+                    _In_ T* ptr) const
+            {
+                SaiSlabAllocator<T> allocator;
+
+                allocator.destroy(ptr);
+                allocator.deallocate(ptr, 1);
+            }
+        };
+
+        template <typename T>
+        using SlabPtr = std::unique_ptr<T, SlabDeleter<T>>;
+
+        template <typename T>
+        static SlabPtr<T> slabNew()
+        {
+            SaiSlabAllocator<T> allocator;
+
+            T* ptr = allocator.allocate(1);
+
+            allocator.construct(ptr);
+
+            return SlabPtr<T>(ptr);
+        }
+
+        /**
+         * @brief Masked address in network byte order and prefix length.
+         */
+        struct Key
+        {
+            uint8_t bits[16];
+
+            uint8_t length;
+        };
+
+        /**
+         * @brief Route entries sharing trie node, first one is inline in node
+         * and others (differing only in host bits) are linked after it.
+         */
+        struct Entry
+        {
+            const sai_route_entry_t* route = NULL;
+
+            SlabPtr<Entry> next;
+        };
+
+        struct Node
+        {
+            Key key;
+
+            /*
+             * Route is NULL when node is only branching.
+             */
+
+            Entry entry;
+
+            SlabPtr<Node> children[2];
+        };
+
+        static bool getKey(
+                _In_ const sai_ip_prefix_t& prefix,
+                _Out_ Key& key);
+
+        static SlabPtr<Node> createNode(
+                _In_ const Key& key,
+                _In_ uint8_t length);
+
+        static bool removeEntry(
+                _Inout_ Entry& head,
+                _In_ const sai_route_entry_t& route_entry);
+
+        static bool removeNode(
+                _Inout_ SlabPtr<Node>& slot,
+                _In_ const Key& key,
+                _In_ const sai_route_entry_t& route_entry);
+
+        static void collectRoutes(
+                _In_ const Node* node,
+                _Inout_ std::vector<sai_route_entry_t>& routes);
+
+        SlabPtr<Node>& getRoot(
+                _In_ sai_ip_addr_family_t family);
+
+        const Node* getRoot(
+                _In_ sai_ip_addr_family_t family) const;
+
+        const Node* findNode(
+                _In_ const sai_route_entry_t& route_entry) const;
+
+        SlabPtr<Node> m_ipv4;
+
+        SlabPtr<Node> m_ipv6;
+
+        size_t m_size = 0;
+};
+
+#endif // __SAI_ROUTE_TRIE__
@@ -5,6 +5,8 @@
 
 #include <vector>
 #include <climits>
+#include <unordered_map>
+#include <type_traits>
 
 #include <arpa/inet.h>
 #include <errno.h>
@@ -494,25 +496,112 @@ void sai_populate_ip_mask(
 
 // new methods
 
-std::string sai_serialize_bool(
-        _In_ bool b)
+// SERIALIZE APPEND
+
+/*
+ * Append functions format directly into caller buffer, so serializing
+ * attribute doesn't create temporary string for every number, OID or list
+ * item. Functions returning string are thin wrappers over them.
+ */
+
+static const char sai_serialize_hex_digits[] = "0123456789abcdef";
+
+static const char sai_serialize_hex_digits_upper[] = "0123456789ABCDEF";
+
+static inline void sai_serialize_append_decimal(
+        _Inout_ std::string& buf,
+        _In_ uint64_t number)
 {
-    SWSS_LOG_ENTER();
+    char tmp[24];
+
+    char* end = tmp + sizeof(tmp);
+    char* p = end;
 
-    return b ? "true" : "false";
+    do
+    {
+        *--p = (char)('0' + number % 10);
+        number /= 10;
+    }
+    while (number);
+
+    buf.append(p, end);
 }
 
-#define CHAR_LEN 32
+static inline void sai_serialize_append_decimal(
+        _Inout_ std::string& buf,
+        _In_ int64_t number)
+{
+    if (number < 0)
+    {
+        buf += '-';
 
-std::string sai_serialize_chardata(
-        _In_ const char data[CHAR_LEN])
+        // negate in unsigned, so INT64_MIN is handled
+
+        sai_serialize_append_decimal(buf, (uint64_t)0 - (uint64_t)number);
+        return;
+    }
+
+    sai_serialize_append_decimal(buf, (uint64_t)number);
+}
+
+static inline void sai_serialize_append_hex(
+        _Inout_ std::string& buf,
+        _In_ uint64_t number)
 {
-    SWSS_LOG_ENTER();
+    char tmp[16];
 
-    std::string s;
+    char* end = tmp + sizeof(tmp);
+    char* p = end;
+
+    do
+    {
+        *--p = sai_serialize_hex_digits[number & 0xf];
+        number >>= 4;
+    }
+    while (number);
+
+    buf += "0x";
+    buf.append(p, end);
+}
+
+template <typename T>
+void sai_serialize_append_number(
+        _Inout_ std::string& buf,
+        _In_ const T number,
+        _In_ bool hex = false)
+{
+    if (hex)
+    {
+        sai_serialize_append_hex(buf, (uint64_t)number);
+        return;
+    }
+
+    typedef typename std::conditional<std::is_signed<T>::value, int64_t, uint64_t>::type decimal_t;
+
+    sai_serialize_append_decimal(buf, (decimal_t)number);
+}
 
-    char buf[8];
+void sai_serialize_append_number(
+        _Inout_ std::string& buf,
+        _In_ const uint32_t number,
+        _In_ bool hex)
+{
+    sai_serialize_append_number<uint32_t>(buf, number, hex);
+}
 
+static void sai_serialize_append_bool(
+        _Inout_ std::string& buf,
+        _In_ bool b)
+{
+    buf += b ? "true" : "false";
+}
+
+#define CHAR_LEN 32
+
+static void sai_serialize_append_chardata(
+        _Inout_ std::string& buf,
+        _In_ const char data[CHAR_LEN])
+{
     size_t len = strnlen(data, CHAR_LEN);
 
     for (size_t i = 0; i < len; ++i)
@@ -521,22 +610,40 @@ std::string sai_serialize_chardata(
 
         if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))
         {
-            s += c;
+            buf += (char)c;
             continue;
         }
 
         if (c == '\\')
         {
-            s += "\\\\";
+            buf += "\\\\";
             continue;
         }
 
-        snprintf(buf, sizeof(buf), "\\x%02X", (int)c);
+        buf += "\\x";
+        buf += sai_serialize_hex_digits_upper[c >> 4];
+        buf += sai_serialize_hex_digits_upper[c & 0xf];
+    }
+}
+
+void sai_serialize_append_mac(
+        _Inout_ std::string& buf,
+        _In_ const sai_mac_t mac)
+{
+    char tmp[17];
 
-        s += buf;
+    for (int i = 0; i < 6; ++i)
+    {
+        tmp[i * 3]     = sai_serialize_hex_digits_upper[mac[i] >> 4];
+        tmp[i * 3 + 1] = sai_serialize_hex_digits_upper[mac[i] & 0xf];
+
+        if (i != 5)
+        {
+            tmp[i * 3 + 2] = ':';
+        }
     }
 
-    return s;
+    buf.append(tmp, sizeof(tmp));
 }
 
 std::string sai_serialize_mac(
@@ -544,12 +651,11 @@ std::string sai_serialize_mac(
 {
     SWSS_LOG_ENTER();
 
-    char buf[32];
+    std::string s;
 
-    snprintf(buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X",
-            mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+    sai_serialize_append_mac(s, mac);
 
-    return buf;
+    return s;
 }
 
 template <typename T>
@@ -559,38 +665,188 @@ std::string sai_serialize_number(
 {
     SWSS_LOG_ENTER();
 
-    if (hex)
+    std::string s;
+
+    sai_serialize_append_number(s, number, hex);
+
+    return s;
+}
+
+// METADATA INDEX
+
+/*
+ * Names of attributes and enum values are resolved for every attribute of
+ * every message, so metadata is indexed in hash tables built once from SAI
+ * metadata instead of linear scans. Tables are read only after construction,
+ * so they can be used from any thread without locking.
+ */
+
+typedef struct _sai_enum_index_t
+{
+    std::unordered_map<std::string, int32_t> byName;
+
+    std::unordered_map<int32_t, const char*> byValue;
+
+} sai_enum_index_t;
+
+typedef struct _sai_metadata_index_t
+{
+    std::unordered_map<std::string, const sai_attr_metadata_t*> attrByIdName;
+
+    std::unordered_map<const sai_enum_metadata_t*, sai_enum_index_t> enums;
+
+} sai_metadata_index_t;
+
+static void sai_metadata_index_add_enum(
+        _Inout_ sai_metadata_index_t& index,
+        _In_ const sai_enum_metadata_t* meta)
+{
+    SWSS_LOG_ENTER();
+
+    if (meta == NULL || index.enums.find(meta) != index.enums.end())
+    {
+        return;
+    }
+
+    sai_enum_index_t& e = index.enums[meta];
+
+    e.byName.reserve(meta->valuescount);
+    e.byValue.reserve(meta->valuescount);
+
+    for (size_t i = 0; i < meta->valuescount; ++i)
     {
-        char buf[32];
+        e.byName.emplace(meta->valuesnames[i], meta->values[i]);
 
-        snprintf(buf, sizeof(buf), "0x%lx", (uint64_t)number);
+        // first name wins, same as linear scan
 
-        return buf;
+        e.byValue.emplace(meta->values[i], meta->valuesnames[i]);
     }
+}
 
-    return std::to_string(number);
+static sai_metadata_index_t sai_metadata_index_create()
+{
+    SWSS_LOG_ENTER();
+
+    sai_metadata_index_t index;
+
+    for (size_t ot = 0; ot < sai_metadata_attr_by_object_type_count; ++ot)
+    {
+        const sai_attr_metadata_t* const* list = sai_metadata_attr_by_object_type[ot];
+
+        for (size_t i = 0; list != NULL && list[i] != NULL; ++i)
+        {
+            const sai_attr_metadata_t* md = list[i];
+
+            index.attrByIdName.emplace(md->attridname, md);
+
+            sai_metadata_index_add_enum(index, md->enummetadata);
+        }
+    }
+
+    /*
+     * Enums which are not attribute values, but are serialized directly.
+     */
+
+    const sai_enum_metadata_t* enums[] = {
+        &sai_metadata_enum_sai_acl_action_type_t,
+        &sai_metadata_enum_sai_api_t,
+        &sai_metadata_enum_sai_attr_value_type_t,
+        &sai_metadata_enum_sai_buffer_pool_stat_t,
+        &sai_metadata_enum_sai_common_api_t,
+        &sai_metadata_enum_sai_fdb_entry_bridge_type_t,
+        &sai_metadata_enum_sai_fdb_event_t,
+        &sai_metadata_enum_sai_ingress_priority_group_stat_t,
+        &sai_metadata_enum_sai_object_type_t,
+        &sai_metadata_enum_sai_packet_color_t,
+        &sai_metadata_enum_sai_port_oper_status_t,
+        &sai_metadata_enum_sai_port_stat_t,
+        &sai_metadata_enum_sai_queue_attr_t,
+        &sai_metadata_enum_sai_queue_pfc_deadlock_event_type_t,
+        &sai_metadata_enum_sai_queue_stat_t,
+        &sai_metadata_enum_sai_status_t,
+        &sai_metadata_enum_sai_switch_oper_status_t,
+    };
+
+    for (auto meta: enums)
+    {
+        sai_metadata_index_add_enum(index, meta);
+    }
+
+    return index;
 }
 
-std::string sai_serialize_enum(
+static const sai_metadata_index_t& sai_metadata_index_get()
+{
+    // initialization of local static is thread safe
+
+    static const sai_metadata_index_t index = sai_metadata_index_create();
+
+    return index;
+}
+
+/**
+ * @brief Gets index of enum, NULL if enum is not indexed and linear scan
+ * must be used.
+ */
+static inline const sai_enum_index_t* sai_metadata_index_get_enum(
+        _In_ const sai_enum_metadata_t* meta)
+{
+    const auto& enums = sai_metadata_index_get().enums;
+
+    auto it = enums.find(meta);
+
+    return (it == enums.end()) ? NULL : &it->second;
+}
+
+void sai_serialize_append_enum(
+        _Inout_ std::string& buf,
         _In_ const int32_t value,
         _In_ const sai_enum_metadata_t* meta)
 {
     if (meta == NULL)
     {
-        return sai_serialize_number(value);
+        sai_serialize_append_number(buf, value);
+        return;
     }
 
-    for (size_t i = 0; i < meta->valuescount; ++i)
+    const sai_enum_index_t* enumIndex = sai_metadata_index_get_enum(meta);
+
+    if (enumIndex != NULL)
+    {
+        auto it = enumIndex->byValue.find(value);
+
+        if (it != enumIndex->byValue.end())
+        {
+            buf += it->second;
+            return;
+        }
+    }
+    else
     {
-        if (meta->values[i] == value)
+        for (size_t i = 0; i < meta->valuescount; ++i)
         {
-            return meta->valuesnames[i];
+            if (meta->values[i] == value)
+            {
+                buf += meta->valuesnames[i];
+                return;
+            }
         }
     }
 
     SWSS_LOG_WARN("enum value %d not found in enum %s", value, meta->name);
 
-    return sai_serialize_number(value);
+    sai_serialize_append_number(buf, value);
+}
+
+std::string sai_serialize_enum(
+        _In_ const int32_t value,
+        _In_ const sai_enum_metadata_t* meta)
+{
+    std::string s;
+
+    sai_serialize_append_enum(s, value, meta);
+
+    return s;
 }
 
 std::string sai_serialize_number(
@@ -636,14 +892,6 @@ std::string sai_serialize_attr_value_type(
     return sai_serialize_enum(attr_value_type, &sai_metadata_enum_sai_attr_value_type_t);
 }
 
-std::string sai_serialize_packet_color(
-        _In_ sai_packet_color_t color)
-{
-    SWSS_LOG_ENTER();
-
-    return sai_serialize_enum(color, &sai_metadata_enum_sai_packet_color_t);
-}
-
 std::string sai_serialize_vlan_id(
         _In_ sai_vlan_id_t vlan_id)
 {
@@ -750,68 +998,76 @@ std::string sai_serialize_switch_shutdown_request(
     return j.dump();
 }
 
-std::string sai_serialize_ipv4(
+static void sai_serialize_append_ipv4(
+        _Inout_ std::string& buf,
         _In_ sai_ip4_t ip)
 {
-    SWSS_LOG_ENTER();
-
-    char buf[INET_ADDRSTRLEN];
+    // address is in network order, so bytes are in print order
 
-    struct sockaddr_in sa;
+    const uint8_t* bytes = (const uint8_t*)&ip;
 
-    memcpy(&sa.sin_addr, &ip, 4);
-
-    if (inet_ntop(AF_INET, &(sa.sin_addr), buf, INET_ADDRSTRLEN) == NULL)
+    for (int i = 0; i < 4; ++i)
     {
-        SWSS_LOG_ERROR("FATAL: failed to convert IPv4 address, errno: %s", strerror(errno));
-        throw std::runtime_error("failed to convert IPv4");
-    }
-
-    return buf;
-}
-
-std::string sai_serialize_pointer(
-        _In_ sai_pointer_t ptr)
-{
-    SWSS_LOG_ENTER();
+        if (i)
+        {
+            buf += '.';
+        }
 
-    return sai_serialize_number((uint64_t)ptr, true);
+        sai_serialize_append_decimal(buf, (uint64_t)bytes[i]);
+    }
 }
 
-std::string sai_serialize_ipv6(
+static void sai_serialize_append_ipv6(
+        _Inout_ std::string& buf,
         _In_ const sai_ip6_t& ip)
 {
-    SWSS_LOG_ENTER();
+    /*
+     * IPv6 zero compression and embedded IPv4 forms are left to inet_ntop,
+     * so output is the same as before.
+     */
 
-    char buf[INET6_ADDRSTRLEN];
+    char tmp[INET6_ADDRSTRLEN];
 
     struct sockaddr_in6 sa6;
 
     memcpy(&sa6.sin6_addr, ip, 16);
 
-    if (inet_ntop(AF_INET6, &(sa6.sin6_addr), buf, INET6_ADDRSTRLEN) == NULL)
+    if (inet_ntop(AF_INET6, &(sa6.sin6_addr), tmp, INET6_ADDRSTRLEN) == NULL)
     {
         SWSS_LOG_ERROR("FATAL: failed to convert IPv6 address, errno: %s", strerror(errno));
         throw std::runtime_error("failed to convert IPv6");
     }
 
-    return buf;
+    buf += tmp;
 }
 
-std::string sai_serialize_ip_address(
-        _In_ const sai_ip_address_t& ipaddress)
+std::string sai_serialize_ipv6(
+        _In_ const sai_ip6_t& ip)
 {
     SWSS_LOG_ENTER();
 
+    std::string s;
+
+    sai_serialize_append_ipv6(s, ip);
+
+    return s;
+}
+
+void sai_serialize_append_ip_address(
+        _Inout_ std::string& buf,
+        _In_ const sai_ip_address_t& ipaddress)
+{
     switch (ipaddress.addr_family)
     {
         case SAI_IP_ADDR_FAMILY_IPV4:
 
-            return sai_serialize_ipv4(ipaddress.addr.ip4);
+            sai_serialize_append_ipv4(buf, ipaddress.addr.ip4);
+            break;
 
         case SAI_IP_ADDR_FAMILY_IPV6:
 
-            return sai_serialize_ipv6(ipaddress.addr.ip6);
+            sai_serialize_append_ipv6(buf, ipaddress.addr.ip6);
+            break;
 
         default:
 
@@ -820,138 +1076,168 @@ std::string sai_serialize_ip_address(
     }
 }
 
+std::string sai_serialize_ip_address(
+        _In_ const sai_ip_address_t& ipaddress)
+{
+    SWSS_LOG_ENTER();
+
+    std::string s;
+
+    sai_serialize_append_ip_address(s, ipaddress);
+
+    return s;
+}
+
+void sai_serialize_append_object_id(
+        _Inout_ std::string& buf,
+        _In_ sai_object_id_t oid)
+{
+    buf += "oid:";
+
+    sai_serialize_append_hex(buf, oid);
+}
+
 std::string sai_serialize_object_id(
         _In_ sai_object_id_t oid)
 {
-    char buf[32];
+    std::string s;
+
+    s.reserve(24);
 
-    snprintf(buf, sizeof(buf), "oid:0x%lx", oid);
+    sai_serialize_append_object_id(s, oid);
 
-    return buf;
+    return s;
 }
 
 template<typename T, typename F>
-std::string sai_serialize_list(
+void sai_serialize_append_list(
+        _Inout_ std::string& buf,
         _In_ const T& list,
         _In_ bool countOnly,
         F serialize_item)
 {
     SWSS_LOG_ENTER();
 
-    std::string s = sai_serialize_number(list.count);
+    sai_serialize_append_number(buf, list.count);
 
     if (countOnly)
     {
-        return s;
+        return;
     }
 
     if (list.list == NULL || list.count == 0)
     {
-        return s + ":null";
+        buf += ":null";
+        return;
     }
 
-    std::string l;
+    buf += ':';
 
     for (uint32_t i = 0; i < list.count; ++i)
     {
-        l += serialize_item(list.list[i]);
-
-        if (i != list.count -1)
+        if (i)
         {
-            l += ",";
+            buf += ',';
         }
-    }
-
-    return s + ":" + l;
 
+        serialize_item(buf, list.list[i]);
+    }
 }
 
-std::string sai_serialize_enum_list(
+static void sai_serialize_append_enum_list(
+        _Inout_ std::string& buf,
         _In_ const sai_s32_list_t& list,
         _In_ const sai_enum_metadata_t* meta,
         _In_ bool countOnly)
 {
     SWSS_LOG_ENTER();
 
-    return sai_serialize_list(list, countOnly, [&](int32_t item) { return sai_serialize_enum(item, meta);} );
+    sai_serialize_append_list(buf, list, countOnly, [&](std::string& b, int32_t item) { sai_serialize_append_enum(b, item, meta);} );
 }
 
-std::string sai_serialize_oid_list(
+static void sai_serialize_append_oid_list(
+        _Inout_ std::string& buf,
         _In_ const sai_object_list_t &list,
         _In_ bool countOnly)
 {
     SWSS_LOG_ENTER();
 
-    return sai_serialize_list(list, countOnly, [&](sai_object_id_t item) { return sai_serialize_object_id(item);} );
+    sai_serialize_append_list(buf, list, countOnly, [&](std::string& b, sai_object_id_t item) { sai_serialize_append_object_id(b, item);} );
 }
 
 template <typename T>
-std::string sai_serialize_number_list(
+void sai_serialize_append_number_list(
+        _Inout_ std::string& buf,
         _In_ const T& list,
         _In_ bool countOnly,
         _In_ bool hex = false)
 {
     SWSS_LOG_ENTER();
 
-    return sai_serialize_list(list, countOnly, [&](decltype(*list.list)& item) { return sai_serialize_number(item, hex);} );
+    sai_serialize_append_list(buf, list, countOnly, [&](std::string& b, decltype(*list.list)& item) { sai_serialize_append_number(b, item, hex);} );
 }
 
-json sai_serialize_qos_map_params(
-        _In_ const sai_qos_map_params_t& params)
-{
-    json j;
-
-    j["tc"]     = params.tc;
-    j["dscp"]   = params.dscp;
-    j["dot1p"]  = params.dot1p;
-    j["prio"]   = params.prio;
-    j["pg"]     = params.pg;
-    j["qidx"]   = params.queue_index;
-    j["color"]  = sai_serialize_packet_color(params.color);
+/*
+ * QoS map is serialized by hand, but output must be the same as json dump,
+ * which has keys sorted and no spaces, since serialized values are compared
+ * as strings.
+ */
 
-    return j;
-}
-
-json sai_serialize_qos_map(
-        _In_ const sai_qos_map_t& qosmap)
+static void sai_serialize_append_qos_map_params(
+        _Inout_ std::string& buf,
+        _In_ const sai_qos_map_params_t& params)
 {
-    json j;
-
-    j["key"]    = sai_serialize_qos_map_params(qosmap.key);
-    j["value"]  = sai_serialize_qos_map_params(qosmap.value);;
-
-    return j;
-}
-
-std::string sai_serialize_qos_map_list(
+    buf += "{\"color\":\"";
+    sai_serialize_append_enum(buf, params.color, &sai_metadata_enum_sai_packet_color_t);
+    buf += "\",\"dot1p\":";
+    sai_serialize_append_number(buf, params.dot1p);
+    buf += ",\"dscp\":";
+    sai_serialize_append_number(buf, params.dscp);
+    buf += ",\"pg\":";
+    sai_serialize_append_number(buf, params.pg);
+    buf += ",\"prio\":";
+    sai_serialize_append_number(buf, params.prio);
+    buf += ",\"qidx\":";
+    sai_serialize_append_number(buf, params.queue_index);
+    buf += ",\"tc\":";
+    sai_serialize_append_number(buf, params.tc);
+    buf += '}';
+}
+
+static void sai_serialize_append_qos_map_list(
+        _Inout_ std::string& buf,
         _In_ const sai_qos_map_list_t& qosmap,
         _In_ bool countOnly)
 {
     SWSS_LOG_ENTER();
 
-    json j;
+    buf += "{\"count\":";
 
-    j["count"] = qosmap.count;
+    sai_serialize_append_number(buf, qosmap.count);
 
     if (qosmap.list == NULL || countOnly)
     {
-        j["list"] = nullptr;
-
-        return j.dump();
+        buf += ",\"list\":null}";
+        return;
     }
 
-    json arr = json::array();
+    buf += ",\"list\":[";
 
     for (uint32_t i = 0; i < qosmap.count; ++i)
     {
-        json item = sai_serialize_qos_map(qosmap.list[i]);
+        if (i)
+        {
+            buf += ',';
+        }
 
-        arr.push_back(item);
+        buf += "{\"key\":";
+        sai_serialize_append_qos_map_params(buf, qosmap.list[i].key);
+        buf += ",\"value\":";
+        sai_serialize_append_qos_map_params(buf, qosmap.list[i].value);
+        buf += '}';
     }
 
-    j["list"] = arr;
-
-    return j.dump();
+    buf += "]}";
 }
 
 json sai_serialize_tunnel_map_params(
@@ -1010,15 +1296,19 @@ std::string sai_serialize_tunnel_map_list(
 }
 
 template <typename T>
-std::string sai_serialize_range(
+void sai_serialize_append_range(
+        _Inout_ std::string& buf,
         _In_ const T& range)
 {
     SWSS_LOG_ENTER();
 
-    return sai_serialize_number(range.min) + "," + sai_serialize_number(range.max);
+    sai_serialize_append_number(buf, range.min);
+    buf += ',';
+    sai_serialize_append_number(buf, range.max);
 }
 
-std::string sai_serialize_acl_action(
+static void sai_serialize_append_acl_action(
+        _Inout_ std::string& buf,
         _In_ const sai_attr_metadata_t& meta,
         _In_ const sai_acl_action_data_t& action,
         _In_ bool countOnly)
@@ -1028,43 +1318,44 @@ std::string sai_serialize_acl_action(
     if (action.enable == false)
     {
         // parameter is not needed when action is disabled
-        return "disabled";
+        buf += "disabled";
+        return;
     }
 
     switch (meta.attrvaluetype)
     {
         case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_UINT8:
-            return sai_serialize_number(action.parameter.u8);
+            return sai_serialize_append_number(buf, action.parameter.u8);
 
         case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_INT8:
-            return sai_serialize_number(action.parameter.s8);
+            return sai_serialize_append_number(buf, action.parameter.s8);
 
         case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_UINT16:
-            return sai_serialize_number(action.parameter.u16);
+            return sai_serialize_append_number(buf, action.parameter.u16);
 
         case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_INT16:
-            return sai_serialize_number(action.parameter.s16);
+            return sai_serialize_append_number(buf, action.parameter.s16);
 
         case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_UINT32:
-            return sai_serialize_number(action.parameter.u32);
+            return sai_serialize_append_number(buf, action.parameter.u32);
 
         case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_INT32:
-            return sai_serialize_enum(action.parameter.s32, meta.enummetadata);
+            return sai_serialize_append_enum(buf, action.parameter.s32, meta.enummetadata);
 
         case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_MAC:
-            return sai_serialize_mac(action.parameter.mac);
+            return sai_serialize_append_mac(buf, action.parameter.mac);
 
         case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_IPV4:
-            return sai_serialize_ipv4(action.parameter.ip4);
+            return sai_serialize_append_ipv4(buf, action.parameter.ip4);
 
         case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_IPV6:
-            return sai_serialize_ipv6(action.parameter.ip6);
+            return sai_serialize_append_ipv6(buf, action.parameter.ip6);
 
         case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_ID:
-            return sai_serialize_object_id(action.parameter.oid);
+            return sai_serialize_append_object_id(buf, action.parameter.oid);
 
         case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
-            return sai_serialize_oid_list(action.parameter.objlist, countOnly);
+            return sai_serialize_append_oid_list(buf, action.parameter.objlist, countOnly);
 
         default:
             SWSS_LOG_ERROR("FATAIL: invalid serialization type %d", meta.attrvaluetype);
@@ -1072,7 +1363,8 @@ std::string sai_serialize_acl_action(
     }
 }
 
-std::string sai_serialize_acl_field(
+static void sai_serialize_append_acl_field(
+        _Inout_ std::string& buf,
         _In_ const sai_attr_metadata_t& meta,
         _In_ const sai_acl_field_data_t& field,
         _In_ bool countOnly)
@@ -1082,49 +1374,70 @@ std::string sai_serialize_acl_field(
     if (field.enable == false)
     {
         // parameter is not needed when field is disabled
-        return "disabled";
+        buf += "disabled";
+        return;
     }
 
     switch (meta.attrvaluetype)
     {
         case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_BOOL:
-            return sai_serialize_bool(field.data.booldata);
+            return sai_serialize_append_bool(buf, field.data.booldata);
 
         case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_UINT8:
-            return sai_serialize_number(field.data.u8) + "&mask:" + sai_serialize_number(field.mask.u8, true);
+            sai_serialize_append_number(buf, field.data.u8);
+            buf += "&mask:";
+            return sai_serialize_append_number(buf, field.mask.u8, true);
 
         case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_INT8:
-            return sai_serialize_number(field.data.s8) + "&mask:" + sai_serialize_number(field.mask.s8, true);
+            sai_serialize_append_number(buf, field.data.s8);
+            buf += "&mask:";
+            return sai_serialize_append_number(buf, field.mask.s8, true);
 
         case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_UINT16:
-            return sai_serialize_number(field.data.u16) + "&mask:" + sai_serialize_number(field.mask.u16, true);
+            sai_serialize_append_number(buf, field.data.u16);
+            buf += "&mask:";
+            return sai_serialize_append_number(buf, field.mask.u16, true);
 
         case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_INT16:
-            return sai_serialize_number(field.data.s16) + "&mask:" + sai_serialize_number(field.mask.s16, true);
+            sai_serialize_append_number(buf, field.data.s16);
+            buf += "&mask:";
+            return sai_serialize_append_number(buf, field.mask.s16, true);
 
         case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_UINT32:
-            return sai_serialize_number(field.data.u32) + "&mask:" + sai_serialize_number(field.mask.u32, true);
+            sai_serialize_append_number(buf, field.data.u32);
+            buf += "&mask:";
+            return sai_serialize_append_number(buf, field.mask.u32, true);
 
         case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_INT32:
-            return sai_serialize_enum(field.data.s32, meta.enummetadata) + "&mask:" + sai_serialize_number(field.mask.s32, true);
+            sai_serialize_append_enum(buf, field.data.s32, meta.enummetadata);
+            buf += "&mask:";
+            return sai_serialize_append_number(buf, field.mask.s32, true);
 
         case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_MAC:
-            return sai_serialize_mac(field.data.mac) +"&mask:" + sai_serialize_mac(field.mask.mac);
+            sai_serialize_append_mac(buf, field.data.mac);
+            buf += "&mask:";
+            return sai_serialize_append_mac(buf, field.mask.mac);
 
         case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_IPV4:
-            return sai_serialize_ipv4(field.data.ip4) +"&mask:" + sai_serialize_ipv4(field.mask.ip4);
+            sai_serialize_append_ipv4(buf, field.data.ip4);
+            buf += "&mask:";
+            return sai_serialize_append_ipv4(buf, field.mask.ip4);
 
         case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_IPV6:
-            return sai_serialize_ipv6(field.data.ip6) +"&mask:" + sai_serialize_ipv6(field.mask.ip6);
+            sai_serialize_append_ipv6(buf, field.data.ip6);
+            buf += "&mask:";
+            return sai_serialize_append_ipv6(buf, field.mask.ip6);
 
         case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_ID:
-            return sai_serialize_object_id(field.data.oid);
+            return sai_serialize_append_object_id(buf, field.data.oid);
 
         case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
-            return sai_serialize_oid_list(field.data.objlist, countOnly);
+            return sai_serialize_append_oid_list(buf, field.data.objlist, countOnly);
 
         case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_UINT8_LIST:
-            return sai_serialize_number_list(field.data.u8list, countOnly) + "&mask:" + sai_serialize_number_list(field.mask.u8list, countOnly, true);
+            sai_serialize_append_number_list(buf, field.data.u8list, countOnly);
+            buf += "&mask:";
+            return sai_serialize_append_number_list(buf, field.mask.u8list, countOnly, true);
 
         default:
             SWSS_LOG_ERROR("FATAIL: invalid serialization type %d", meta.attrvaluetype);
@@ -1132,21 +1445,23 @@ std::string sai_serialize_acl_field(
     }
 }
 
-std::string sai_serialize_acl_capability(
+static void sai_serialize_append_acl_capability(
+        _Inout_ std::string& buf,
         _In_ const sai_attr_metadata_t &meta,
         _In_ const sai_acl_capability_t &cap,
         _In_ bool countOnly)
 {
     SWSS_LOG_ENTER();
 
-    auto mandatory = sai_serialize_bool(cap.is_action_list_mandatory);
+    sai_serialize_append_bool(buf, cap.is_action_list_mandatory);
 
-    auto list = sai_serialize_enum_list(cap.action_list, &sai_metadata_enum_sai_acl_action_type_t, countOnly);
+    buf += ':';
 
-    return mandatory + ":" + list;
+    sai_serialize_append_enum_list(buf, cap.action_list, &sai_metadata_enum_sai_acl_action_type_t, countOnly);
 }
 
-std::string sai_serialize_attr_value(
+void sai_serialize_append_attr_value(
+        _Inout_ std::string& buf,
         _In_ const sai_attr_metadata_t& meta,
         _In_ const sai_attribute_t &attr,
         _In_ const bool countOnly)
@@ -1156,88 +1471,89 @@ std::string sai_serialize_attr_value(
     switch (meta.attrvaluetype)
     {
         case SAI_ATTR_VALUE_TYPE_BOOL:
-            return sai_serialize_bool(attr.value.booldata);
+            return sai_serialize_append_bool(buf, attr.value.booldata);
 
         case SAI_ATTR_VALUE_TYPE_CHARDATA:
-            return sai_serialize_chardata(attr.value.chardata);
+            return sai_serialize_append_chardata(buf, attr.value.chardata);
 
         case SAI_ATTR_VALUE_TYPE_UINT8:
-            return sai_serialize_number(attr.value.u8);
+            return sai_serialize_append_number(buf, attr.value.u8);
 
         case SAI_ATTR_VALUE_TYPE_INT8:
-            return sai_serialize_number(attr.value.s8);
+            return sai_serialize_append_number(buf, attr.value.s8);
 
         case SAI_ATTR_VALUE_TYPE_UINT16:
-            return sai_serialize_number(attr.value.u16);
+            return sai_serialize_append_number(buf, attr.value.u16);
 
         case SAI_ATTR_VALUE_TYPE_INT16:
-            return sai_serialize_number(attr.value.s16);
+            return sai_serialize_append_number(buf, attr.value.s16);
 
         case SAI_ATTR_VALUE_TYPE_UINT32:
-            return sai_serialize_number(attr.value.u32);
+            return sai_serialize_append_number(buf, attr.value.u32);
 
         case SAI_ATTR_VALUE_TYPE_INT32:
-            return sai_serialize_enum(attr.value.s32, meta.enummetadata);
+            return sai_serialize_append_enum(buf, attr.value.s32, meta.enummetadata);
 
         case SAI_ATTR_VALUE_TYPE_UINT64:
-            return sai_serialize_number(attr.value.u64);
+            return sai_serialize_append_number(buf, attr.value.u64);
 
         case SAI_ATTR_VALUE_TYPE_INT64:
-            return sai_serialize_number(attr.value.s64);
+            return sai_serialize_append_number(buf, attr.value.s64);
 
         case SAI_ATTR_VALUE_TYPE_MAC:
-            return sai_serialize_mac(attr.value.mac);
+            return sai_serialize_append_mac(buf, attr.value.mac);
 
         case SAI_ATTR_VALUE_TYPE_IPV4:
-            return sai_serialize_ipv4(attr.value.ip4);
+            return sai_serialize_append_ipv4(buf, attr.value.ip4);
 
         case SAI_ATTR_VALUE_TYPE_IPV6:
-            return sai_serialize_ipv6(attr.value.ip6);
+            return sai_serialize_append_ipv6(buf, attr.value.ip6);
 
         case SAI_ATTR_VALUE_TYPE_POINTER:
-            return sai_serialize_pointer(attr.value.ptr);
+            return sai_serialize_append_number(buf, (uint64_t)attr.value.ptr, true);
 
         case SAI_ATTR_VALUE_TYPE_IP_ADDRESS:
-            return sai_serialize_ip_address(attr.value.ipaddr);
+            return sai_serialize_append_ip_address(buf, attr.value.ipaddr);
 
         case SAI_ATTR_VALUE_TYPE_OBJECT_ID:
-            return sai_serialize_object_id(attr.value.oid);
+            return sai_serialize_append_object_id(buf, attr.value.oid);
 
         case SAI_ATTR_VALUE_TYPE_OBJECT_LIST:
-            return sai_serialize_oid_list(attr.value.objlist, countOnly);
+            return sai_serialize_append_oid_list(buf, attr.value.objlist, countOnly);
 
         case SAI_ATTR_VALUE_TYPE_UINT8_LIST:
-            return sai_serialize_number_list(attr.value.u8list, countOnly);
+            return sai_serialize_append_number_list(buf, attr.value.u8list, countOnly);
 
         case SAI_ATTR_VALUE_TYPE_INT8_LIST:
-            return sai_serialize_number_list(attr.value.s8list, countOnly);
+            return sai_serialize_append_number_list(buf, attr.value.s8list, countOnly);
 
         case SAI_ATTR_VALUE_TYPE_UINT16_LIST:
-            return sai_serialize_number_list(attr.value.u16list, countOnly);
+            return sai_serialize_append_number_list(buf, attr.value.u16list, countOnly);
 
         case SAI_ATTR_VALUE_TYPE_INT16_LIST:
-            return sai_serialize_number_list(attr.value.s16list, countOnly);
+            return sai_serialize_append_number_list(buf, attr.value.s16list, countOnly);
 
         case SAI_ATTR_VALUE_TYPE_UINT32_LIST:
-            return sai_serialize_number_list(attr.value.u32list, countOnly);
+            return sai_serialize_append_number_list(buf, attr.value.u32list, countOnly);
 
         case SAI_ATTR_VALUE_TYPE_INT32_LIST:
-            return sai_serialize_enum_list(attr.value.s32list, meta.enummetadata, countOnly);
+            return sai_serialize_append_enum_list(buf, attr.value.s32list, meta.enummetadata, countOnly);
 
         case SAI_ATTR_VALUE_TYPE_UINT32_RANGE:
-            return sai_serialize_range(attr.value.u32range);
+            return sai_serialize_append_range(buf, attr.value.u32range);
 
         case SAI_ATTR_VALUE_TYPE_INT32_RANGE:
-            return sai_serialize_range(attr.value.s32range);
+            return sai_serialize_append_range(buf, attr.value.s32range);
 
         case SAI_ATTR_VALUE_TYPE_VLAN_LIST:
-            return sai_serialize_number_list(attr.value.vlanlist, countOnly);
+            return sai_serialize_append_number_list(buf, attr.value.vlanlist, countOnly);
 
         case SAI_ATTR_VALUE_TYPE_QOS_MAP_LIST:
-            return sai_serialize_qos_map_list(attr.value.qosmap, countOnly);
+            return sai_serialize_append_qos_map_list(buf, attr.value.qosmap, countOnly);
 
         case SAI_ATTR_VALUE_TYPE_TUNNEL_MAP_LIST:
-            return sai_serialize_tunnel_map_list(attr.value.tunnelmap, countOnly);
+            buf += sai_serialize_tunnel_map_list(attr.value.tunnelmap, countOnly);
+            return;
 
             // ACL FIELD DATA
 
@@ -1254,7 +1570,7 @@ std::string sai_serialize_attr_value(
         case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_ID:
         case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
         case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_UINT8_LIST:
-            return sai_serialize_acl_field(meta, attr.value.aclfield, countOnly);
+            return sai_serialize_append_acl_field(buf, meta, attr.value.aclfield, countOnly);
 
             // ACL ACTION DATA
 
@@ -1269,10 +1585,10 @@ std::string sai_serialize_attr_value(
         case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_IPV6:
         case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_ID:
         case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
-            return sai_serialize_acl_action(meta, attr.value.aclaction, countOnly);
+            return sai_serialize_append_acl_action(buf, meta, attr.value.aclaction, countOnly);
 
         case SAI_ATTR_VALUE_TYPE_ACL_CAPABILITY:
-            return sai_serialize_acl_capability(meta, attr.value.aclcapability, countOnly);
+            return sai_serialize_append_acl_capability(buf, meta, attr.value.aclcapability, countOnly);
 
         default:
             SWSS_LOG_ERROR("FATAL: invalid serialization type %d", meta.attrvaluetype);
@@ -1280,20 +1596,39 @@ std::string sai_serialize_attr_value(
     }
 }
 
-std::string sai_serialize_ip_prefix(
-        _In_ const sai_ip_prefix_t& prefix)
+std::string sai_serialize_attr_value(
+        _In_ const sai_attr_metadata_t& meta,
+        _In_ const sai_attribute_t &attr,
+        _In_ const bool countOnly)
 {
     SWSS_LOG_ENTER();
 
+    std::string s;
+
+    sai_serialize_append_attr_value(s, meta, attr, countOnly);
+
+    return s;
+}
+
+void sai_serialize_append_ip_prefix(
+        _Inout_ std::string& buf,
+        _In_ const sai_ip_prefix_t& prefix)
+{
     switch (prefix.addr_family)
     {
         case SAI_IP_ADDR_FAMILY_IPV4:
 
-            return sai_serialize_ipv4(prefix.addr.ip4) + "/" + sai_serialize_number((get_ipv4_mask(prefix.mask.ip4)));
+            sai_serialize_append_ipv4(buf, prefix.addr.ip4);
+            buf += '/';
+            sai_serialize_append_number(buf, get_ipv4_mask(prefix.mask.ip4));
+            break;
 
         case SAI_IP_ADDR_FAMILY_IPV6:
 
-            return sai_serialize_ipv6(prefix.addr.ip6) + "/" + sai_serialize_number(get_ipv6_mask(prefix.mask.ip6));
+            sai_serialize_append_ipv6(buf, prefix.addr.ip6);
+            buf += '/';
+            sai_serialize_append_number(buf, get_ipv6_mask(prefix.mask.ip6));
+            break;
 
         default:
 
@@ -1302,6 +1637,18 @@ std::string sai_serialize_ip_prefix(
     }
 }
 
+std::string sai_serialize_ip_prefix(
+        _In_ const sai_ip_prefix_t& prefix)
+{
+    SWSS_LOG_ENTER();
+
+    std::string s;
+
+    sai_serialize_append_ip_prefix(s, prefix);
+
+    return s;
+}
+
 std::string sai_serialize_port_oper_status(
         _In_ sai_port_oper_status_t status)
 {
@@ -1618,14 +1965,29 @@ void sai_deserialize_enum(
         return sai_deserialize_number(s, value);
     }
 
-    for (size_t i = 0; i < meta->valuescount; ++i)
+    const sai_enum_index_t* enumIndex = sai_metadata_index_get_enum(meta);
+
+    if (enumIndex != NULL)
     {
-        if (strcmp(s.c_str(), meta->valuesnames[i]) == 0)
+        auto it = enumIndex->byName.find(s);
+
+        if (it != enumIndex->byName.end())
         {
-            value = meta->values[i];
+            value = it->second;
             return;
         }
     }
+    else
+    {
+        for (size_t i = 0; i < meta->valuescount; ++i)
+        {
+            if (strcmp(s.c_str(), meta->valuesnames[i]) == 0)
+            {
+                value = meta->values[i];
+                return;
+            }
+        }
+    }
 
     SWSS_LOG_WARN("enum %s not found in enum %s", s.c_str(), meta->name);
 
@@ -2448,15 +2810,17 @@ void sai_deserialize_attr_id(
         throw std::runtime_error("meta pointer is null");
     }
 
-    auto m = sai_metadata_get_attr_metadata_by_attr_id_name(s.c_str());
+    const auto& attrs = sai_metadata_index_get().attrByIdName;
+
+    auto it = attrs.find(s);
 
-    if (m == NULL)
+    if (it == attrs.end())
     {
         SWSS_LOG_ERROR("invalid attr id: %s", s.c_str());
         throw std::runtime_error("invalid attr id");
     }
 
-    *meta = m;
+    *meta = it->second;
 }
 
 void sai_deserialize_attr_id(
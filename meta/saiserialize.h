@@ -102,6 +102,45 @@ std::string sai_serialize_object_meta_key(
 std::string sai_serialize_mac(
         _In_ const sai_mac_t mac);
 
+// serialize append
+
+/*
+ * Functions below append serialized value to buffer, without creating
+ * temporary strings, output is the same as corresponding sai_serialize_*.
+ */
+
+void sai_serialize_append_number(
+        _Inout_ std::string& buf,
+        _In_ uint32_t number,
+        _In_ bool hex = false);
+
+void sai_serialize_append_enum(
+        _Inout_ std::string& buf,
+        _In_ const int32_t value,
+        _In_ const sai_enum_metadata_t* meta);
+
+void sai_serialize_append_object_id(
+        _Inout_ std::string& buf,
+        _In_ sai_object_id_t object_id);
+
+void sai_serialize_append_mac(
+        _Inout_ std::string& buf,
+        _In_ const sai_mac_t mac);
+
+void sai_serialize_append_ip_address(
+        _Inout_ std::string& buf,
+        _In_ const sai_ip_address_t &ip_address);
+
+void sai_serialize_append_ip_prefix(
+        _Inout_ std::string& buf,
+        _In_ const sai_ip_prefix_t &ip_prefix);
+
+void sai_serialize_append_attr_value(
+        _Inout_ std::string& buf,
+        _In_ const sai_attr_metadata_t& meta,
+        _In_ const sai_attribute_t &attr,
+        _In_ const bool countOnly = false);
+
 // serialize ntf
 
 std::string sai_serialize_fdb_event_ntf(
@@ -123,6 +162,11 @@ void sai_deserialize_number(
         _Out_ uint32_t& number,
         _In_ bool hex = false);
 
+void sai_deserialize_enum(
+        _In_ const std::string& s,
+        _In_ const sai_enum_metadata_t *meta,
+        _Out_ int32_t& value);
+
 void sai_deserialize_status(
         _In_ const std::string& s,
         _Out_ sai_status_t& status);
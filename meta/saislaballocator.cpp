@@ -0,0 +1,141 @@
+#include "saislaballocator.h"
+
+#include "swss/logger.h"
+
+#include <algorithm>
+
+SaiSlabPool::SaiSlabPool(
+        _In_ size_t chunkSize):
+    m_used(0),
+    m_free(NULL)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Chunk must hold free list pointer when not used and must keep
+     * alignment of every chunk in slab.
+     */
+
+    const size_t align = alignof(std::max_align_t);
+
+    if (chunkSize < sizeof(FreeChunk))
+    {
+        chunkSize = sizeof(FreeChunk);
+    }
+
+    m_chunkSize = (chunkSize + align - 1) / align * align;
+}
+
+SaiSlabPool::~SaiSlabPool()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_used)
+    {
+        SWSS_LOG_ERROR("destroying slab pool with %zu chunks still in use", m_used);
+    }
+
+    releaseSlabs(0);
+}
+
+void* SaiSlabPool::allocate()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_free == NULL)
+    {
+        addSlab();
+    }
+
+    FreeChunk* chunk = m_free;
+
+    m_free = chunk->next;
+
+    m_used++;
+
+    return chunk;
+}
+
+void SaiSlabPool::deallocate(
+        _In_ void* ptr)
+{
+    SWSS_LOG_ENTER();
+
+    if (ptr == NULL)
+    {
+        return;
+    }
+
+    FreeChunk* chunk = static_cast<FreeChunk*>(ptr);
+
+    chunk->next = m_free;
+
+    m_free = chunk;
+
+    if (--m_used == 0 && m_slabs.size() > 1)
+    {
+        /*
+         * All chunks returned (for example after meta_init_db), give memory
+         * back instead of keeping slabs of previously largest container. One
+         * slab is kept, so container which goes repeatedly from empty to few
+         * entries don't allocate and release slab each time.
+         */
+
+        releaseSlabs(1);
+    }
+}
+
+void SaiSlabPool::addSlab()
+{
+    SWSS_LOG_ENTER();
+
+    char* slab = static_cast<char*>(::operator new(m_chunkSize * SAI_SLAB_CHUNKS_PER_SLAB));
+
+    m_slabs.push_back(slab);
+
+    addSlabChunks(slab);
+}
+
+void SaiSlabPool::addSlabChunks(
+        _In_ void* slab)
+{
+    SWSS_LOG_ENTER();
+
+    char* base = static_cast<char*>(slab);
+
+    for (size_t idx = SAI_SLAB_CHUNKS_PER_SLAB; idx > 0; --idx)
+    {
+        FreeChunk* chunk = reinterpret_cast<FreeChunk*>(base + (idx - 1) * m_chunkSize);
+
+        chunk->next = m_free;
+
+        m_free = chunk;
+    }
+}
+
+void SaiSlabPool::releaseSlabs(
+        _In_ size_t keep)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Must be called only when no chunks are used, free list is rebuilt
+     * from kept slabs.
+     */
+
+    m_free = NULL;
+
+    for (size_t idx = 0; idx < m_slabs.size(); ++idx)
+    {
+        if (idx < keep)
+        {
+            addSlabChunks(m_slabs[idx]);
+        }
+        else
+        {
+            ::operator delete(m_slabs[idx]);
+        }
+    }
+
+    m_slabs.resize(std::min(keep, m_slabs.size()));
+}
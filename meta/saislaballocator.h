@@ -0,0 +1,185 @@
+#ifndef __SAI_SLAB_ALLOCATOR__
+#define __SAI_SLAB_ALLOCATOR__
+
+#include "sai.h"
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * @def SAI_SLAB_CHUNKS_PER_SLAB
+ *
+ * Number of chunks allocated at once when pool runs out of free chunks.
+ */
+#define SAI_SLAB_CHUNKS_PER_SLAB 1024
+
+/**
+ * @brief Pool of fixed size chunks carved from large slabs.
+ *
+ * Used for containers with millions of small nodes of same size (like local
+ * meta database with routes), where per node malloc header and fragmentation
+ * are significant part of memory. Freed chunks are kept on free list and
+ * slabs are released when all chunks are returned, except first one.
+ *
+ * Pool is not thread safe, it's protected by same lock as container using it.
+ */
+class SaiSlabPool
+{
+    public:
+
+        SaiSlabPool(
+                _In_ size_t chunkSize);
+
+        ~SaiSlabPool();
+
+    public:
+
+        void* allocate();
+
+        void deallocate(
+                _In_ void* ptr);
+
+    private:
+
+        SaiSlabPool(const SaiSlabPool&);
+        SaiSlabPool& operator=(const SaiSlabPool&);
+
+        void addSlab();
+
+        void addSlabChunks(
+                _In_ void* slab);
+
+        /**
+         * @brief Releases all slabs except first keep ones.
+         */
+        void releaseSlabs(
+                _In_ size_t keep);
+
+        struct FreeChunk
+        {
+            FreeChunk* next;
+        };
+
+        size_t m_chunkSize;
+
+        size_t m_used;
+
+        FreeChunk* m_free;
+
+        std::vector<void*> m_slabs;
+};
+
+/**
+ * @brief STL allocator taking single elements from per type slab pool.
+ *
+ * Allocations of more than one element (like hash table bucket arrays) are
+ * passed to global operator new.
+ */
+template <typename T>
+class SaiSlabAllocator
+{
+    public:
+
+        typedef T value_type;
+        typedef T* pointer;
+        typedef const T* const_pointer;
+        typedef T& reference;
+        typedef const T& const_reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        template <typename U>
+        struct rebind
+        {
+            typedef SaiSlabAllocator<U> other;
+        };
+
+        SaiSlabAllocator() = default;
+
+        template <typename U>
+        SaiSlabAllocator(
+                _In_ const SaiSlabAllocator<U>&)
+        {
+            // empty, all allocators of same type share pool
+        }
+
+    public:
+
+        T* allocate(
+                _In_ size_t n)
+        {
+            if (n == 1)
+            {
+                return static_cast<T*>(getPool().allocate());
+            }
+
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(
+                _In_ T* ptr,
+                _In_ size_t n)
+        {
+            if (n == 1)
+            {
+                getPool().deallocate(ptr);
+                return;
+            }
+
+            ::operator delete(ptr);
+        }
+
+        template <typename U, typename... Args>
+        void construct(
+                _In_ U* ptr,
+                _In_ Args&&... args)
+        {
+            ::new((void*)ptr) U(std::forward<Args>(args)...);
+        }
+
+        template <typename U>
+        void destroy(
+                _In_ U* ptr)
+        {
+            ptr->~U();
+        }
+
+        size_t max_size() const
+        {
+            return ((size_t)-1) / sizeof(T);
+        }
+
+    private:
+
+        static SaiSlabPool& getPool()
+        {
+            /*
+             * Pool is intentionally never destroyed, since containers using
+             * it may be global objects destroyed after it at exit.
+             */
+
+            static SaiSlabPool* pool = new SaiSlabPool(sizeof(T));
+
+            return *pool;
+        }
+};
+
+template <typename T, typename U>
+bool operator==(
+        _In_ const SaiSlabAllocator<T>&,
+        _In_ const SaiSlabAllocator<U>&)
+{
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(
+        _In_ const SaiSlabAllocator<T>&,
+        _In_ const SaiSlabAllocator<U>&)
+{
+    return false;
+}
+
+#endif // __SAI_SLAB_ALLOCATOR__
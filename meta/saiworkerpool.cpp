@@ -0,0 +1,195 @@
+#include "saiworkerpool.h"
+
+#include "swss/logger.h"
+
+WorkerPool::WorkerPool(
+        _In_ size_t concurrency):
+    m_concurrency(concurrency ? concurrency : 1),
+    m_job(NULL),
+    m_jobCount(0),
+    m_nextJob(0),
+    m_busyWorkers(0),
+    m_generation(0),
+    m_stop(false)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Caller thread is also processing jobs, so we need one thread less.
+     */
+
+    for (size_t idx = 1; idx < m_concurrency; idx++)
+    {
+        m_threads.emplace_back(&WorkerPool::workerThread, this);
+    }
+
+    SWSS_LOG_NOTICE("worker pool started with concurrency %zu", m_concurrency);
+}
+
+WorkerPool::~WorkerPool()
+{
+    SWSS_LOG_ENTER();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_stop = true;
+    }
+
+    m_cvWork.notify_all();
+
+    for (auto &t: m_threads)
+    {
+        t.join();
+    }
+}
+
+size_t WorkerPool::getConcurrency() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_concurrency;
+}
+
+void WorkerPool::processJobs(
+        _In_ const std::function<void(size_t)> &job,
+        _In_ size_t jobCount)
+{
+    SWSS_LOG_ENTER();
+
+    while (true)
+    {
+        size_t index = m_nextJob.fetch_add(1);
+
+        if (index >= jobCount)
+        {
+            break;
+        }
+
+        try
+        {
+            job(index);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (!m_exception)
+            {
+                m_exception = std::current_exception();
+            }
+        }
+    }
+}
+
+void WorkerPool::workerThread()
+{
+    SWSS_LOG_ENTER();
+
+    uint64_t generation = 0;
+
+    while (true)
+    {
+        const std::function<void(size_t)> *job;
+
+        size_t jobCount;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            /*
+             * Worker which wakes up after batch was already finished (job is
+             * NULL) must not join it, it waits for next batch instead. Once
+             * worker is counted as busy, run() will not return and will not
+             * start next batch, so snapshot of job is valid until worker
+             * leaves processJobs.
+             */
+
+            m_cvWork.wait(lock, [&]{ return m_stop || (m_job != NULL && m_generation != generation); });
+
+            if (m_stop)
+            {
+                return;
+            }
+
+            generation = m_generation;
+
+            job = m_job;
+            jobCount = m_jobCount;
+
+            m_busyWorkers++;
+        }
+
+        processJobs(*job, jobCount);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_busyWorkers--;
+        }
+
+        m_cvDone.notify_all();
+    }
+}
+
+void WorkerPool::run(
+        _In_ size_t jobCount,
+        _In_ const std::function<void(size_t)> &job)
+{
+    SWSS_LOG_ENTER();
+
+    if (jobCount == 0)
+    {
+        return;
+    }
+
+    if (m_threads.empty() || jobCount == 1)
+    {
+        for (size_t idx = 0; idx < jobCount; idx++)
+        {
+            job(idx);
+        }
+
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_job = &job;
+        m_jobCount = jobCount;
+        m_nextJob = 0;
+        m_exception = nullptr;
+
+        m_generation++;
+    }
+
+    m_cvWork.notify_all();
+
+    processJobs(job, jobCount);
+
+    std::exception_ptr exception;
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        /*
+         * All jobs are taken at this point, but some workers may still
+         * process their last job. Workers which didn't wake up yet will see
+         * NULL job and will not join this batch.
+         */
+
+        m_cvDone.wait(lock, [&]{ return m_busyWorkers == 0; });
+
+        m_job = NULL;
+
+        exception = m_exception;
+
+        m_exception = nullptr;
+    }
+
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
@@ -0,0 +1,96 @@
+#ifndef __SAI_WORKER_POOL__
+#define __SAI_WORKER_POOL__
+
+extern "C" {
+#include "sai.h"
+}
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Small fixed size worker pool.
+ *
+ * Pool executes batch of independent jobs identified by index and blocks
+ * caller until all jobs are finished. Caller thread also participates in
+ * processing, so pool with concurrency 1 don't create any threads and executes
+ * all jobs serially in caller context.
+ *
+ * Only one batch can be executed at given time.
+ */
+class WorkerPool
+{
+    public:
+
+        /**
+         * @brief Creates worker pool.
+         *
+         * @param concurrency Maximum number of threads (including caller
+         * thread) that will execute jobs at the same time.
+         */
+        WorkerPool(
+                _In_ size_t concurrency);
+
+        virtual ~WorkerPool();
+
+    public:
+
+        size_t getConcurrency() const;
+
+        /**
+         * @brief Executes jobs in parallel.
+         *
+         * Job function will be called exactly once for each index in range
+         * [0, jobCount), order of execution is not specified. If any job
+         * throws, first exception is rethrown in caller context after all
+         * jobs finished.
+         *
+         * @param jobCount Number of jobs.
+         * @param job Job function.
+         */
+        void run(
+                _In_ size_t jobCount,
+                _In_ const std::function<void(size_t)> &job);
+
+    private:
+
+        WorkerPool(const WorkerPool&);
+        WorkerPool& operator=(const WorkerPool&);
+
+        void workerThread();
+
+        void processJobs(
+                _In_ const std::function<void(size_t)> &job,
+                _In_ size_t jobCount);
+
+        size_t m_concurrency;
+
+        std::vector<std::thread> m_threads;
+
+        std::mutex m_mutex;
+
+        std::condition_variable m_cvWork;
+
+        std::condition_variable m_cvDone;
+
+        const std::function<void(size_t)> *m_job;
+
+        size_t m_jobCount;
+
+        std::atomic<size_t> m_nextJob;
+
+        size_t m_busyWorkers;
+
+        uint64_t m_generation;
+
+        bool m_stop;
+
+        std::exception_ptr m_exception;
+};
+
+#endif // __SAI_WORKER_POOL__
@@ -1,6 +1,9 @@
 #include "sai_meta.h"
 #include "sai_extra.h"
 #include "saiserialize.h"
+#include "sairedis.h"
+#include "saislaballocator.h"
+#include "saiworkerpool.h"
 
 #include <string.h>
 #include <arpa/inet.h>
@@ -9,12 +12,12 @@
 #include <iterator>
 #include <unordered_map>
 #include <memory>
+#include <set>
 #include <vector>
 
-class SaiAttrWrapper;
-extern std::unordered_map<std::string,std::unordered_map<sai_attr_id_t,std::shared_ptr<SaiAttrWrapper>>> ObjectAttrHash;
 extern bool is_ipv6_mask_valid(const uint8_t* mask);
-extern bool object_exists(const std::string& key);
+extern bool object_exists(const sai_object_meta_key_t& meta_key);
+extern void create_object(const sai_object_meta_key_t& meta_key);
 extern bool object_reference_exists(sai_object_id_t oid);
 extern void object_reference_inc(sai_object_id_t oid);
 extern void object_reference_dec(sai_object_id_t oid);
@@ -899,15 +902,13 @@ void test_fdb_entry_remove()
 
     sai_object_meta_key_t meta = { .objecttype = SAI_OBJECT_TYPE_FDB_ENTRY, .objectkey = { .key = { .fdb_entry = fdb_entry } } };
 
-    std::string key = sai_serialize_object_meta_key(meta);
-
-    META_ASSERT_TRUE(object_exists(key));
+    META_ASSERT_TRUE(object_exists(meta));
 
     SWSS_LOG_NOTICE("success");
     status = meta_sai_remove_fdb_entry(&fdb_entry, &dummy_success_sai_remove_fdb_entry);
     META_ASSERT_SUCCESS(status);
 
-    META_ASSERT_TRUE(!object_exists(key));
+    META_ASSERT_TRUE(!object_exists(meta));
 }
 
 void test_fdb_entry_set()
@@ -931,8 +932,7 @@ void test_fdb_entry_set()
 
     // TODO we should use CREATE for this
     sai_object_meta_key_t meta_key_fdb = { .objecttype = SAI_OBJECT_TYPE_FDB_ENTRY, .objectkey = { .key = { .fdb_entry = fdb_entry } } };
-    std::string fdb_key = sai_serialize_object_meta_key(meta_key_fdb);
-    ObjectAttrHash[fdb_key] = { };
+    create_object(meta_key_fdb);
 
     SWSS_LOG_NOTICE("attr is null");
     status = meta_sai_set_fdb_entry(&fdb_entry, NULL, &dummy_success_sai_set_fdb_entry);
@@ -1001,8 +1001,7 @@ void test_fdb_entry_get()
 
     // TODO we should use CREATE for this
     sai_object_meta_key_t meta_key_fdb = { .objecttype = SAI_OBJECT_TYPE_FDB_ENTRY, .objectkey = { .key = { .fdb_entry = fdb_entry } } };
-    std::string fdb_key = sai_serialize_object_meta_key(meta_key_fdb);
-    ObjectAttrHash[fdb_key] = { };
+    create_object(meta_key_fdb);
 
     attr.id = SAI_FDB_ENTRY_ATTR_TYPE;
     attr.value.s32 = SAI_FDB_ENTRY_TYPE_STATIC;
@@ -1151,8 +1150,7 @@ void test_neighbor_entry_create()
     sai_object_id_t rif = create_dummy_object_id(SAI_OBJECT_TYPE_ROUTER_INTERFACE,switch_id);
     object_reference_insert(rif);
     sai_object_meta_key_t meta_key_rif = { .objecttype = SAI_OBJECT_TYPE_ROUTER_INTERFACE, .objectkey = { .key = { .object_id = rif } } };
-    std::string rif_key = sai_serialize_object_meta_key(meta_key_rif);
-    ObjectAttrHash[rif_key] = { };
+    create_object(meta_key_rif);
 
     neighbor_entry.ip_address.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     neighbor_entry.ip_address.addr.ip4 = htonl(0x0a00000f);
@@ -1254,8 +1252,7 @@ void test_neighbor_entry_remove()
     sai_object_id_t rif = create_dummy_object_id(SAI_OBJECT_TYPE_ROUTER_INTERFACE,switch_id);
     object_reference_insert(rif);
     sai_object_meta_key_t meta_key_rif = { .objecttype = SAI_OBJECT_TYPE_ROUTER_INTERFACE, .objectkey = { .key = { .object_id = rif } } };
-    std::string rif_key = sai_serialize_object_meta_key(meta_key_rif);
-    ObjectAttrHash[rif_key] = { };
+    create_object(meta_key_rif);
 
     neighbor_entry.ip_address.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     neighbor_entry.ip_address.addr.ip4 = htonl(0x0a00000f);
@@ -1304,15 +1301,13 @@ void test_neighbor_entry_remove()
 
     sai_object_meta_key_t meta = { .objecttype = SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, .objectkey = { .key = { .neighbor_entry = neighbor_entry } } };
 
-    std::string key = sai_serialize_object_meta_key(meta);
-
-    META_ASSERT_TRUE(object_exists(key));
+    META_ASSERT_TRUE(object_exists(meta));
 
     SWSS_LOG_NOTICE("success");
     status = meta_sai_remove_neighbor_entry(&neighbor_entry, &dummy_success_sai_remove_neighbor_entry);
     META_ASSERT_SUCCESS(status);
 
-    META_ASSERT_TRUE(!object_exists(key));
+    META_ASSERT_TRUE(!object_exists(meta));
 }
 
 void test_neighbor_entry_set()
@@ -1346,8 +1341,7 @@ void test_neighbor_entry_set()
     sai_object_id_t rif = create_dummy_object_id(SAI_OBJECT_TYPE_ROUTER_INTERFACE,switch_id);
     object_reference_insert(rif);
     sai_object_meta_key_t meta_key_rif = { .objecttype = SAI_OBJECT_TYPE_ROUTER_INTERFACE, .objectkey = { .key = { .object_id = rif } } };
-    std::string rif_key = sai_serialize_object_meta_key(meta_key_rif);
-    ObjectAttrHash[rif_key] = { };
+    create_object(meta_key_rif);
 
     neighbor_entry.ip_address.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     neighbor_entry.ip_address.addr.ip4 = htonl(0x0a00000f);
@@ -1427,8 +1421,7 @@ void test_neighbor_entry_get()
     sai_object_id_t rif = create_dummy_object_id(SAI_OBJECT_TYPE_ROUTER_INTERFACE,switch_id);
     object_reference_insert(rif);
     sai_object_meta_key_t meta_key_rif = { .objecttype = SAI_OBJECT_TYPE_ROUTER_INTERFACE, .objectkey = { .key = { .object_id = rif } } };
-    std::string rif_key = sai_serialize_object_meta_key(meta_key_rif);
-    ObjectAttrHash[rif_key] = { };
+    create_object(meta_key_rif);
 
     neighbor_entry.ip_address.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     neighbor_entry.ip_address.addr.ip4 = htonl(0x0a00000f);
@@ -1528,8 +1521,7 @@ void test_neighbor_entry_flow()
     sai_object_id_t rif = create_dummy_object_id(SAI_OBJECT_TYPE_ROUTER_INTERFACE,switch_id);
     object_reference_insert(rif);
     sai_object_meta_key_t meta_key_rif = { .objecttype = SAI_OBJECT_TYPE_ROUTER_INTERFACE, .objectkey = { .key = { .object_id = rif } } };
-    std::string rif_key = sai_serialize_object_meta_key(meta_key_rif);
-    ObjectAttrHash[rif_key] = { };
+    create_object(meta_key_rif);
 
     neighbor_entry.ip_address.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     neighbor_entry.ip_address.addr.ip4 = htonl(0x0a00000f);
@@ -1603,8 +1595,7 @@ void test_vlan_create()
     sai_object_id_t stp = create_dummy_object_id(SAI_OBJECT_TYPE_STP,switch_id);
     object_reference_insert(stp);
     sai_object_meta_key_t meta_key_stp = { .objecttype = SAI_OBJECT_TYPE_STP, .objectkey = { .key = { .object_id = stp } } };
-    std::string stp_key = sai_serialize_object_meta_key(meta_key_stp);
-    ObjectAttrHash[stp_key] = { };
+    create_object(meta_key_stp);
 
     SWSS_LOG_NOTICE("create tests");
 
@@ -1653,8 +1644,7 @@ void test_vlan_remove()
     sai_object_id_t stp = create_dummy_object_id(SAI_OBJECT_TYPE_STP,switch_id);
     object_reference_insert(stp);
     sai_object_meta_key_t meta_key_stp = { .objecttype = SAI_OBJECT_TYPE_STP, .objectkey = { .key = { .object_id = stp } } };
-    std::string stp_key = sai_serialize_object_meta_key(meta_key_stp);
-    ObjectAttrHash[stp_key] = { };
+    create_object(meta_key_stp);
 
     SWSS_LOG_NOTICE("create");
 
@@ -1716,8 +1706,7 @@ void test_vlan_set()
     sai_object_id_t stp = create_dummy_object_id(SAI_OBJECT_TYPE_STP,switch_id);
     object_reference_insert(stp);
     sai_object_meta_key_t meta_key_stp = { .objecttype = SAI_OBJECT_TYPE_STP, .objectkey = { .key = { .object_id = stp } } };
-    std::string stp_key = sai_serialize_object_meta_key(meta_key_stp);
-    ObjectAttrHash[stp_key] = { };
+    create_object(meta_key_stp);
 
     SWSS_LOG_NOTICE("create");
 
@@ -1825,8 +1814,7 @@ void test_vlan_get()
     sai_object_id_t stp = create_dummy_object_id(SAI_OBJECT_TYPE_STP,switch_id);
     object_reference_insert(stp);
     sai_object_meta_key_t meta_key_stp = { .objecttype = SAI_OBJECT_TYPE_STP, .objectkey = { .key = { .object_id = stp } } };
-    std::string stp_key = sai_serialize_object_meta_key(meta_key_stp);
-    ObjectAttrHash[stp_key] = { };
+    create_object(meta_key_stp);
 
     SWSS_LOG_NOTICE("create");
 
@@ -1954,8 +1942,7 @@ void test_vlan_flow()
     sai_object_id_t stp = create_dummy_object_id(SAI_OBJECT_TYPE_STP,switch_id);
     object_reference_insert(stp);
     sai_object_meta_key_t meta_key_stp = { .objecttype = SAI_OBJECT_TYPE_STP, .objectkey = { .key = { .object_id = stp } } };
-    std::string stp_key = sai_serialize_object_meta_key(meta_key_stp);
-    ObjectAttrHash[stp_key] = { };
+    create_object(meta_key_stp);
 
     SWSS_LOG_NOTICE("create");
 
@@ -2080,14 +2067,12 @@ void test_route_entry_create()
     sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER,switch_id);
     object_reference_insert(vr);
     sai_object_meta_key_t meta_key_vr = { .objecttype = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .objectkey = { .key = { .object_id = vr } } };
-    std::string vr_key = sai_serialize_object_meta_key(meta_key_vr);
-    ObjectAttrHash[vr_key] = { };
+    create_object(meta_key_vr);
 
     sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP,switch_id);
     object_reference_insert(hop);
     sai_object_meta_key_t meta_key_hop = { .objecttype = SAI_OBJECT_TYPE_NEXT_HOP, .objectkey = { .key = { .object_id = hop } } };
-    std::string hop_key = sai_serialize_object_meta_key(meta_key_hop);
-    ObjectAttrHash[hop_key] = { };
+    create_object(meta_key_hop);
 
     route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     route_entry.destination.addr.ip4 = htonl(0x0a00000f);
@@ -2212,14 +2197,12 @@ void test_route_entry_remove()
     sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER,switch_id);
     object_reference_insert(vr);
     sai_object_meta_key_t meta_key_vr = { .objecttype = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .objectkey = { .key = { .object_id = vr } } };
-    std::string vr_key = sai_serialize_object_meta_key(meta_key_vr);
-    ObjectAttrHash[vr_key] = { };
+    create_object(meta_key_vr);
 
     sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP,switch_id);
     object_reference_insert(hop);
     sai_object_meta_key_t meta_key_hop = { .objecttype = SAI_OBJECT_TYPE_NEXT_HOP, .objectkey = { .key = { .object_id = hop } } };
-    std::string hop_key = sai_serialize_object_meta_key(meta_key_hop);
-    ObjectAttrHash[hop_key] = { };
+    create_object(meta_key_hop);
 
     route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     route_entry.destination.addr.ip4 = htonl(0x0a00000f);
@@ -2284,15 +2267,13 @@ void test_route_entry_remove()
 
     sai_object_meta_key_t meta = { .objecttype = SAI_OBJECT_TYPE_ROUTE_ENTRY, .objectkey = { .key = { .route_entry = route_entry } } };
 
-    std::string key = sai_serialize_object_meta_key(meta);
-
-    META_ASSERT_TRUE(object_exists(key));
+    META_ASSERT_TRUE(object_exists(meta));
 
     SWSS_LOG_NOTICE("success");
     status = meta_sai_remove_route_entry(&route_entry, &dummy_success_sai_remove_route_entry);
     META_ASSERT_SUCCESS(status);
 
-    META_ASSERT_TRUE(!object_exists(key));
+    META_ASSERT_TRUE(!object_exists(meta));
 
     route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     route_entry.destination.addr.ip4 = htonl(0x0a00000f);
@@ -2320,14 +2301,12 @@ void test_route_entry_set()
     sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER,switch_id);
     object_reference_insert(vr);
     sai_object_meta_key_t meta_key_vr = { .objecttype = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .objectkey = { .key = { .object_id = vr } } };
-    std::string vr_key = sai_serialize_object_meta_key(meta_key_vr);
-    ObjectAttrHash[vr_key] = { };
+    create_object(meta_key_vr);
 
     sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP,switch_id);
     object_reference_insert(hop);
     sai_object_meta_key_t meta_key_hop = { .objecttype = SAI_OBJECT_TYPE_NEXT_HOP, .objectkey = { .key = { .object_id = hop } } };
-    std::string hop_key = sai_serialize_object_meta_key(meta_key_hop);
-    ObjectAttrHash[hop_key] = { };
+    create_object(meta_key_hop);
 
     route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     route_entry.destination.addr.ip4 = htonl(0x0a00000f);
@@ -2427,14 +2406,12 @@ void test_route_entry_get()
     sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER,switch_id);
     object_reference_insert(vr);
     sai_object_meta_key_t meta_key_vr = { .objecttype = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .objectkey = { .key = { .object_id = vr } } };
-    std::string vr_key = sai_serialize_object_meta_key(meta_key_vr);
-    ObjectAttrHash[vr_key] = { };
+    create_object(meta_key_vr);
 
     sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP,switch_id);
     object_reference_insert(hop);
     sai_object_meta_key_t meta_key_hop = { .objecttype = SAI_OBJECT_TYPE_NEXT_HOP, .objectkey = { .key = { .object_id = hop } } };
-    std::string hop_key = sai_serialize_object_meta_key(meta_key_hop);
-    ObjectAttrHash[hop_key] = { };
+    create_object(meta_key_hop);
 
     route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     route_entry.destination.addr.ip4 = htonl(0x0a00000f);
@@ -2531,14 +2508,12 @@ void test_route_entry_flow()
     sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER,switch_id);
     object_reference_insert(vr);
     sai_object_meta_key_t meta_key_vr = { .objecttype = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .objectkey = { .key = { .object_id = vr } } };
-    std::string vr_key = sai_serialize_object_meta_key(meta_key_vr);
-    ObjectAttrHash[vr_key] = { };
+    create_object(meta_key_vr);
 
     sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP,switch_id);
     object_reference_insert(hop);
     sai_object_meta_key_t meta_key_hop = { .objecttype = SAI_OBJECT_TYPE_NEXT_HOP, .objectkey = { .key = { .object_id = hop } } };
-    std::string hop_key = sai_serialize_object_meta_key(meta_key_hop);
-    ObjectAttrHash[hop_key] = { };
+    create_object(meta_key_hop);
 
     route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     route_entry.destination.addr.ip4 = htonl(0x0a00000f);
@@ -2668,6 +2643,317 @@ void test_route_entry_flow()
 
 // SERIALIZATION TYPES TESTS
 
+void test_validation_level()
+{
+    SWSS_LOG_ENTER();
+
+    clear_local();
+    meta_init_db();
+
+    sai_status_t    status;
+    sai_attribute_t attr;
+    sai_object_id_t switch_id = create_switch();
+
+    sai_route_entry_t route_entry;
+
+    // TODO we should use create
+    sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER,switch_id);
+    object_reference_insert(vr);
+    sai_object_meta_key_t meta_key_vr = { .objecttype = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .objectkey = { .key = { .object_id = vr } } };
+    create_object(meta_key_vr);
+
+    sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP,switch_id);
+    object_reference_insert(hop);
+    sai_object_meta_key_t meta_key_hop = { .objecttype = SAI_OBJECT_TYPE_NEXT_HOP, .objectkey = { .key = { .object_id = hop } } };
+    create_object(meta_key_hop);
+
+    route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+    route_entry.destination.addr.ip4 = htonl(0x0a00000f);
+    route_entry.destination.mask.ip4 = htonl(0xffffff00);
+    route_entry.vr_id = vr;
+    route_entry.switch_id = switch_id;
+
+    attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+    attr.value.oid = hop;
+
+    status = meta_sai_create_route_entry(&route_entry, 1, &attr, &dummy_success_sai_create_route_entry);
+    META_ASSERT_SUCCESS(status);
+
+    SWSS_LOG_NOTICE("invalid levels");
+    status = meta_set_validation_level(SAI_OBJECT_TYPE_ROUTE_ENTRY, SAI_META_VALIDATION_LEVEL_SAMPLING, 0);
+    META_ASSERT_FAIL(status);
+
+    status = meta_set_validation_level(SAI_OBJECT_TYPE_ROUTE_ENTRY, (sai_meta_validation_level_t)0x100, 0);
+    META_ASSERT_FAIL(status);
+
+    SWSS_LOG_NOTICE("bookkeeping");
+    status = meta_set_validation_level(SAI_OBJECT_TYPE_ROUTE_ENTRY, SAI_META_VALIDATION_LEVEL_BOOKKEEPING, 0);
+    META_ASSERT_SUCCESS(status);
+
+    attr.id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
+    attr.value.s32 = 0x100;
+    status = meta_sai_set_route_entry(&route_entry, &attr, &dummy_success_sai_set_route_entry);
+    META_ASSERT_SUCCESS(status);
+
+    SWSS_LOG_NOTICE("unknown next hop is still rejected");
+    attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+    attr.value.oid = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP,switch_id);
+    status = meta_sai_set_route_entry(&route_entry, &attr, &dummy_success_sai_set_route_entry);
+    META_ASSERT_FAIL(status);
+
+    SWSS_LOG_NOTICE("get without attributes is still rejected");
+    status = meta_sai_get_route_entry(&route_entry, 0, &attr, &dummy_success_sai_get_route_entry);
+    META_ASSERT_FAIL(status);
+
+    SWSS_LOG_NOTICE("set of read only attribute is still rejected");
+    status = meta_set_validation_level(SAI_OBJECT_TYPE_SWITCH, SAI_META_VALIDATION_LEVEL_BOOKKEEPING, 0);
+    META_ASSERT_SUCCESS(status);
+
+    attr.id = SAI_SWITCH_ATTR_PORT_NUMBER;
+    attr.value.u32 = 0;
+    status = meta_sai_set_oid(SAI_OBJECT_TYPE_SWITCH, switch_id, &attr, &dummy_success_sai_set_oid);
+    META_ASSERT_FAIL(status);
+
+    SWSS_LOG_NOTICE("sampling");
+    status = meta_set_validation_level(SAI_OBJECT_TYPE_ROUTE_ENTRY, SAI_META_VALIDATION_LEVEL_SAMPLING, 2);
+    META_ASSERT_SUCCESS(status);
+
+    attr.id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
+    attr.value.s32 = 0x100;
+    status = meta_sai_set_route_entry(&route_entry, &attr, &dummy_success_sai_set_route_entry);
+    META_ASSERT_FAIL(status);
+
+    status = meta_sai_set_route_entry(&route_entry, &attr, &dummy_success_sai_set_route_entry);
+    META_ASSERT_SUCCESS(status);
+
+    SWSS_LOG_NOTICE("bookkeeping rejects null list");
+    status = meta_set_validation_level(SAI_OBJECT_TYPE_HASH, SAI_META_VALIDATION_LEVEL_BOOKKEEPING, 0);
+    META_ASSERT_SUCCESS(status);
+
+    sai_object_id_t hash;
+
+    attr.id = SAI_HASH_ATTR_NATIVE_HASH_FIELD_LIST;
+    attr.value.s32list.count = 2;
+    attr.value.s32list.list = NULL;
+
+    status = meta_sai_create_oid(SAI_OBJECT_TYPE_HASH, &hash, switch_id, 1, &attr, &dummy_success_sai_create_oid);
+    META_ASSERT_FAIL(status);
+
+    SWSS_LOG_NOTICE("full");
+    status = meta_set_validation_level(SAI_OBJECT_TYPE_NULL, SAI_META_VALIDATION_LEVEL_FULL, 0);
+    META_ASSERT_SUCCESS(status);
+
+    attr.id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
+    attr.value.s32 = 0x100;
+    status = meta_sai_set_route_entry(&route_entry, &attr, &dummy_success_sai_set_route_entry);
+    META_ASSERT_FAIL(status);
+}
+
+void test_bulk_route_entry_create()
+{
+    SWSS_LOG_ENTER();
+
+    clear_local();
+    meta_init_db();
+
+    sai_object_id_t switch_id = create_switch();
+
+    // TODO we should use create
+    sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER,switch_id);
+    object_reference_insert(vr);
+    sai_object_meta_key_t meta_key_vr = { .objecttype = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .objectkey = { .key = { .object_id = vr } } };
+    create_object(meta_key_vr);
+
+    sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP,switch_id);
+    object_reference_insert(hop);
+    sai_object_meta_key_t meta_key_hop = { .objecttype = SAI_OBJECT_TYPE_NEXT_HOP, .objectkey = { .key = { .object_id = hop } } };
+    create_object(meta_key_hop);
+
+    // large enough to be validated in parallel
+
+    meta_set_worker_pool(std::make_shared<WorkerPool>(4));
+
+    const uint32_t count = 4096;
+
+    std::vector<sai_route_entry_t> routes(count);
+    std::vector<sai_attribute_t> attrs(count);
+    std::vector<const sai_attribute_t*> attr_list(count);
+    std::vector<uint32_t> attr_count(count, 1);
+    std::vector<sai_status_t> statuses(count, SAI_STATUS_NOT_EXECUTED);
+
+    for (uint32_t idx = 0; idx < count; ++idx)
+    {
+        routes[idx].destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+        routes[idx].destination.addr.ip4 = htonl(0x0a000000 | (idx << 8));
+        routes[idx].destination.mask.ip4 = htonl(0xffffff00);
+        routes[idx].vr_id = vr;
+        routes[idx].switch_id = switch_id;
+
+        attrs[idx].id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+        attrs[idx].value.oid = hop;
+
+        attr_list[idx] = &attrs[idx];
+    }
+
+    SWSS_LOG_NOTICE("duplicate route and non existing next hop");
+
+    routes[count - 1] = routes[10];
+
+    attrs[20].value.oid = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP,switch_id);
+
+    meta_sai_bulk_create_route_entry(count, routes.data(), attr_count.data(), attr_list.data(),
+            SAI_BULK_OP_TYPE_INGORE_ERROR, statuses.data(), &dummy_success_sai_create_route_entry);
+
+    for (uint32_t idx = 0; idx < count; ++idx)
+    {
+        if (idx == 20)
+        {
+            META_ASSERT_FAIL(statuses[idx]);
+        }
+        else if (idx == count - 1)
+        {
+            META_ASSERT_TRUE(statuses[idx] == SAI_STATUS_ITEM_ALREADY_EXISTS);
+        }
+        else
+        {
+            META_ASSERT_SUCCESS(statuses[idx]);
+        }
+    }
+
+    META_ASSERT_TRUE(object_reference_count(hop) == (int32_t)count - 2);
+
+    SWSS_LOG_NOTICE("stop on error");
+
+    for (uint32_t idx = 0; idx < count; ++idx)
+    {
+        routes[idx].destination.addr.ip4 = htonl(0x0b000000 | (idx << 8));
+    }
+
+    std::fill(statuses.begin(), statuses.end(), SAI_STATUS_NOT_EXECUTED);
+
+    meta_sai_bulk_create_route_entry(count, routes.data(), attr_count.data(), attr_list.data(),
+            SAI_BULK_OP_TYPE_STOP_ON_ERROR, statuses.data(), &dummy_success_sai_create_route_entry);
+
+    for (uint32_t idx = 0; idx < count; ++idx)
+    {
+        if (idx < 20)
+        {
+            META_ASSERT_SUCCESS(statuses[idx]);
+        }
+        else if (idx == 20)
+        {
+            META_ASSERT_FAIL(statuses[idx]);
+        }
+        else
+        {
+            META_ASSERT_TRUE(statuses[idx] == SAI_STATUS_NOT_EXECUTED);
+        }
+    }
+
+    META_ASSERT_TRUE(object_reference_count(hop) == (int32_t)count - 2 + 20);
+
+    meta_set_worker_pool(nullptr);
+}
+
+void test_route_entry_trie()
+{
+    SWSS_LOG_ENTER();
+
+    clear_local();
+    meta_init_db();
+
+    sai_status_t    status;
+    sai_attribute_t attr;
+    sai_object_id_t switch_id = create_switch();
+
+    // TODO we should use create
+    sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER,switch_id);
+    object_reference_insert(vr);
+    sai_object_meta_key_t meta_key_vr = { .objecttype = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .objectkey = { .key = { .object_id = vr } } };
+    create_object(meta_key_vr);
+
+    sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP,switch_id);
+    object_reference_insert(hop);
+    sai_object_meta_key_t meta_key_hop = { .objecttype = SAI_OBJECT_TYPE_NEXT_HOP, .objectkey = { .key = { .object_id = hop } } };
+    create_object(meta_key_hop);
+
+    attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+    attr.value.oid = hop;
+
+    sai_route_entry_t route_entry;
+
+    route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+    route_entry.vr_id = vr;
+    route_entry.switch_id = switch_id;
+
+    SWSS_LOG_NOTICE("non contiguous ipv4 mask");
+    route_entry.destination.addr.ip4 = htonl(0x0a000000);
+    route_entry.destination.mask.ip4 = htonl(0xff00ff00);
+    status = meta_sai_create_route_entry(&route_entry, 1, &attr, &dummy_success_sai_create_route_entry);
+    META_ASSERT_FAIL(status);
+
+    // 10.0.0.0/8, 10.1.0.0/16, 10.1.2.0/24, 11.0.0.0/8
+
+    uint32_t addrs[4] = { 0x0a000000, 0x0a010000, 0x0a010200, 0x0b000000 };
+    uint32_t masks[4] = { 0xff000000, 0xffff0000, 0xffffff00, 0xff000000 };
+
+    for (int i = 0; i < 4; i++)
+    {
+        route_entry.destination.addr.ip4 = htonl(addrs[i]);
+        route_entry.destination.mask.ip4 = htonl(masks[i]);
+
+        status = meta_sai_create_route_entry(&route_entry, 1, &attr, &dummy_success_sai_create_route_entry);
+        META_ASSERT_SUCCESS(status);
+    }
+
+    uint32_t count = 0;
+    sai_route_entry_t list[4];
+
+    SWSS_LOG_NOTICE("all routes");
+    status = meta_get_route_entries(vr, NULL, &count, list);
+    META_ASSERT_TRUE(status == SAI_STATUS_BUFFER_OVERFLOW);
+    META_ASSERT_TRUE(count == 4);
+
+    status = meta_get_route_entries(vr, NULL, &count, list);
+    META_ASSERT_SUCCESS(status);
+
+    SWSS_LOG_NOTICE("routes under 10.0.0.0/8");
+    sai_ip_prefix_t prefix;
+    prefix.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+    prefix.addr.ip4 = htonl(0x0a000000);
+    prefix.mask.ip4 = htonl(0xff000000);
+
+    status = meta_get_route_entries(vr, &prefix, &count, list);
+    META_ASSERT_SUCCESS(status);
+    META_ASSERT_TRUE(count == 3);
+
+    SWSS_LOG_NOTICE("longest prefix match");
+    sai_ip_address_t address;
+    address.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+    address.addr.ip4 = htonl(0x0a0102ff);
+
+    status = meta_lookup_route_entry(vr, &address, &route_entry);
+    META_ASSERT_SUCCESS(status);
+    META_ASSERT_TRUE(route_entry.destination.mask.ip4 == htonl(0xffffff00));
+
+    status = meta_sai_remove_route_entry(&route_entry, &dummy_success_sai_remove_route_entry);
+    META_ASSERT_SUCCESS(status);
+
+    status = meta_lookup_route_entry(vr, &address, &route_entry);
+    META_ASSERT_SUCCESS(status);
+    META_ASSERT_TRUE(route_entry.destination.mask.ip4 == htonl(0xffff0000));
+
+    address.addr.ip4 = htonl(0x0c000001);
+    status = meta_lookup_route_entry(vr, &address, &route_entry);
+    META_ASSERT_TRUE(status == SAI_STATUS_ITEM_NOT_FOUND);
+
+    SWSS_LOG_NOTICE("other virtual router");
+    count = 4;
+    status = meta_get_route_entries(hop, NULL, &count, list);
+    META_ASSERT_SUCCESS(status);
+    META_ASSERT_TRUE(count == 0);
+}
+
 void test_serialization_type_vlan_list()
 {
     SWSS_LOG_ENTER();
@@ -2765,8 +3051,7 @@ void test_serialization_type_char()
     sai_object_id_t rif = create_dummy_object_id(SAI_OBJECT_TYPE_PORT,switch_id);
     object_reference_insert(rif);
     sai_object_meta_key_t meta_key_rif = { .objecttype = SAI_OBJECT_TYPE_ROUTER_INTERFACE, .objectkey = { .key = { .object_id = rif } } };
-    std::string rif_key = sai_serialize_object_meta_key(meta_key_rif);
-    ObjectAttrHash[rif_key] = { };
+    create_object(meta_key_rif);
 
     sai_attribute_t attr, attr2, attr3;
 
@@ -2958,8 +3243,7 @@ sai_object_id_t insert_dummy_object(
     sai_object_id_t oid = create_dummy_object_id(ot,switch_id);
     object_reference_insert(oid);
     sai_object_meta_key_t meta_key_oid = { .objecttype = ot, .objectkey = { .key = { .object_id = oid } } };
-    std::string oid_key = sai_serialize_object_meta_key(meta_key_oid);
-    ObjectAttrHash[oid_key] = { };
+    create_object(meta_key_oid);
 
     return oid;
 }
@@ -3548,6 +3832,54 @@ void test_serialize_enum()
     }
 }
 
+void test_deserialize_attr_id()
+{
+    SWSS_LOG_ENTER();
+
+    clear_local();
+    meta_init_db();
+
+    // all attribute names and enum values must resolve through index
+
+    for (size_t ot = 0; ot < sai_metadata_attr_by_object_type_count; ++ot)
+    {
+        const sai_attr_metadata_t* const* list = sai_metadata_attr_by_object_type[ot];
+
+        for (size_t i = 0; list != NULL && list[i] != NULL; ++i)
+        {
+            const sai_attr_metadata_t* md = list[i];
+            const sai_attr_metadata_t* meta = NULL;
+
+            sai_deserialize_attr_id(md->attridname, &meta);
+
+            META_ASSERT_TRUE(meta == md);
+
+            const sai_enum_metadata_t* em = md->enummetadata;
+
+            for (size_t j = 0; em != NULL && j < em->valuescount; ++j)
+            {
+                int32_t value;
+
+                sai_deserialize_enum(em->valuesnames[j], em, value);
+
+                META_ASSERT_TRUE(value == em->values[j]);
+            }
+        }
+    }
+
+    try
+    {
+        const sai_attr_metadata_t* meta = NULL;
+
+        sai_deserialize_attr_id("SAI_SWITCH_ATTR_FOO", &meta);
+        ASSERT_FAIL("invalid attr id deserialize failed to throw exception");
+    }
+    catch (const std::runtime_error& e)
+    {
+        // ok
+    }
+}
+
 void test_serialize_mac()
 {
     SWSS_LOG_ENTER();
@@ -4011,6 +4343,53 @@ void test_serialize_qos_map()
     ASSERT_TRUE(l.value.color, SAI_PACKET_COLOR_GREEN);
 }
 
+void test_serialize_append()
+{
+    SWSS_LOG_ENTER();
+
+    clear_local();
+    meta_init_db();
+
+    sai_attribute_t attr;
+    const sai_attr_metadata_t* meta;
+
+    sai_object_id_t list[2] = { 0x1234, 0 };
+
+    attr.id = SAI_PORT_ATTR_QOS_INGRESS_BUFFER_PROFILE_LIST;
+    attr.value.objlist.count = 2;
+    attr.value.objlist.list = list;
+
+    meta = sai_metadata_get_attr_metadata(SAI_OBJECT_TYPE_PORT, attr.id);
+
+    std::string s = "prefix|";
+
+    sai_serialize_append_attr_value(s, *meta, attr);
+
+    ASSERT_TRUE(s, "prefix|2:oid:0x1234,oid:0x0");
+
+    ASSERT_TRUE(sai_serialize_attr_value(*meta, attr), "2:oid:0x1234,oid:0x0");
+
+    sai_mac_t mac = { 0x00, 0x1a, 0xff, 0x0b, 0xc2, 0x10 };
+
+    s.clear();
+
+    sai_serialize_append_mac(s, mac);
+
+    ASSERT_TRUE(s, "00:1A:FF:0B:C2:10");
+
+    sai_ip_prefix_t prefix;
+
+    prefix.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+    prefix.addr.ip4 = htonl(0x0a00fe01);
+    prefix.mask.ip4 = htonl(0xfffff000);
+
+    s = "dest:";
+
+    sai_serialize_append_ip_prefix(s, prefix);
+
+    ASSERT_TRUE(s, "dest:10.0.254.1/20");
+}
+
 void test_serialize_tunnel_map()
 {
     SWSS_LOG_ENTER();
@@ -4150,6 +4529,47 @@ void test_numbers()
     ASSERT_TRUE(u,   0x12345678);
 }
 
+void test_slab_pool_keeps_slab()
+{
+    SWSS_LOG_ENTER();
+
+    SaiSlabPool pool(sizeof(uint64_t));
+
+    std::vector<void*> chunks;
+
+    for (size_t idx = 0; idx < 2 * SAI_SLAB_CHUNKS_PER_SLAB; ++idx)
+    {
+        chunks.push_back(pool.allocate());
+    }
+
+    // first slab is filled first
+
+    std::set<void*> firstSlab(chunks.begin(), chunks.begin() + SAI_SLAB_CHUNKS_PER_SLAB);
+
+    for (void* chunk: chunks)
+    {
+        pool.deallocate(chunk);
+    }
+
+    // after all chunks are returned, first slab is kept and reused
+
+    chunks.clear();
+
+    for (size_t idx = 0; idx < SAI_SLAB_CHUNKS_PER_SLAB; ++idx)
+    {
+        void* chunk = pool.allocate();
+
+        META_ASSERT_TRUE(firstSlab.find(chunk) != firstSlab.end());
+
+        chunks.push_back(chunk);
+    }
+
+    for (void* chunk: chunks)
+    {
+        pool.deallocate(chunk);
+    }
+}
+
 int main()
 {
     swss::Logger::getInstance().setMinPrio(swss::Logger::SWSS_DEBUG);
@@ -4162,6 +4582,7 @@ int main()
     test_serialize_chardata();
     test_serialize_uint64();
     test_serialize_enum();
+    test_deserialize_attr_id();
     test_serialize_mac();
     test_serialize_ip_address();
     test_serialize_uint32_list();
@@ -4170,6 +4591,7 @@ int main()
     test_serialize_oid_list();
     test_serialize_acl_action();
     test_serialize_qos_map();
+    test_serialize_append();
     test_serialize_tunnel_map();
 
     // attributes tests
@@ -4201,6 +4623,11 @@ int main()
     test_route_entry_get();
     test_route_entry_flow();
 
+    test_validation_level();
+    test_bulk_route_entry_create();
+    test_route_entry_trie();
+    test_slab_pool_keeps_slab();
+
     test_serialization_type_vlan_list();
     test_serialization_type_bool();
     test_serialization_type_char();
@@ -0,0 +1,241 @@
+#include <string>
+#include <iostream>
+#include <sstream>
+
+extern "C" {
+#include <sai.h>
+#include "saimetadata.h"
+}
+
+#include "swss/logger.h"
+#include "meta/saiserialize.h"
+#include "syncd_counter_ring.h"
+
+#include <getopt.h>
+#include <unistd.h>
+
+struct CmdOptions
+{
+    std::string file;
+    uint64_t seconds;
+    bool follow;
+    bool columnsOnly;
+};
+
+CmdOptions g_cmdOptions;
+
+void printUsage()
+{
+    SWSS_LOG_ENTER();
+
+    std::cout << "Usage: saicounterring [-f file] [-s seconds] [-F] [-c] [-h]" << std::endl;
+    std::cout << "    -f --file file:" << std::endl;
+    std::cout << "        Counter ring file (default " << SAI_COUNTER_RING_DEFAULT_FILE << ")" << std::endl;
+    std::cout << "    -s --seconds seconds:" << std::endl;
+    std::cout << "        Dump history of last N seconds (default 1)" << std::endl;
+    std::cout << "    -F --follow:" << std::endl;
+    std::cout << "        Keep printing new samples as they are published" << std::endl;
+    std::cout << "    -c --columns:" << std::endl;
+    std::cout << "        Print only column layout" << std::endl;
+    std::cout << "    -h --help:" << std::endl;
+    std::cout << "        Print out this message" << std::endl;
+}
+
+CmdOptions handleCmdLine(int argc, char **argv)
+{
+    SWSS_LOG_ENTER();
+
+    CmdOptions options;
+
+    options.file = SAI_COUNTER_RING_DEFAULT_FILE;
+    options.seconds = 1;
+    options.follow = false;
+    options.columnsOnly = false;
+
+    const char* const optstring = "f:s:Fch";
+
+    while(true)
+    {
+        static struct option long_options[] =
+        {
+            { "file",           required_argument, 0, 'f' },
+            { "seconds",        required_argument, 0, 's' },
+            { "follow",         no_argument,       0, 'F' },
+            { "columns",        no_argument,       0, 'c' },
+            { "help",           no_argument,       0, 'h' },
+            { 0,                0,                 0,  0  }
+        };
+
+        int option_index = 0;
+
+        int c = getopt_long(argc, argv, optstring, long_options, &option_index);
+
+        if (c == -1)
+        {
+            break;
+        }
+
+        switch (c)
+        {
+            case 'f':
+                options.file = std::string(optarg);
+                break;
+
+            case 's':
+                options.seconds = std::stoull(std::string(optarg));
+                break;
+
+            case 'F':
+                options.follow = true;
+                break;
+
+            case 'c':
+                options.columnsOnly = true;
+                break;
+
+            case 'h':
+                printUsage();
+                exit(EXIT_SUCCESS);
+
+            case '?':
+                SWSS_LOG_WARN("unknown option %c", optopt);
+                printUsage();
+                exit(EXIT_FAILURE);
+
+            default:
+                SWSS_LOG_ERROR("getopt_long failure");
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    return options;
+}
+
+std::string serializeCounterName(
+        _In_ const sai_counter_ring_column_t &column)
+{
+    SWSS_LOG_ENTER();
+
+    const sai_enum_metadata_t *meta = NULL;
+
+    switch (column.objectType)
+    {
+        case SAI_OBJECT_TYPE_PORT:
+            meta = &sai_metadata_enum_sai_port_stat_t;
+            break;
+
+        case SAI_OBJECT_TYPE_QUEUE:
+            meta = &sai_metadata_enum_sai_queue_stat_t;
+            break;
+
+        case SAI_OBJECT_TYPE_INGRESS_PRIORITY_GROUP:
+            meta = &sai_metadata_enum_sai_ingress_priority_group_stat_t;
+            break;
+
+        case SAI_OBJECT_TYPE_BUFFER_POOL:
+            meta = &sai_metadata_enum_sai_buffer_pool_stat_t;
+            break;
+
+        default:
+            break;
+    }
+
+    return sai_serialize_enum(column.counterId, meta);
+}
+
+void printSample(
+        _In_ const std::vector<sai_counter_ring_column_t> &columns,
+        _In_ const CounterRingReader::Sample &sample)
+{
+    SWSS_LOG_ENTER();
+
+    for (size_t idx = 0; idx < columns.size(); idx++)
+    {
+        const auto &column = columns[idx];
+
+        if (column.vid == SAI_NULL_OBJECT_ID || sample.values[idx] == SAI_COUNTER_RING_NO_VALUE)
+        {
+            continue;
+        }
+
+        std::cout << sample.timestamp << " "
+            << sai_serialize_object_id(column.vid) << " "
+            << serializeCounterName(column) << " "
+            << sample.values[idx] << std::endl;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    swss::Logger::getInstance().setMinPrio(swss::Logger::SWSS_DEBUG);
+
+    SWSS_LOG_ENTER();
+
+    swss::Logger::getInstance().setMinPrio(swss::Logger::SWSS_NOTICE);
+
+    g_cmdOptions = handleCmdLine(argc, argv);
+
+    CounterRingReader reader;
+
+    if (!reader.open(g_cmdOptions.file))
+    {
+        std::cerr << "failed to open counter ring " << g_cmdOptions.file << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    auto columns = reader.getColumns();
+
+    if (g_cmdOptions.columnsOnly)
+    {
+        for (size_t idx = 0; idx < columns.size(); idx++)
+        {
+            if (columns[idx].vid == SAI_NULL_OBJECT_ID)
+            {
+                continue;
+            }
+
+            std::cout << idx << " "
+                << sai_serialize_object_id(columns[idx].vid) << " "
+                << serializeCounterName(columns[idx]) << std::endl;
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    uint64_t next = 0;
+
+    for (const auto &sample: reader.readHistory(g_cmdOptions.seconds * 1000))
+    {
+        printSample(columns, sample);
+
+        next = sample.index + 1;
+    }
+
+    while (g_cmdOptions.follow)
+    {
+        usleep(reader.getPollIntervalMsec() * 1000);
+
+        uint64_t writeIndex = reader.getWriteIndex();
+
+        if (next < writeIndex)
+        {
+            /*
+             * Layout could change when objects were added or removed.
+             */
+
+            columns = reader.getColumns();
+        }
+
+        for (; next < writeIndex; next++)
+        {
+            CounterRingReader::Sample sample;
+
+            if (reader.readSample(next, sample))
+            {
+                printSample(columns, sample);
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -779,12 +779,21 @@ void performNotifySyncd(const std::string& request, const std::string response)
         return;
     }
 
+    const std::string requestAction = r[2];
+
+    if (requestAction == SYNCD_DUMP_LATENCY ||
+            requestAction == SYNCD_DUMP_PROFILE ||
+            requestAction == SYNCD_LATENCY_TRACE_ENABLE ||
+            requestAction == SYNCD_LATENCY_TRACE_DISABLE)
+    {
+        SWSS_LOG_NOTICE("skipping diagnostic notify syncd request %s", requestAction.c_str());
+        return;
+    }
+
     // tell syncd that we are compiling new view
     sai_attribute_t attr;
     attr.id = SAI_REDIS_SWITCH_ATTR_NOTIFY_SYNCD;
 
-    const std::string requestAction = r[2];
-
     if (requestAction == SYNCD_INIT_VIEW)
     {
         attr.value.s32 = SAI_REDIS_NOTIFY_SYNCD_INIT_VIEW;
@@ -2,12 +2,19 @@
 #include "syncd_saiswitch.h"
 #include "sairedis.h"
 #include "syncd_flex_counter.h"
+#include "syncd_bulk_stats.h"
+#include "syncd_latency_trace.h"
+#include "syncd_sai_profiler.h"
+#include "syncd_timeline.h"
 #include "swss/tokenize.h"
 #include <limits.h>
 
 #include <iostream>
+#include <fstream>
 #include <map>
 
+#include <sys/stat.h>
+
 /**
  * @brief Global mutex for thread synchronization
  *
@@ -74,6 +81,17 @@ struct cmdOptions
     bool disableCountersThread;
     bool disableExitSleep;
     std::string profileMapFile;
+    std::string countersRingFile;
+    int flexCounterInterval;
+    int flexCounterConcurrency;
+    int flexCounterMaxInterval;
+    int fdbCoalesceWindow;
+    bool saiProfiler;
+    std::string saiProfilerTraceFile;
+    std::string timelineFile;
+    int discoveryConcurrency;
+    std::string discoverySnapshotFile;
+    bool lazyDiscovery;
 #ifdef SAITHRIFT
     bool run_rpc_server;
     std::string portMapFile;
@@ -418,9 +436,39 @@ sai_object_id_t translate_rid_to_vid(
 
     save_rid_and_vid_to_local(rid, vid);
 
+    /*
+     * Switch is not present in map yet when objects are spotted during switch
+     * constructor, but then they are already discovered.
+     */
+
+    auto sw = switches.find(switch_vid);
+
+    if (sw != switches.end() && sw->second != nullptr)
+    {
+        sw->second->onRidSpotted(rid);
+    }
+
     return vid;
 }
 
+void processSpottedRids()
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Objects spotted in lazy discovery mode are queried in small batches
+     * between events, so single GET or notification don't trigger discovery
+     * of many objects.
+     */
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+
+    for (auto &sw: switches)
+    {
+        sw.second->processSpottedRids(SAI_DISCOVERY_SPOTTED_BATCH);
+    }
+}
+
 void translate_list_rid_to_vid(
         _In_ sai_object_list_t &element,
         _In_ sai_object_id_t switch_id)
@@ -1436,6 +1484,33 @@ sai_status_t notifySyncd(
 {
     SWSS_LOG_ENTER();
 
+    if (op == SYNCD_DUMP_LATENCY)
+    {
+        LatencyTrace::dump();
+
+        sendNotifyResponse(SAI_STATUS_SUCCESS);
+
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if (op == SYNCD_LATENCY_TRACE_ENABLE || op == SYNCD_LATENCY_TRACE_DISABLE)
+    {
+        LatencyTrace::setEnabled(op == SYNCD_LATENCY_TRACE_ENABLE);
+
+        sendNotifyResponse(SAI_STATUS_SUCCESS);
+
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if (op == SYNCD_DUMP_PROFILE)
+    {
+        SaiProfiler::dump();
+
+        sendNotifyResponse(SAI_STATUS_SUCCESS);
+
+        return SAI_STATUS_SUCCESS;
+    }
+
     if (!options.useTempView)
     {
         SWSS_LOG_NOTICE("received %s, ignored since TEMP VIEW is not used, returning success", op.c_str());
@@ -2103,6 +2178,10 @@ sai_status_t processBulkEvent(
 
     sai_status_t status;
 
+    LatencyTrace::markDecoded();
+
+    LatencyTrace::markSaiStart();
+
     switch (object_type)
     {
         case SAI_OBJECT_TYPE_ROUTE_ENTRY:
@@ -2116,6 +2195,8 @@ sai_status_t processBulkEvent(
             exit_and_notify(EXIT_FAILURE);
     }
 
+    LatencyTrace::markSaiEnd();
+
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("failed to execute bulk api: %s",
@@ -2151,6 +2232,13 @@ sai_status_t processEvent(
         consumer.pop(kco);
     }
 
+    std::unique_ptr<LatencyTrace::Scope> trace;
+
+    if (LatencyTrace::isTraced(kco))
+    {
+        trace.reset(new LatencyTrace::Scope(kco));
+    }
+
     const std::string &key = kfvKey(kco);
     const std::string &op = kfvOp(kco);
 
@@ -2248,6 +2336,8 @@ sai_status_t processEvent(
 
     if (isInitViewMode())
     {
+        LatencyTrace::markDecoded();
+
         return processEventInInitViewMode(object_type, str_object_id, api, attr_count, attr_list);
     }
 
@@ -2267,6 +2357,8 @@ sai_status_t processEvent(
     // TODO use metadata utils
     auto info = sai_metadata_get_object_type_info(object_type);
 
+    LatencyTrace::markDecoded();
+
     sai_status_t status;
 
     /*
@@ -2298,13 +2390,19 @@ sai_status_t processEvent(
                 SWSS_LOG_THROW("non object id %s is not supported yet, FIXME", info->objecttypename);
         }
 
+        LatencyTrace::markSaiStart();
+
         status = handle_non_object_id(meta_key, api, attr_count, attr_list);
     }
     else
     {
+        LatencyTrace::markSaiStart();
+
         status = handle_generic(object_type, str_object_id, api, attr_count, attr_list);
     }
 
+    LatencyTrace::markSaiEnd();
+
     if (api == SAI_COMMON_API_GET)
     {
         if (status != SAI_STATUS_SUCCESS)
@@ -2370,28 +2468,35 @@ void processFlexCounterEvent(
     sai_object_id_t rid = translate_vid_to_rid(vid);
     sai_object_type_t objectType = sai_object_type_query(rid);
 
+    /*
+     * Remove doesn't carry any fields, so it's handled before fields loop.
+     */
+
+    if (op == DEL_COMMAND)
+    {
+        FlexCounter::removeCounters(objectType, vid);
+
+        return;
+    }
+
     const auto values = kfvFieldsValues(kco);
+
+    bool readAndClear = false;
+
+    for (const auto& valuePair : values)
+    {
+        if (fvField(valuePair) == FLEX_COUNTER_STATS_MODE)
+        {
+            readAndClear = (fvValue(valuePair) == STATS_MODE_READ_AND_CLEAR);
+        }
+    }
+
     for (const auto& valuePair : values)
     {
         const auto field = fvField(valuePair);
         const auto value = fvValue(valuePair);
 
-        if (op == DEL_COMMAND)
-        {
-            if (objectType == SAI_OBJECT_TYPE_PORT)
-            {
-                FlexCounter::removePort(vid);
-            }
-            else if (objectType == SAI_OBJECT_TYPE_QUEUE)
-            {
-                FlexCounter::removeQueue(vid);
-            }
-            else
-            {
-                SWSS_LOG_ERROR("Object type for removal not supported");
-            }
-        }
-        else if (op == SET_COMMAND)
+        if (op == SET_COMMAND)
         {
             auto idStrings  = swss::tokenize(value, ',');
 
@@ -2429,6 +2534,24 @@ void processFlexCounterEvent(
 
                 FlexCounter::setQueueAttrList(vid, rid, queueAttrIds);
             }
+            else if (field == FLEX_COUNTER_COUNTER_ID_LIST && BulkStats::getStatsEnumMetadata(objectType) != NULL)
+            {
+                const sai_enum_metadata_t *statsMeta = BulkStats::getStatsEnumMetadata(objectType);
+
+                std::vector<int32_t> counterIds;
+                for (const auto &str : idStrings)
+                {
+                    int32_t stat;
+                    sai_deserialize_enum(str, statsMeta, stat);
+                    counterIds.push_back(stat);
+                }
+
+                FlexCounter::setObjectCounterList(objectType, vid, rid, counterIds, readAndClear);
+            }
+            else if (field == FLEX_COUNTER_STATS_MODE)
+            {
+                continue;
+            }
             else
             {
                 SWSS_LOG_ERROR("Object type not supported");
@@ -2484,7 +2607,7 @@ void processFlexCounterPluginEvent(
 
 void printUsage()
 {
-    std::cout << "Usage: syncd [-N] [-d] [-p profile] [-i interval] [-t [cold|warm|fast]] [-h] [-u] [-S]" << std::endl;
+    std::cout << "Usage: syncd [-N] [-d] [-p profile] [-i interval] [-t [cold|warm|fast]] [-h] [-u] [-S] [-R file] [-I msec] [-T threads] [-A msec] [-W msec] [-P] [-F file] [-C file] [-D threads] [-X file] [-L]" << std::endl;
     std::cout << "    -N --nocounters:" << std::endl;
     std::cout << "        Disable counter thread" << std::endl;
     std::cout << "    -d --diag:" << std::endl;
@@ -2499,6 +2622,28 @@ void printUsage()
     std::cout << "        Use temporary view between init and apply" << std::endl;
     std::cout << "    -S --disableExitSleep" << std::endl;
     std::cout << "        Disable sleep when syncd crashes" << std::endl;
+    std::cout << "    -R --countersRing file:" << std::endl;
+    std::cout << "        Publish flex counters history to shared memory ring file" << std::endl;
+    std::cout << "    -I --flexCounterInterval msec:" << std::endl;
+    std::cout << "        Interval between flex counter polls (default 100)" << std::endl;
+    std::cout << "    -T --flexCounterThreads threads:" << std::endl;
+    std::cout << "        Number of threads collecting flex counters (default 1)" << std::endl;
+    std::cout << "    -A --flexCounterMaxInterval msec:" << std::endl;
+    std::cout << "        Enable adaptive flex counter polling of idle objects up to given interval" << std::endl;
+    std::cout << "    -W --fdbCoalesceWindow msec:" << std::endl;
+    std::cout << "        Hold fdb events for given time to coalesce events for the same MAC/BV" << std::endl;
+    std::cout << "    -P --saiProfiler" << std::endl;
+    std::cout << "        Profile all calls to vendor SAI" << std::endl;
+    std::cout << "    -F --saiProfilerTrace file:" << std::endl;
+    std::cout << "        Profile calls to vendor SAI and write Chrome trace to file on profile dump" << std::endl;
+    std::cout << "    -C --timeline file:" << std::endl;
+    std::cout << "        Write Chrome trace timeline of hard reinit, discovery and apply view to file" << std::endl;
+    std::cout << "    -D --discoveryThreads threads:" << std::endl;
+    std::cout << "        Number of threads discovering switch objects and deserializing ASIC state on hard reinit, use only with thread safe SAI (default 1)" << std::endl;
+    std::cout << "    -X --discoverySnapshot file:" << std::endl;
+    std::cout << "        Persist discovered objects to file and use it on next start if hardware didn't change" << std::endl;
+    std::cout << "    -L --lazyDiscovery" << std::endl;
+    std::cout << "        Discover only objects referenced by switch on start, other objects when they are used" << std::endl;
 #ifdef SAITHRIFT
     std::cout << "    -r --rpcserver:"           << std::endl;
     std::cout << "        Enable rpcserver"      << std::endl;
@@ -2517,12 +2662,19 @@ void handleCmdLine(int argc, char **argv)
 
     options.countersThreadIntervalInSeconds = defaultCountersThreadIntervalInSeconds;
     options.disableExitSleep = false;
+    options.flexCounterInterval = 0;
+    options.flexCounterConcurrency = 1;
+    options.flexCounterMaxInterval = 0;
+    options.fdbCoalesceWindow = 0;
+    options.saiProfiler = false;
+    options.discoveryConcurrency = 1;
+    options.lazyDiscovery = false;
 
 #ifdef SAITHRIFT
     options.run_rpc_server = false;
-    const char* const optstring = "dNt:p:i:rm:huS";
+    const char* const optstring = "dNt:p:i:rm:huSR:I:T:A:W:PF:C:D:X:L";
 #else
-    const char* const optstring = "dNt:p:i:huS";
+    const char* const optstring = "dNt:p:i:huSR:I:T:A:W:PF:C:D:X:L";
 #endif // SAITHRIFT
 
     while(true)
@@ -2537,6 +2689,17 @@ void handleCmdLine(int argc, char **argv)
             { "countersInterval", required_argument, 0, 'i' },
             { "help",             no_argument,       0, 'h' },
             { "disableExitSleep", no_argument,       0, 'S' },
+            { "countersRing",     required_argument, 0, 'R' },
+            { "flexCounterInterval", required_argument, 0, 'I' },
+            { "flexCounterThreads", required_argument, 0, 'T' },
+            { "flexCounterMaxInterval", required_argument, 0, 'A' },
+            { "fdbCoalesceWindow", required_argument, 0, 'W' },
+            { "saiProfiler",      no_argument,       0, 'P' },
+            { "saiProfilerTrace", required_argument, 0, 'F' },
+            { "timeline",         required_argument, 0, 'C' },
+            { "discoveryThreads", required_argument, 0, 'D' },
+            { "discoverySnapshot", required_argument, 0, 'X' },
+            { "lazyDiscovery",    no_argument,       0, 'L' },
 #ifdef SAITHRIFT
             { "rpcserver",        no_argument,       0, 'r' },
             { "portmap",          required_argument, 0, 'm' },
@@ -2580,6 +2743,62 @@ void handleCmdLine(int argc, char **argv)
                 options.profileMapFile = std::string(optarg);
                 break;
 
+            case 'R':
+                SWSS_LOG_NOTICE("counters ring file: %s", optarg);
+                options.countersRingFile = std::string(optarg);
+                break;
+
+            case 'I':
+                SWSS_LOG_NOTICE("flex counter interval: %s", optarg);
+                options.flexCounterInterval = std::max(0, std::stoi(std::string(optarg)));
+                break;
+
+            case 'T':
+                SWSS_LOG_NOTICE("flex counter threads: %s", optarg);
+                options.flexCounterConcurrency = std::max(1, std::stoi(std::string(optarg)));
+                break;
+
+            case 'A':
+                SWSS_LOG_NOTICE("flex counter max interval: %s", optarg);
+                options.flexCounterMaxInterval = std::max(0, std::stoi(std::string(optarg)));
+                break;
+
+            case 'W':
+                SWSS_LOG_NOTICE("fdb coalesce window: %s", optarg);
+                options.fdbCoalesceWindow = std::max(0, std::stoi(std::string(optarg)));
+                break;
+
+            case 'P':
+                SWSS_LOG_NOTICE("enable sai profiler");
+                options.saiProfiler = true;
+                break;
+
+            case 'F':
+                SWSS_LOG_NOTICE("sai profiler trace file: %s", optarg);
+                options.saiProfiler = true;
+                options.saiProfilerTraceFile = std::string(optarg);
+                break;
+
+            case 'C':
+                SWSS_LOG_NOTICE("timeline file: %s", optarg);
+                options.timelineFile = std::string(optarg);
+                break;
+
+            case 'D':
+                SWSS_LOG_NOTICE("discovery threads: %s", optarg);
+                options.discoveryConcurrency = std::max(1, std::stoi(std::string(optarg)));
+                break;
+
+            case 'X':
+                SWSS_LOG_NOTICE("discovery snapshot file: %s", optarg);
+                options.discoverySnapshotFile = std::string(optarg);
+                break;
+
+            case 'L':
+                SWSS_LOG_NOTICE("enable lazy discovery");
+                options.lazyDiscovery = true;
+                break;
+
             case 'i':
                 {
                     SWSS_LOG_NOTICE("counters thread interval: %s", optarg);
@@ -2651,6 +2870,27 @@ void handleCmdLine(int argc, char **argv)
     }
 }
 
+std::string getProfileFileHash(
+        _In_ const std::string &path)
+{
+    SWSS_LOG_ENTER();
+
+    struct stat st;
+
+    if (stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+    {
+        return "";
+    }
+
+    std::ifstream file(path, std::ios::binary);
+
+    std::stringstream content;
+
+    content << file.rdbuf();
+
+    return std::to_string(std::hash<std::string>()(content.str()));
+}
+
 void handleProfileMap(const std::string& profileMapFile)
 {
     SWSS_LOG_ENTER();
@@ -2862,59 +3102,188 @@ void set_sai_api_loglevel()
     }
 }
 
-void performWarmRestart()
+/**
+ * @def WARM_RESTART_CHECK_SAMPLE
+ *
+ * Number of RID/VID pairs checked against switch after warm restart.
+ */
+#define WARM_RESTART_CHECK_SAMPLE 256
+
+void performWarmRestartSingleSwitch(
+        _In_ const std::string &key)
 {
     SWSS_LOG_ENTER();
 
     /*
-     * There should be no case when we are doing warm restart and there is no
-     * switch defined, we will throw at sucha case.
+     * Entry should be in format ASIC_STATE:SAI_OBJECT_TYPE_SWITCH:oid:0xYYYY
      *
-     * This case could be possible when no switches were created and only api
-     * was initialized, but we will skip this scenario and address is when we
-     * will have need for it.
+     * Let's extract oid value
      */
 
-    auto entries = g_redisClient->keys(ASIC_STATE_TABLE + std::string(":SAI_OBJECT_TYPE_SWITCH:*"));
+    auto start = key.find_first_of(":") + 1;
+    auto end = key.find(":", start);
 
-    if (entries.size() == 0)
+    std::string strSwitchVid = key.substr(end + 1);
+
+    sai_object_id_t switch_vid;
+
+    sai_deserialize_object_id(strSwitchVid, switch_vid);
+
+    sai_object_id_t orig_rid = translate_vid_to_rid(switch_vid);
+
+    /*
+     * Switch needs to be created with the same create only attributes like
+     * hardware info, vendor will then attach to warm booted switch using
+     * warm boot read file passed in profile.
+     */
+
+    std::vector<swss::FieldValueTuple> values;
+
+    for (const auto &kv: g_redisClient->hgetall(key))
     {
-        SWSS_LOG_THROW("on warm restart there is no switches defined in DB, not supported yet, FIXME");
+        values.emplace_back(kv.first, kv.second);
+    }
+
+    SaiAttributeList list(SAI_OBJECT_TYPE_SWITCH, values, false);
+
+    sai_attribute_t *attrList = list.get_attr_list();
+
+    uint32_t attrCount = list.get_attr_count();
+
+    check_notifications_pointers(attrCount, attrList);
+
+    std::vector<sai_attribute_t> attrs;
+
+    sai_attribute_t attr;
+
+    attr.id = SAI_SWITCH_ATTR_INIT_SWITCH;
+    attr.value.booldata = true;
+
+    attrs.push_back(attr);
+
+    for (uint32_t idx = 0; idx < attrCount; idx++)
+    {
+        auto meta = sai_metadata_get_attr_metadata(SAI_OBJECT_TYPE_SWITCH, attrList[idx].id);
+
+        if (meta->attrid == SAI_SWITCH_ATTR_INIT_SWITCH)
+        {
+            continue;
+        }
+
+        if (HAS_FLAG_MANDATORY_ON_CREATE(meta->flags) ||
+                HAS_FLAG_CREATE_ONLY(meta->flags) ||
+                meta->attrvaluetype == SAI_ATTR_VALUE_TYPE_POINTER)
+        {
+            attrs.push_back(attrList[idx]); // struct copy, we will keep the same pointers
+        }
     }
 
-    if (entries.size() != 1)
+    sai_object_id_t switch_rid;
+
+    sai_status_t status = sai_metadata_sai_switch_api->create_switch(&switch_rid, (uint32_t)attrs.size(), attrs.data());
+
+    if (status != SAI_STATUS_SUCCESS)
     {
-        SWSS_LOG_THROW("multiple switches defined in warm start: %zu, not supported yet, FIXME", entries.size());
+        SWSS_LOG_THROW("failed to create switch VID %s on warm restart: %s",
+                strSwitchVid.c_str(),
+                sai_serialize_status(status).c_str());
     }
 
+    if (switch_rid != orig_rid)
+    {
+        SWSS_LOG_THROW("switch RID changed on warm restart from %s to %s",
+                sai_serialize_object_id(orig_rid).c_str(),
+                sai_serialize_object_id(switch_rid).c_str());
+    }
+
+    SWSS_LOG_NOTICE("warm started switch VID %s RID %s",
+            strSwitchVid.c_str(),
+            sai_serialize_object_id(switch_rid).c_str());
+
     /*
-     * Here wa have only one switch defined, let's extract his vid and rid.
+     * Switch will load existing objects saved on warm shutdown instead of
+     * discovery.
      */
 
+    switches[switch_vid] = std::make_shared<SaiSwitch>(switch_vid, switch_rid);
+}
+
+void checkWarmRestartIds()
+{
+    SWSS_LOG_ENTER();
+
     /*
-     * Entry should be in format ASIC_STATE:SAI_OBJECT_TYPE_SWITCH:oid:0xYYYY
-     *
-     * Let's extract oid value
+     * RIDs must be the same after warm restart, sample of RID/VID pairs is
+     * checked whether object with given RID exists on switch and it's type
+     * matches type encoded in VID.
      */
 
-    std::string key = entries.at(0);
+    auto ridToVid = SaiSwitch::redisGetObjectMap(RIDTOVID);
 
-    auto start = key.find_first_of(":") + 1;
-    auto end = key.find(":", start);
+    size_t stride = std::max((size_t)1, ridToVid.size() / WARM_RESTART_CHECK_SAMPLE);
 
-    std::string strSwitchVid = key.substr(end + 1);
+    size_t index = 0;
+    size_t checked = 0;
 
-    sai_object_id_t switch_vid;
+    for (const auto &kv: ridToVid)
+    {
+        if (index++ % stride)
+        {
+            continue;
+        }
 
-    sai_deserialize_object_id(strSwitchVid, switch_vid);
+        sai_object_type_t ot = sai_object_type_query(kv.first);
 
-    sai_object_id_t switch_rid = translate_vid_to_rid(switch_vid);
+        if (ot == SAI_OBJECT_TYPE_NULL || ot != redis_sai_object_type_query(kv.second))
+        {
+            SWSS_LOG_THROW("RID %s of VID %s don't match switch after warm restart",
+                    sai_serialize_object_id(kv.first).c_str(),
+                    sai_serialize_object_id(kv.second).c_str());
+        }
+
+        checked++;
+    }
+
+    SWSS_LOG_NOTICE("checked %zu of %zu RID/VID pairs after warm restart", checked, ridToVid.size());
+}
+
+void performWarmRestart()
+{
+    SWSS_LOG_ENTER();
 
     /*
-     * Perform all get operations on existing switch.
+     * There should be no case when we are doing warm restart and there is no
+     * switch defined, we will throw at sucha case.
+     *
+     * This case could be possible when no switches were created and only api
+     * was initialized, but we will skip this scenario and address is when we
+     * will have need for it.
      */
 
-    switches[switch_vid] = std::make_shared<SaiSwitch>(switch_vid, switch_rid);
+    auto entries = g_redisClient->keys(ASIC_STATE_TABLE + std::string(":SAI_OBJECT_TYPE_SWITCH:*"));
+
+    if (entries.size() == 0)
+    {
+        SWSS_LOG_THROW("on warm restart there is no switches defined in DB, not supported yet, FIXME");
+    }
+
+    const char *warmBootReadFile = profile_get_value(0, SAI_KEY_WARM_BOOT_READ_FILE);
+
+    if (warmBootReadFile == NULL)
+    {
+        SWSS_LOG_THROW("warm boot read file is not specified");
+    }
+
+    SaiSwitch::setWarmBoot(warmBootReadFile);
+
+    for (const auto &key: entries)
+    {
+        performWarmRestartSingleSwitch(key);
+    }
+
+    SaiSwitch::setWarmBoot("");
+
+    checkWarmRestartIds();
 }
 
 void onSyncdStart(bool warmStart)
@@ -2933,6 +3302,8 @@ void onSyncdStart(bool warmStart)
 
     SWSS_LOG_TIMER("on syncd start");
 
+    Timeline::Span span(warmStart ? "onSyncdStart:warm" : "onSyncdStart:cold");
+
     if (warmStart)
     {
         /*
@@ -2949,15 +3320,14 @@ void onSyncdStart(bool warmStart)
 
         performWarmRestart();
 
-        SWSS_LOG_NOTICE("skipping hard reinit since WARM start was performed");
+        /*
+         * Existing objects are not discovered but loaded from state saved on
+         * warm shutdown, so objects removed or added by user before restart
+         * (like vlan members or queues) are still correctly marked.
+         */
 
-        // TODO issue here can be that in hard start there was 8 queues then
-        // user added 2, and we have 10, after warm restart, switch will
-        // discover 10 queus, and mark them as "non removable" but 2 of them
-        // can be removed. We would probably need to store all objects after
-        // hard reinit and treat that as base.
+        SWSS_LOG_NOTICE("skipping hard reinit since WARM start was performed");
 
-        SWSS_LOG_THROW("warm restart is not yet fully supported and needs to be revisited");
         return;
     }
 
@@ -3053,6 +3423,39 @@ int syncd_main(int argc, char **argv)
     }
 #endif // SAITHRIFT
 
+    if (options.discoverySnapshotFile.size())
+    {
+        /*
+         * Profile and port map can change discovered objects (like number of
+         * ports), so snapshot is valid only for the same configuration.
+         * Profile values can also point to vendor configuration files, so
+         * their content is part of configuration as well.
+         */
+
+        std::string configKey;
+
+        for (const auto &kvp: gProfileMap)
+        {
+            configKey += kvp.first + "=" + kvp.second + "#" + getProfileFileHash(kvp.second) + ";";
+        }
+
+#ifdef SAITHRIFT
+        for (const auto &kvp: gPortMap)
+        {
+            configKey += kvp.second + ":";
+
+            for (int lane: kvp.first)
+            {
+                configKey += std::to_string(lane) + ",";
+            }
+
+            configKey += ";";
+        }
+#endif // SAITHRIFT
+
+        SaiSwitch::setDiscoverySnapshot(options.discoverySnapshotFile, configKey);
+    }
+
     std::shared_ptr<swss::DBConnector> dbAsic = std::make_shared<swss::DBConnector>(ASIC_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
     std::shared_ptr<swss::DBConnector> dbNtf = std::make_shared<swss::DBConnector>(ASIC_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
     std::shared_ptr<swss::DBConnector> dbFlexCounter = std::make_shared<swss::DBConnector>(PFC_WD_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
@@ -3120,6 +3523,22 @@ int syncd_main(int argc, char **argv)
         SWSS_LOG_WARN("sai_api_query failed for %d apis", failed);
     }
 
+    BulkStats::apiQuery();
+
+    if (options.saiProfiler)
+    {
+        SaiProfiler::install(options.saiProfilerTraceFile);
+    }
+
+    if (options.timelineFile.size())
+    {
+        Timeline::enable(options.timelineFile);
+    }
+
+    SaiSwitch::setDiscoveryConcurrency((size_t)options.discoveryConcurrency);
+
+    SaiSwitch::setLazyDiscovery(options.lazyDiscovery);
+
     /*
      * TODO: user should create switch from OA, so shell should be started only
      * after we create switch.
@@ -3150,6 +3569,22 @@ int syncd_main(int argc, char **argv)
             startCountersThread(options.countersThreadIntervalInSeconds);
         }
 
+        FlexCounter::setPollInterval((uint32_t)options.flexCounterInterval);
+
+        if (options.countersRingFile.size() != 0)
+        {
+            FlexCounter::enableCounterRing(options.countersRingFile);
+        }
+
+        FlexCounter::setCollectConcurrency((uint32_t)options.flexCounterConcurrency);
+
+        if (options.flexCounterMaxInterval != 0)
+        {
+            FlexCounter::setAdaptivePolling((uint32_t)options.flexCounterMaxInterval);
+        }
+
+        setFdbCoalesceWindow((uint32_t)options.fdbCoalesceWindow);
+
         startNotificationsProcessingThread();
 
         SWSS_LOG_NOTICE("syncd listening for events");
@@ -3195,6 +3630,8 @@ int syncd_main(int argc, char **argv)
             else if (result == swss::Select::OBJECT)
             {
                 processEvent(*(swss::ConsumerTable*)sel);
+
+                processSpottedRids();
             }
         }
     }
@@ -3219,6 +3656,27 @@ int syncd_main(int argc, char **argv)
 
             warmRestartHint = false;
         }
+        else
+        {
+            for (const auto &kv: switches)
+            {
+                sai_attribute_t attr;
+
+                attr.id = SAI_SWITCH_ATTR_RESTART_WARM;
+                attr.value.booldata = true;
+
+                status = sai_metadata_sai_switch_api->set_switch_attribute(kv.second->getRid(), &attr);
+
+                if (status != SAI_STATUS_SUCCESS)
+                {
+                    SWSS_LOG_ERROR("failed to set warm restart on switch %s: %s",
+                            sai_serialize_object_id(kv.first).c_str(),
+                            sai_serialize_status(status).c_str());
+                }
+
+                kv.second->saveWarmBootState(warmBootWriteFile);
+            }
+        }
     }
 
     SWSS_LOG_NOTICE("calling api uninitialize");
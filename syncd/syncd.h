@@ -113,6 +113,9 @@ bool is_set_attribute_workaround(
 void startNotificationsProcessingThread();
 void stopNotificationsProcessingThread();
 
+void setFdbCoalesceWindow(
+        _In_ uint32_t msec);
+
 sai_status_t processBulkEvent(
         _In_ sai_common_api_t api,
         _In_ const swss::KeyOpFieldsValuesTuple &kco);
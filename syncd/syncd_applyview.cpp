@@ -1,5 +1,6 @@
 #include "syncd.h"
 #include "sairedis.h"
+#include "syncd_timeline.h"
 #include "swss/table.h"
 #include "swss/logger.h"
 #include "swss/dbconnector.h"
@@ -1546,6 +1547,10 @@ void redisGetAsicView(
 
     SWSS_LOG_TIMER("get asic view from %s", tableName.c_str());
 
+    Timeline::Span span("redisGetAsicView");
+
+    span.addArg("table", tableName);
+
     swss::DBConnector db(ASIC_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
 
     swss::Table table(&db, tableName);
@@ -1556,6 +1561,8 @@ void redisGetAsicView(
 
     view.fromDump(dump);
 
+    span.addArg("objects", view.soAll.size());
+
     SWSS_LOG_NOTICE("objects count for %s: %zu", tableName.c_str(), view.soAll.size());
 }
 
@@ -4735,6 +4742,11 @@ void applyViewTransition(
 
     SWSS_LOG_TIMER("comparison logic");
 
+    Timeline::Span span("applyViewTransition");
+
+    span.addArg("temp_objects", temp.soAll.size());
+    span.addArg("current_objects", current.soAll.size());
+
     checkSwitch(current, temp);
 
     checkMatchedPorts(temp);
@@ -4763,14 +4775,55 @@ void applyViewTransition(
      * XXX this is workaround. FIXME
      */
 
+    /*
+     * Objects in soAll are ordered by serialized object type, so each object
+     * type is processed as continuous pass and can be traced as one span.
+     */
+
+    std::shared_ptr<Timeline::Span> passSpan;
+
+    sai_object_type_t passObjectType = SAI_OBJECT_TYPE_NULL;
+
+    uint64_t passCount = 0;
+
     for (auto &obj: temp.soAll)
     {
         if (obj.second->getObjectType() != SAI_OBJECT_TYPE_ROUTE_ENTRY)
         {
+            if (Timeline::isEnabled() && obj.second->getObjectType() != passObjectType)
+            {
+                if (passSpan)
+                {
+                    passSpan->addArg("objects", passCount);
+                }
+
+                passObjectType = obj.second->getObjectType();
+                passCount = 0;
+
+                passSpan = nullptr;
+                passSpan = std::make_shared<Timeline::Span>("pass:" + obj.second->str_object_type);
+            }
+
+            passCount++;
+
             processObjectForViewTransition(current, temp, obj.second);
         }
     }
 
+    if (passSpan)
+    {
+        passSpan->addArg("objects", passCount);
+
+        passSpan = nullptr;
+    }
+
+    if (Timeline::isEnabled())
+    {
+        passSpan = std::make_shared<Timeline::Span>("pass:" + sai_serialize_object_type(SAI_OBJECT_TYPE_ROUTE_ENTRY));
+    }
+
+    passCount = 0;
+
     for (auto &obj: temp.soAll)
     {
         if (obj.second->getObjectType() == SAI_OBJECT_TYPE_ROUTE_ENTRY)
@@ -4779,6 +4832,8 @@ void applyViewTransition(
 
             if (isDefault)
             {
+                passCount++;
+
                 processObjectForViewTransition(current, temp, obj.second);
             }
         }
@@ -4792,11 +4847,20 @@ void applyViewTransition(
 
             if (!isDefault)
             {
+                passCount++;
+
                 processObjectForViewTransition(current, temp, obj.second);
             }
         }
     }
 
+    if (passSpan)
+    {
+        passSpan->addArg("objects", passCount);
+
+        passSpan = nullptr;
+    }
+
     /*
      * There is a problem here with default trap group, since when other trap
      * groups are created and used in traps, then when removing them we reset
@@ -4816,6 +4880,13 @@ void applyViewTransition(
 
     bringDefaultTrapGroupToFinalState(current, temp);
 
+    if (Timeline::isEnabled())
+    {
+        passSpan = std::make_shared<Timeline::Span>("pass:remove");
+    }
+
+    passCount = 0;
+
     /*
      * Removing needs to be done from leaf with no references and it can be
      * multiple passes since if in first pass object had non zero references,
@@ -4850,6 +4921,8 @@ void applyViewTransition(
             {
                 if (current.getVidReferenceCount(obj->getVid()) == 0)
                 {
+                    passCount++;
+
                     removeExistingObjectFromCurrentView(current, temp, obj);
                 }
             }
@@ -4899,6 +4972,15 @@ void applyViewTransition(
         {
             SWSS_LOG_NOTICE("loop removed %d objects", removed);
         }
+
+        passCount += (uint64_t)removed;
+    }
+
+    if (passSpan)
+    {
+        passSpan->addArg("objects", passCount);
+
+        passSpan = nullptr;
     }
 
     /*
@@ -5016,6 +5098,10 @@ void updateRedisDatabase(
 
     SWSS_LOG_TIMER("redis update");
 
+    Timeline::Span span("updateRedisDatabase");
+
+    span.addArg("objects", temporaryView.soAll.size());
+
     /*
      * Remove Asic State Table
      */
@@ -5099,6 +5185,8 @@ sai_status_t syncdApplyView()
 
     SWSS_LOG_TIMER("apply");
 
+    Timeline::Span span("syncdApplyView");
+
     /*
      * We assume that there will be no case that we will move from 1 to 0, also
      * if at the beginning there is no switch, then when user will send create,
@@ -5169,6 +5257,12 @@ sai_status_t syncdApplyView()
 
         auto sw = switches.begin()->second;
 
+        /*
+         * Existing objects must be all present in current view.
+         */
+
+        sw->completeLazyDiscovery(true);
+
         ObjectIdMap vidToRidMap = sw->redisGetVidToRidMap();
         ObjectIdMap ridToVidMap = sw->redisGetRidToVidMap();
 
@@ -5763,6 +5857,10 @@ void executeOperationsOnAsic(
 
         SWSS_LOG_TIMER("asic apply");
 
+        Timeline::Span span("executeOperationsOnAsic");
+
+        span.addArg("operations", currentView.asicGetOperationsCount());
+
         //for (const auto &op: currentView.asicGetOperations())
         for (const auto &op: currentView.asicGetWithOptimizedRemoveOperations())
         {
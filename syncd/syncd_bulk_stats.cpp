@@ -0,0 +1,265 @@
+#include "syncd_bulk_stats.h"
+#include "sairedis.h"
+
+#include "swss/logger.h"
+#include "meta/saiserialize.h"
+
+#include <atomic>
+
+static const sai_bulk_stats_api_t *g_bulkStatsApi = NULL;
+
+/*
+ * Object types on which vendor bulk call returned not supported, those will
+ * use per object fallback from that point.
+ */
+static std::atomic_bool g_bulkNotSupported[SAI_OBJECT_TYPE_MAX];
+
+void BulkStats::apiQuery()
+{
+    SWSS_LOG_ENTER();
+
+    const sai_bulk_stats_api_t *api = NULL;
+
+    g_bulkStatsApi = NULL;
+
+    sai_status_t status = sai_api_query(SAI_API_BULK_STATS, (void**)&api);
+
+    switch (status)
+    {
+        case SAI_STATUS_SUCCESS:
+            break;
+
+        case SAI_STATUS_NOT_SUPPORTED:
+        case SAI_STATUS_NOT_IMPLEMENTED:
+        case SAI_STATUS_INVALID_PARAMETER:
+
+            /*
+             * Expected answer from vendor which doesn't know this api id.
+             */
+
+            SWSS_LOG_NOTICE("vendor bulk stats api not present (%s), using per object stats",
+                    sai_serialize_status(status).c_str());
+
+            return;
+
+        default:
+
+            SWSS_LOG_WARN("vendor bulk stats api query failed: %s, using per object stats",
+                    sai_serialize_status(status).c_str());
+
+            return;
+    }
+
+    if (api == NULL || api->get_bulk_stats == NULL)
+    {
+        SWSS_LOG_WARN("vendor returned success but no bulk stats api, using per object stats");
+
+        return;
+    }
+
+    for (auto &notSupported: g_bulkNotSupported)
+    {
+        notSupported = false;
+    }
+
+    g_bulkStatsApi = api;
+
+    SWSS_LOG_NOTICE("vendor bulk stats api present");
+}
+
+bool BulkStats::isVendorBulkSupported(
+        _In_ sai_object_type_t objectType)
+{
+    SWSS_LOG_ENTER();
+
+    if (g_bulkStatsApi == NULL || objectType <= SAI_OBJECT_TYPE_NULL || objectType >= SAI_OBJECT_TYPE_MAX)
+    {
+        return false;
+    }
+
+    return !g_bulkNotSupported[objectType];
+}
+
+const sai_enum_metadata_t* BulkStats::getStatsEnumMetadata(
+        _In_ sai_object_type_t objectType)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Router interface stats are not present in current SAI version.
+     */
+
+    switch (objectType)
+    {
+        case SAI_OBJECT_TYPE_PORT:
+            return &sai_metadata_enum_sai_port_stat_t;
+
+        case SAI_OBJECT_TYPE_QUEUE:
+            return &sai_metadata_enum_sai_queue_stat_t;
+
+        case SAI_OBJECT_TYPE_INGRESS_PRIORITY_GROUP:
+            return &sai_metadata_enum_sai_ingress_priority_group_stat_t;
+
+        case SAI_OBJECT_TYPE_BUFFER_POOL:
+            return &sai_metadata_enum_sai_buffer_pool_stat_t;
+
+        default:
+            return NULL;
+    }
+}
+
+sai_status_t BulkStats::getObjectStats(
+        _In_ sai_object_type_t objectType,
+        _In_ sai_object_id_t objectId,
+        _In_ uint32_t numberOfCounters,
+        _In_ const int32_t *counterIds,
+        _Out_ uint64_t *counters)
+{
+    SWSS_LOG_ENTER();
+
+    switch (objectType)
+    {
+        case SAI_OBJECT_TYPE_PORT:
+            return sai_metadata_sai_port_api->get_port_stats(
+                    objectId,
+                    numberOfCounters,
+                    (const sai_port_stat_t*)counterIds,
+                    counters);
+
+        case SAI_OBJECT_TYPE_QUEUE:
+            return sai_metadata_sai_queue_api->get_queue_stats(
+                    objectId,
+                    numberOfCounters,
+                    (const sai_queue_stat_t*)counterIds,
+                    counters);
+
+        case SAI_OBJECT_TYPE_INGRESS_PRIORITY_GROUP:
+            return sai_metadata_sai_buffer_api->get_ingress_priority_group_stats(
+                    objectId,
+                    numberOfCounters,
+                    (const sai_ingress_priority_group_stat_t*)counterIds,
+                    counters);
+
+        case SAI_OBJECT_TYPE_BUFFER_POOL:
+            return sai_metadata_sai_buffer_api->get_buffer_pool_stats(
+                    objectId,
+                    numberOfCounters,
+                    (const sai_buffer_pool_stat_t*)counterIds,
+                    counters);
+
+        default:
+
+            SWSS_LOG_ERROR("stats are not supported on %s",
+                    sai_serialize_object_type(objectType).c_str());
+
+            return SAI_STATUS_NOT_SUPPORTED;
+    }
+}
+
+sai_status_t BulkStats::getStats(
+        _In_ sai_object_type_t objectType,
+        _In_ const std::vector<sai_object_id_t> &objectIds,
+        _In_ const std::vector<int32_t> &counterIds,
+        _Out_ BulkStatsMatrix &matrix)
+{
+    SWSS_LOG_ENTER();
+
+    matrix.objectCount = (uint32_t)objectIds.size();
+    matrix.counterCount = (uint32_t)counterIds.size();
+
+    matrix.counters.assign((size_t)matrix.objectCount * matrix.counterCount, 0);
+    matrix.statuses.assign(matrix.objectCount, SAI_STATUS_FAILURE);
+
+    if (matrix.objectCount == 0 || matrix.counterCount == 0)
+    {
+        matrix.statuses.assign(matrix.objectCount, SAI_STATUS_SUCCESS);
+
+        return SAI_STATUS_SUCCESS;
+    }
+
+    if (isVendorBulkSupported(objectType))
+    {
+        sai_status_t status = g_bulkStatsApi->get_bulk_stats(
+                objectType,
+                matrix.objectCount,
+                objectIds.data(),
+                matrix.counterCount,
+                counterIds.data(),
+                matrix.counters.data(),
+                matrix.statuses.data());
+
+        if (status != SAI_STATUS_NOT_SUPPORTED && status != SAI_STATUS_NOT_IMPLEMENTED)
+        {
+            return status;
+        }
+
+        SWSS_LOG_NOTICE("vendor bulk stats not supported on %s, using per object stats",
+                sai_serialize_object_type(objectType).c_str());
+
+        g_bulkNotSupported[objectType] = true;
+
+        matrix.statuses.assign(matrix.objectCount, SAI_STATUS_FAILURE);
+    }
+
+    sai_status_t status = SAI_STATUS_SUCCESS;
+
+    for (uint32_t idx = 0; idx < matrix.objectCount; idx++)
+    {
+        matrix.statuses[idx] = getObjectStats(
+                objectType,
+                objectIds[idx],
+                matrix.counterCount,
+                counterIds.data(),
+                matrix.counters.data() + (size_t)idx * matrix.counterCount);
+
+        if (matrix.statuses[idx] != SAI_STATUS_SUCCESS)
+        {
+            status = SAI_STATUS_FAILURE;
+        }
+    }
+
+    return status;
+}
+
+sai_status_t BulkStats::clearObjectStats(
+        _In_ sai_object_type_t objectType,
+        _In_ sai_object_id_t objectId,
+        _In_ uint32_t numberOfCounters,
+        _In_ const int32_t *counterIds)
+{
+    SWSS_LOG_ENTER();
+
+    switch (objectType)
+    {
+        case SAI_OBJECT_TYPE_PORT:
+            return sai_metadata_sai_port_api->clear_port_stats(
+                    objectId,
+                    numberOfCounters,
+                    (const sai_port_stat_t*)counterIds);
+
+        case SAI_OBJECT_TYPE_QUEUE:
+            return sai_metadata_sai_queue_api->clear_queue_stats(
+                    objectId,
+                    numberOfCounters,
+                    (const sai_queue_stat_t*)counterIds);
+
+        case SAI_OBJECT_TYPE_INGRESS_PRIORITY_GROUP:
+            return sai_metadata_sai_buffer_api->clear_ingress_priority_group_stats(
+                    objectId,
+                    numberOfCounters,
+                    (const sai_ingress_priority_group_stat_t*)counterIds);
+
+        case SAI_OBJECT_TYPE_BUFFER_POOL:
+            return sai_metadata_sai_buffer_api->clear_buffer_pool_stats(
+                    objectId,
+                    numberOfCounters,
+                    (const sai_buffer_pool_stat_t*)counterIds);
+
+        default:
+
+            SWSS_LOG_ERROR("stats are not supported on %s",
+                    sai_serialize_object_type(objectType).c_str());
+
+            return SAI_STATUS_NOT_SUPPORTED;
+    }
+}
@@ -0,0 +1,99 @@
+#ifndef __SYNCD_BULK_STATS_H__
+#define __SYNCD_BULK_STATS_H__
+
+extern "C" {
+#include "sai.h"
+#include "saimetadata.h"
+}
+
+#include "syncd_bulk_stats_api.h"
+
+#include <vector>
+
+/**
+ * @brief Dense matrix of counters of multiple objects.
+ *
+ * Counters of object with index i are stored in row i, in the same order as
+ * requested counter ids. Row of object which failed has unspecified values.
+ */
+struct BulkStatsMatrix
+{
+    uint32_t objectCount = 0;
+
+    uint32_t counterCount = 0;
+
+    std::vector<uint64_t> counters;
+
+    std::vector<sai_status_t> statuses;
+
+    const uint64_t* getRow(
+            _In_ size_t index) const
+    {
+        return counters.data() + index * counterCount;
+    }
+};
+
+/**
+ * @brief Bulk stats retrieval of many objects of the same type.
+ *
+ * Uses vendor multi object stats API (SAI_API_BULK_STATS) when vendor
+ * provides it, and falls back to per object get stats calls otherwise, or
+ * when vendor don't support given object type. Methods can be called from
+ * multiple threads at the same time.
+ */
+class BulkStats
+{
+    public:
+
+        /**
+         * @brief Queries vendor for bulk stats API.
+         *
+         * Must be called after SAI api was initialized and before any
+         * counters are collected.
+         */
+        static void apiQuery();
+
+        static bool isVendorBulkSupported(
+                _In_ sai_object_type_t objectType);
+
+        /**
+         * @brief Gets stat enum metadata of object type.
+         *
+         * @return Enum metadata (e.g. sai_port_stat_t for port) or NULL when
+         * stats are not supported on given object type.
+         */
+        static const sai_enum_metadata_t* getStatsEnumMetadata(
+                _In_ sai_object_type_t objectType);
+
+        /**
+         * @brief Gets counters of all objects.
+         *
+         * @param objectType Object type of all objects.
+         * @param objectIds Real object ids.
+         * @param counterIds Object type specific stat enum values.
+         * @param matrix Resulting counters and per object statuses.
+         *
+         * @return SAI_STATUS_SUCCESS when counters of all objects were
+         * obtained, SAI_STATUS_FAILURE when any of the objects failed.
+         */
+        static sai_status_t getStats(
+                _In_ sai_object_type_t objectType,
+                _In_ const std::vector<sai_object_id_t> &objectIds,
+                _In_ const std::vector<int32_t> &counterIds,
+                _Out_ BulkStatsMatrix &matrix);
+
+        static sai_status_t getObjectStats(
+                _In_ sai_object_type_t objectType,
+                _In_ sai_object_id_t objectId,
+                _In_ uint32_t numberOfCounters,
+                _In_ const int32_t *counterIds,
+                _Out_ uint64_t *counters);
+
+        static sai_status_t clearObjectStats(
+                _In_ sai_object_type_t objectType,
+                _In_ sai_object_id_t objectId,
+                _In_ uint32_t numberOfCounters,
+                _In_ const int32_t *counterIds);
+};
+
+#endif // __SYNCD_BULK_STATS_H__
@@ -0,0 +1,65 @@
+#ifndef __SYNCD_BULK_STATS_API_H__
+#define __SYNCD_BULK_STATS_API_H__
+
+extern "C" {
+#include "sai.h"
+}
+
+/*
+ * Multi object stats API is not part of SAI 0.9.4. Vendor can provide it by
+ * returning sai_bulk_stats_api_t from sai_api_query when queried for
+ * SAI_API_BULK_STATS, syncd will query it at runtime and fall back to per
+ * object get stats calls when it's not present.
+ *
+ * This is contract between syncd and vendor library only (vslib implements
+ * it), it's not part of sairedis API used by orchagent.
+ *
+ * Api id is taken from custom range (same base as in later SAI versions), far
+ * above any api id, so vendor which doesn't know it will reject it by range
+ * check instead of using it as index into its api tables.
+ */
+
+#ifndef SAI_API_CUSTOM_RANGE_START
+#define SAI_API_CUSTOM_RANGE_START 0x10000000
+#endif
+
+#ifndef SAI_API_BULK_STATS
+#define SAI_API_BULK_STATS ((sai_api_t)(SAI_API_CUSTOM_RANGE_START + 0))
+#endif
+
+/**
+ * @brief Get statistics counters of multiple objects of the same type
+ *
+ * @param[in] object_type Object type of all objects
+ * @param[in] object_count Number of objects
+ * @param[in] object_id List of object ids
+ * @param[in] number_of_counters Number of counters in the array
+ * @param[in] counter_ids Specifies the array of counter ids, values are
+ *    object type specific stat enum values (e.g. sai_port_stat_t)
+ * @param[out] counters Array of resulting counter values, caller needs to
+ *    allocate object_count * number_of_counters items, counters of object
+ *    with index i start at i * number_of_counters
+ * @param[out] object_statuses List of status for every object. Caller needs
+ *    to allocate the buffer
+ *
+ * @return #SAI_STATUS_SUCCESS on success when counters of all objects were
+ * obtained, #SAI_STATUS_NOT_SUPPORTED when object type is not supported, or
+ * #SAI_STATUS_FAILURE when any of the objects failed. When there is failure,
+ * caller is expected to go through the list of returned statuses.
+ */
+typedef sai_status_t (*sai_bulk_get_stats_fn)(
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ uint32_t number_of_counters,
+        _In_ const int32_t *counter_ids,
+        _Out_ uint64_t *counters,
+        _Out_ sai_status_t *object_statuses);
+
+typedef struct _sai_bulk_stats_api_t
+{
+    sai_bulk_get_stats_fn get_bulk_stats;
+
+} sai_bulk_stats_api_t;
+
+#endif // __SYNCD_BULK_STATS_API_H__
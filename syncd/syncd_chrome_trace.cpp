@@ -0,0 +1,212 @@
+#include "syncd_chrome_trace.h"
+
+#include "swss/logger.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+#include <unistd.h>
+#include <sys/syscall.h>
+
+ChromeTrace::ChromeTrace(
+        _In_ size_t maxEvents):
+    m_maxEvents(maxEvents ? maxEvents : 1),
+    m_next(0),
+    m_dropped(0)
+{
+    SWSS_LOG_ENTER();
+
+    // empty
+}
+
+void ChromeTrace::add(
+        _Inout_ ChromeTraceEvent &&event)
+{
+    SWSS_LOG_ENTER();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_events.size() < m_maxEvents)
+    {
+        m_events.push_back(std::move(event));
+
+        return;
+    }
+
+    m_events[m_next] = std::move(event);
+
+    m_next = (m_next + 1) % m_maxEvents;
+
+    m_dropped++;
+}
+
+size_t ChromeTrace::size()
+{
+    SWSS_LOG_ENTER();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_events.size();
+}
+
+uint64_t ChromeTrace::getDropped()
+{
+    SWSS_LOG_ENTER();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_dropped;
+}
+
+void ChromeTrace::clear()
+{
+    SWSS_LOG_ENTER();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_events.clear();
+
+    m_next = 0;
+    m_dropped = 0;
+}
+
+uint64_t ChromeTrace::getThreadId()
+{
+    SWSS_LOG_ENTER();
+
+    return (uint64_t)syscall(SYS_gettid);
+}
+
+std::string ChromeTrace::escape(
+        _In_ const std::string &value)
+{
+    SWSS_LOG_ENTER();
+
+    std::string escaped;
+
+    escaped.reserve(value.size());
+
+    for (char c: value)
+    {
+        switch (c)
+        {
+            case '"':  escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\t': escaped += "\\t"; break;
+
+            default:
+
+                if ((unsigned char)c < 0x20)
+                {
+                    continue;
+                }
+
+                escaped += c;
+                break;
+        }
+    }
+
+    return escaped;
+}
+
+static void writeMicroseconds(
+        _Inout_ std::ofstream &out,
+        _In_ uint64_t nanoseconds)
+{
+    SWSS_LOG_ENTER();
+
+    out << nanoseconds / 1000 << "." << std::setw(3) << std::setfill('0') << nanoseconds % 1000;
+}
+
+bool ChromeTrace::write(
+        _In_ const std::string &path,
+        _In_ bool clearEvents)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<ChromeTraceEvent> events;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (clearEvents)
+        {
+            events.swap(m_events);
+
+            m_next = 0;
+            m_dropped = 0;
+        }
+        else
+        {
+            events = m_events;
+        }
+    }
+
+    std::stable_sort(events.begin(), events.end(),
+            [](const ChromeTraceEvent &a, const ChromeTraceEvent &b) { return a.start < b.start; });
+
+    std::ofstream out(path, std::ofstream::out | std::ofstream::trunc);
+
+    if (!out.is_open())
+    {
+        SWSS_LOG_ERROR("failed to open trace file %s", path.c_str());
+
+        return false;
+    }
+
+    int pid = getpid();
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    bool first = true;
+
+    for (const auto &event: events)
+    {
+        out << (first ? "\n" : ",\n");
+
+        first = false;
+
+        out << "{\"name\":\"" << escape(event.name) << "\"";
+        out << ",\"cat\":\"" << escape(event.category) << "\"";
+        out << ",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << event.tid;
+        out << ",\"ts\":";
+
+        writeMicroseconds(out, event.start);
+
+        out << ",\"dur\":";
+
+        writeMicroseconds(out, event.duration);
+
+        if (event.args.size())
+        {
+            out << ",\"args\":{";
+
+            for (size_t idx = 0; idx < event.args.size(); idx++)
+            {
+                out << (idx ? "," : "");
+                out << "\"" << escape(event.args[idx].first) << "\":\"" << escape(event.args[idx].second) << "\"";
+            }
+
+            out << "}";
+        }
+
+        out << "}";
+    }
+
+    out << "\n]}\n";
+
+    out.close();
+
+    if (out.fail())
+    {
+        SWSS_LOG_ERROR("failed to write trace file %s", path.c_str());
+
+        return false;
+    }
+
+    SWSS_LOG_NOTICE("written %zu trace events to %s", events.size(), path.c_str());
+
+    return true;
+}
@@ -0,0 +1,104 @@
+#ifndef __SYNCD_CHROME_TRACE_H__
+#define __SYNCD_CHROME_TRACE_H__
+
+extern "C" {
+#include "sai.h"
+}
+
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Single complete event of Chrome trace.
+ *
+ * Timestamps are nanoseconds of monotonic clock, they are converted to
+ * microseconds when trace is written.
+ */
+typedef struct _ChromeTraceEvent
+{
+    std::string name;
+
+    std::string category;
+
+    uint64_t start;
+
+    uint64_t duration;
+
+    uint64_t tid;
+
+    std::vector<std::pair<std::string, std::string>> args;
+
+} ChromeTraceEvent;
+
+/**
+ * @brief Bounded buffer of trace events which can be written as Chrome trace
+ * event format JSON file, loadable by chrome://tracing or Perfetto UI.
+ *
+ * Events are recorded as complete ("X") events, so spans recorded on the same
+ * thread are nested by viewer based on their time range. When buffer is full,
+ * oldest events are overwritten, so written file always contains most recent
+ * time window.
+ *
+ * This class is thread safe.
+ */
+class ChromeTrace
+{
+    public:
+
+        ChromeTrace(
+                _In_ size_t maxEvents);
+
+        virtual ~ChromeTrace() = default;
+
+    public:
+
+        void add(
+                _Inout_ ChromeTraceEvent &&event);
+
+        size_t size();
+
+        uint64_t getDropped();
+
+        void clear();
+
+        /**
+         * @brief Writes all events in time order to JSON file.
+         *
+         * @param path Output file path, overwritten if exists.
+         * @param clearEvents Clear events after they were written.
+         *
+         * @return True on success.
+         */
+        bool write(
+                _In_ const std::string &path,
+                _In_ bool clearEvents);
+
+    public:
+
+        /**
+         * @brief Gets kernel id of calling thread, used as event tid.
+         */
+        static uint64_t getThreadId();
+
+        static std::string escape(
+                _In_ const std::string &value);
+
+    private:
+
+        ChromeTrace(const ChromeTrace&);
+        ChromeTrace& operator=(const ChromeTrace&);
+
+        std::mutex m_mutex;
+
+        size_t m_maxEvents;
+
+        std::vector<ChromeTraceEvent> m_events;
+
+        size_t m_next;
+
+        uint64_t m_dropped;
+};
+
+#endif // __SYNCD_CHROME_TRACE_H__
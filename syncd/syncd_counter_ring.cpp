@@ -0,0 +1,564 @@
+#include "syncd_counter_ring.h"
+
+#include "meta/saiserialize.h"
+#include "swss/logger.h"
+
+#include <chrono>
+#include <algorithm>
+
+#include <errno.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @def COUNTER_RING_READ_RETRIES
+ *
+ * How many times reader will retry to read column table while writer is
+ * modifying it before giving up.
+ */
+#define COUNTER_RING_READ_RETRIES 64
+
+/**
+ * @def COUNTER_RING_NO_COLUMN
+ *
+ * Column index of counter which was dropped because there was no free column.
+ */
+#define COUNTER_RING_NO_COLUMN UINT32_MAX
+
+static size_t counter_ring_sample_stride(
+        _In_ uint32_t columns)
+{
+    SWSS_LOG_ENTER();
+
+    return sizeof(sai_counter_ring_sample_t) + sizeof(uint64_t) * columns;
+}
+
+static size_t counter_ring_size(
+        _In_ uint32_t columns,
+        _In_ uint32_t depth)
+{
+    SWSS_LOG_ENTER();
+
+    return sizeof(sai_counter_ring_header_t) +
+        sizeof(sai_counter_ring_column_t) * columns +
+        counter_ring_sample_stride(columns) * depth;
+}
+
+static size_t counter_ring_get_sample_offset(
+        _In_ uint32_t columns,
+        _In_ uint32_t depth,
+        _In_ uint64_t index)
+{
+    SWSS_LOG_ENTER();
+
+    return sizeof(sai_counter_ring_header_t) +
+        sizeof(sai_counter_ring_column_t) * columns +
+        counter_ring_sample_stride(columns) * (size_t)(index % depth);
+}
+
+CounterRing::CounterRing(
+        _In_ const std::string &file,
+        _In_ uint32_t columns,
+        _In_ uint32_t depth,
+        _In_ uint32_t pollIntervalMsec):
+    m_file(file),
+    m_currentSample(NULL),
+    m_currentValues(NULL),
+    m_nextColumn(0),
+    m_droppedCounters(0)
+{
+    SWSS_LOG_ENTER();
+
+    if (columns == 0 || depth < 2)
+    {
+        SWSS_LOG_THROW("invalid counter ring size: columns %u, depth %u", columns, depth);
+    }
+
+    m_size = counter_ring_size(columns, depth);
+
+    /*
+     * We are recreating file on each syncd start, readers which have old file
+     * mapped will notice that write index is not moving, and they need to
+     * reopen file.
+     */
+
+    unlink(file.c_str());
+
+    int fd = ::open(file.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0)
+    {
+        SWSS_LOG_THROW("failed to open counter ring file %s: %s", file.c_str(), strerror(errno));
+    }
+
+    if (ftruncate(fd, (off_t)m_size) != 0)
+    {
+        ::close(fd);
+
+        SWSS_LOG_THROW("failed to resize counter ring file %s to %zu: %s", file.c_str(), m_size, strerror(errno));
+    }
+
+    void *ptr = mmap(NULL, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    ::close(fd);
+
+    if (ptr == MAP_FAILED)
+    {
+        SWSS_LOG_THROW("failed to map counter ring file %s: %s", file.c_str(), strerror(errno));
+    }
+
+    m_base = (uint8_t*)ptr;
+
+    m_header = (sai_counter_ring_header_t*)m_base;
+
+    m_columns = (sai_counter_ring_column_t*)(m_base + sizeof(sai_counter_ring_header_t));
+
+    /*
+     * File is truncated so all data is zero, which means all columns are not
+     * used and all sample sequences are zero (never written).
+     */
+
+    m_header->version = SAI_COUNTER_RING_VERSION;
+    m_header->columns = columns;
+    m_header->depth = depth;
+    m_header->pollIntervalMsec = pollIntervalMsec;
+    m_header->layoutSeq.store(0);
+    m_header->writeIndex.store(0);
+
+    /*
+     * Magic is written last, so reader will not accept half initialized file.
+     */
+
+    std::atomic_thread_fence(std::memory_order_release);
+
+    m_header->magic = SAI_COUNTER_RING_MAGIC;
+
+    SWSS_LOG_NOTICE("counter ring %s created: columns %u, depth %u, size %zu",
+            file.c_str(), columns, depth, m_size);
+}
+
+CounterRing::~CounterRing()
+{
+    SWSS_LOG_ENTER();
+
+    munmap(m_base, m_size);
+}
+
+sai_counter_ring_sample_t* CounterRing::getSample(
+        _In_ uint64_t index) const
+{
+    SWSS_LOG_ENTER();
+
+    size_t offset = counter_ring_get_sample_offset(m_header->columns, m_header->depth, index);
+
+    return (sai_counter_ring_sample_t*)(m_base + offset);
+}
+
+uint64_t* CounterRing::getSampleValues(
+        _In_ sai_counter_ring_sample_t *sample) const
+{
+    SWSS_LOG_ENTER();
+
+    return (uint64_t*)((uint8_t*)sample + sizeof(sai_counter_ring_sample_t));
+}
+
+void CounterRing::beginSample()
+{
+    SWSS_LOG_ENTER();
+
+    uint64_t index = m_header->writeIndex.load(std::memory_order_relaxed);
+
+    m_currentSample = getSample(index);
+    m_currentValues = getSampleValues(m_currentSample);
+
+    m_currentSample->seq.store(2 * index + 1, std::memory_order_relaxed);
+
+    /*
+     * Odd sequence must be visible before any value of this sample changes.
+     */
+
+    std::atomic_thread_fence(std::memory_order_release);
+
+    m_currentSample->timestamp = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+    memset(m_currentValues, 0xff, sizeof(uint64_t) * m_header->columns);
+}
+
+void CounterRing::put(
+        _In_ sai_object_id_t vid,
+        _In_ sai_object_type_t objectType,
+        _In_ int32_t counterId,
+        _In_ uint64_t value)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_currentValues == NULL)
+    {
+        SWSS_LOG_THROW("put called outside of sample");
+    }
+
+    auto &counters = m_columnMap[vid];
+
+    auto it = counters.find(counterId);
+
+    if (it != counters.end())
+    {
+        if (it->second != COUNTER_RING_NO_COLUMN)
+        {
+            m_currentValues[it->second] = value;
+        }
+
+        return;
+    }
+
+    uint32_t column;
+
+    if (m_freeColumns.size())
+    {
+        column = m_freeColumns.back();
+
+        m_freeColumns.pop_back();
+    }
+    else if (m_nextColumn < m_header->columns)
+    {
+        column = m_nextColumn++;
+    }
+    else
+    {
+        /*
+         * Remember that this counter has no column, so we will not try to
+         * allocate it and log it again on each poll. It will get another
+         * chance when some column is released.
+         */
+
+        counters[counterId] = COUNTER_RING_NO_COLUMN;
+
+        m_droppedCounters++;
+
+        SWSS_LOG_WARN("no free columns in counter ring, dropping %s counter %d (%zu counters dropped)",
+                sai_serialize_object_id(vid).c_str(), counterId, m_droppedCounters);
+
+        return;
+    }
+
+    uint64_t seq = m_header->layoutSeq.load(std::memory_order_relaxed);
+
+    m_header->layoutSeq.store(seq + 1, std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_release);
+
+    m_columns[column].vid = vid;
+    m_columns[column].objectType = objectType;
+    m_columns[column].counterId = counterId;
+
+    /*
+     * Column could be used by removed object, clear its history, so readers
+     * will not report old values under new (VID, counter id).
+     */
+
+    for (uint32_t idx = 0; idx < m_header->depth; idx++)
+    {
+        sai_counter_ring_sample_t *sample = getSample(idx);
+
+        if (sample != m_currentSample)
+        {
+            getSampleValues(sample)[column] = SAI_COUNTER_RING_NO_VALUE;
+        }
+    }
+
+    m_header->layoutSeq.store(seq + 2, std::memory_order_release);
+
+    counters[counterId] = column;
+
+    m_currentValues[column] = value;
+}
+
+void CounterRing::commitSample()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_currentSample == NULL)
+    {
+        SWSS_LOG_THROW("commit called outside of sample");
+    }
+
+    uint64_t index = m_header->writeIndex.load(std::memory_order_relaxed);
+
+    m_currentSample->seq.store(2 * index + 2, std::memory_order_release);
+
+    m_header->writeIndex.store(index + 1, std::memory_order_release);
+
+    m_currentSample = NULL;
+    m_currentValues = NULL;
+}
+
+void CounterRing::removeObject(
+        _In_ sai_object_id_t vid)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = m_columnMap.find(vid);
+
+    if (it == m_columnMap.end())
+    {
+        return;
+    }
+
+    uint64_t seq = m_header->layoutSeq.load(std::memory_order_relaxed);
+
+    m_header->layoutSeq.store(seq + 1, std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (const auto &kv: it->second)
+    {
+        if (kv.second == COUNTER_RING_NO_COLUMN)
+        {
+            m_droppedCounters--;
+            continue;
+        }
+
+        m_columns[kv.second].vid = SAI_NULL_OBJECT_ID;
+
+        m_freeColumns.push_back(kv.second);
+    }
+
+    m_header->layoutSeq.store(seq + 2, std::memory_order_release);
+
+    m_columnMap.erase(it);
+
+    if (m_droppedCounters == 0 || m_freeColumns.empty())
+    {
+        return;
+    }
+
+    /*
+     * Columns were released, let dropped counters try to get column again.
+     */
+
+    for (auto &ov: m_columnMap)
+    {
+        for (auto cit = ov.second.begin(); cit != ov.second.end();)
+        {
+            if (cit->second == COUNTER_RING_NO_COLUMN)
+            {
+                cit = ov.second.erase(cit);
+
+                m_droppedCounters--;
+            }
+            else
+            {
+                ++cit;
+            }
+        }
+    }
+}
+
+CounterRingReader::CounterRingReader():
+    m_size(0),
+    m_base(NULL),
+    m_header(NULL)
+{
+    SWSS_LOG_ENTER();
+
+    // empty
+}
+
+CounterRingReader::~CounterRingReader()
+{
+    SWSS_LOG_ENTER();
+
+    close();
+}
+
+bool CounterRingReader::open(
+        _In_ const std::string &file)
+{
+    SWSS_LOG_ENTER();
+
+    close();
+
+    int fd = ::open(file.c_str(), O_RDONLY);
+
+    if (fd < 0)
+    {
+        SWSS_LOG_ERROR("failed to open counter ring file %s: %s", file.c_str(), strerror(errno));
+        return false;
+    }
+
+    struct stat st;
+
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(sai_counter_ring_header_t))
+    {
+        SWSS_LOG_ERROR("counter ring file %s is too small", file.c_str());
+
+        ::close(fd);
+        return false;
+    }
+
+    void *ptr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+    ::close(fd);
+
+    if (ptr == MAP_FAILED)
+    {
+        SWSS_LOG_ERROR("failed to map counter ring file %s: %s", file.c_str(), strerror(errno));
+        return false;
+    }
+
+    m_base = (const uint8_t*)ptr;
+    m_size = (size_t)st.st_size;
+    m_header = (const sai_counter_ring_header_t*)m_base;
+
+    if (m_header->magic != SAI_COUNTER_RING_MAGIC ||
+            m_header->version != SAI_COUNTER_RING_VERSION ||
+            counter_ring_size(m_header->columns, m_header->depth) != m_size)
+    {
+        SWSS_LOG_ERROR("counter ring file %s has invalid header", file.c_str());
+
+        close();
+        return false;
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    return true;
+}
+
+void CounterRingReader::close()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_base != NULL)
+    {
+        munmap((void*)const_cast<uint8_t*>(m_base), m_size);
+    }
+
+    m_base = NULL;
+    m_header = NULL;
+    m_size = 0;
+}
+
+uint32_t CounterRingReader::getPollIntervalMsec() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_header->pollIntervalMsec;
+}
+
+uint64_t CounterRingReader::getWriteIndex() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_header->writeIndex.load(std::memory_order_acquire);
+}
+
+std::vector<sai_counter_ring_column_t> CounterRingReader::getColumns() const
+{
+    SWSS_LOG_ENTER();
+
+    const sai_counter_ring_column_t *columns =
+        (const sai_counter_ring_column_t*)(m_base + sizeof(sai_counter_ring_header_t));
+
+    std::vector<sai_counter_ring_column_t> copy(m_header->columns);
+
+    for (int retry = 0; retry < COUNTER_RING_READ_RETRIES; retry++)
+    {
+        uint64_t seq = m_header->layoutSeq.load(std::memory_order_acquire);
+
+        if (seq & 1)
+        {
+            continue;
+        }
+
+        memcpy(copy.data(), columns, sizeof(sai_counter_ring_column_t) * copy.size());
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (seq == m_header->layoutSeq.load(std::memory_order_relaxed))
+        {
+            return copy;
+        }
+    }
+
+    SWSS_LOG_THROW("failed to read consistent counter ring columns after %d retries", COUNTER_RING_READ_RETRIES);
+}
+
+bool CounterRingReader::readSample(
+        _In_ uint64_t index,
+        _Out_ Sample &sample) const
+{
+    SWSS_LOG_ENTER();
+
+    uint32_t columns = m_header->columns;
+    uint32_t depth = m_header->depth;
+
+    uint64_t writeIndex = getWriteIndex();
+
+    /*
+     * Oldest sample slot can be overwritten right now by writer, so only
+     * depth - 1 samples are available for reading.
+     */
+
+    if (index >= writeIndex || index + depth - 1 < writeIndex)
+    {
+        return false;
+    }
+
+    size_t offset = counter_ring_get_sample_offset(columns, depth, index);
+
+    const sai_counter_ring_sample_t *s = (const sai_counter_ring_sample_t*)(m_base + offset);
+
+    uint64_t seq = s->seq.load(std::memory_order_acquire);
+
+    if (seq != 2 * index + 2)
+    {
+        return false;
+    }
+
+    sample.index = index;
+    sample.timestamp = s->timestamp;
+    sample.values.resize(columns);
+
+    memcpy(sample.values.data(), (const uint8_t*)s + sizeof(sai_counter_ring_sample_t), sizeof(uint64_t) * columns);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    return seq == s->seq.load(std::memory_order_relaxed);
+}
+
+std::vector<CounterRingReader::Sample> CounterRingReader::readHistory(
+        _In_ uint64_t msec) const
+{
+    SWSS_LOG_ENTER();
+
+    uint64_t interval = m_header->pollIntervalMsec ? m_header->pollIntervalMsec : 1;
+
+    uint64_t count = std::max((uint64_t)1, msec / interval);
+
+    count = std::min(count, (uint64_t)m_header->depth - 1);
+
+    uint64_t writeIndex = getWriteIndex();
+
+    count = std::min(count, writeIndex);
+
+    std::vector<Sample> samples;
+
+    samples.reserve((size_t)count);
+
+    for (uint64_t index = writeIndex - count; index < writeIndex; index++)
+    {
+        Sample sample;
+
+        if (readSample(index, sample))
+        {
+            samples.push_back(std::move(sample));
+        }
+    }
+
+    return samples;
+}
@@ -0,0 +1,296 @@
+#ifndef __SYNCD_COUNTER_RING_H__
+#define __SYNCD_COUNTER_RING_H__
+
+extern "C" {
+#include "sai.h"
+}
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+/**
+ * @def SAI_COUNTER_RING_MAGIC
+ *
+ * Magic value at the beginning of counter ring file ("SAICNTRG").
+ */
+#define SAI_COUNTER_RING_MAGIC          0x4752544e43494153UL
+
+#define SAI_COUNTER_RING_VERSION        1
+
+#define SAI_COUNTER_RING_DEFAULT_FILE   "/dev/shm/syncd_counters_ring"
+
+/**
+ * @def SAI_COUNTER_RING_DEFAULT_COLUMNS
+ *
+ * Default number of (object VID, counter id) columns that can be published in
+ * ring. This should be enough for 64 ports with all PFC WD counters and 16
+ * queues per port.
+ */
+#define SAI_COUNTER_RING_DEFAULT_COLUMNS    8192
+
+/**
+ * @def SAI_COUNTER_RING_DEFAULT_DEPTH
+ *
+ * Default number of samples kept in ring, with 100 ms flex counter poll this
+ * is 60 seconds of history.
+ */
+#define SAI_COUNTER_RING_DEFAULT_DEPTH      600
+
+/**
+ * @def SAI_COUNTER_RING_NO_VALUE
+ *
+ * Value put into column which was not sampled in given poll (for example
+ * object failed to return stats or column is not used yet).
+ */
+#define SAI_COUNTER_RING_NO_VALUE           UINT64_MAX
+
+/*
+ * Binary layout of the ring file (all fields are host endian, file is
+ * intended to be shared only between processes on the same box):
+ *
+ * +------------------------------+
+ * | sai_counter_ring_header_t    |
+ * +------------------------------+
+ * | sai_counter_ring_column_t    | x header.columns
+ * +------------------------------+
+ * | sai_counter_ring_sample_t    | x header.depth, each followed by
+ * | uint64_t values[columns]     |   header.columns values
+ * +------------------------------+
+ *
+ * Samples are protected by seqlock. Writer sets sample sequence to odd value
+ * (2 * index + 1) before writing values and to even value (2 * index + 2)
+ * after. Reader copies values and checks if sequence didn't change, this way
+ * reader is not doing any syscall per sample and it never blocks writer.
+ *
+ * Columns are protected by layout seqlock in the same way, column is assigned
+ * to (VID, counter id) pair when it's first published and it's not moved until
+ * object is removed from flex counter, so readers need to re-read column table
+ * only when layout sequence changes.
+ */
+
+typedef struct _sai_counter_ring_header_t
+{
+    uint64_t magic;
+
+    uint32_t version;
+
+    uint32_t columns;
+
+    uint32_t depth;
+
+    uint32_t pollIntervalMsec;
+
+    /**
+     * @brief Layout seqlock, odd when column table is being modified.
+     */
+    std::atomic<uint64_t> layoutSeq;
+
+    /**
+     * @brief Index of next sample to be written (total samples written).
+     */
+    std::atomic<uint64_t> writeIndex;
+
+} sai_counter_ring_header_t;
+
+typedef struct _sai_counter_ring_column_t
+{
+    /**
+     * @brief Object VID, SAI_NULL_OBJECT_ID if column is not used.
+     */
+    sai_object_id_t vid;
+
+    /**
+     * @brief Object type of VID, used to interpret counter id.
+     */
+    int32_t objectType;
+
+    /**
+     * @brief Counter id, sai_port_stat_t or sai_queue_stat_t etc.
+     */
+    int32_t counterId;
+
+} sai_counter_ring_column_t;
+
+typedef struct _sai_counter_ring_sample_t
+{
+    /**
+     * @brief Sample seqlock.
+     */
+    std::atomic<uint64_t> seq;
+
+    /**
+     * @brief Time of poll in nanoseconds since epoch.
+     */
+    uint64_t timestamp;
+
+} sai_counter_ring_sample_t;
+
+/**
+ * @brief Counter ring writer.
+ *
+ * Used by flex counter thread to publish each poll into memory mapped ring
+ * buffer. This class is not thread safe, it's intended to have only one
+ * writer.
+ */
+class CounterRing
+{
+    public:
+
+        CounterRing(
+                _In_ const std::string &file,
+                _In_ uint32_t columns,
+                _In_ uint32_t depth,
+                _In_ uint32_t pollIntervalMsec);
+
+        virtual ~CounterRing();
+
+    public:
+
+        /**
+         * @brief Starts new sample, all columns are reset to no value.
+         */
+        void beginSample();
+
+        /**
+         * @brief Puts single counter value into current sample.
+         *
+         * If (VID, counter id) pair is not yet present in column table, new
+         * column is assigned and its history is cleared. If there are no
+         * free columns, value is dropped and warning is logged only once for
+         * given pair, until some column is released.
+         */
+        void put(
+                _In_ sai_object_id_t vid,
+                _In_ sai_object_type_t objectType,
+                _In_ int32_t counterId,
+                _In_ uint64_t value);
+
+        /**
+         * @brief Publishes current sample to readers.
+         */
+        void commitSample();
+
+        /**
+         * @brief Releases all columns assigned to given object VID.
+         */
+        void removeObject(
+                _In_ sai_object_id_t vid);
+
+    private:
+
+        CounterRing(const CounterRing&);
+        CounterRing& operator=(const CounterRing&);
+
+        uint64_t* getSampleValues(
+                _In_ sai_counter_ring_sample_t *sample) const;
+
+        sai_counter_ring_sample_t* getSample(
+                _In_ uint64_t index) const;
+
+        std::string m_file;
+
+        size_t m_size;
+
+        uint8_t *m_base;
+
+        sai_counter_ring_header_t *m_header;
+
+        sai_counter_ring_column_t *m_columns;
+
+        sai_counter_ring_sample_t *m_currentSample;
+
+        uint64_t *m_currentValues;
+
+        /**
+         * @brief Map of (VID, counter id) to column index.
+         */
+        std::unordered_map<sai_object_id_t, std::unordered_map<int32_t, uint32_t>> m_columnMap;
+
+        std::vector<uint32_t> m_freeColumns;
+
+        uint32_t m_nextColumn;
+
+        /**
+         * @brief Number of (VID, counter id) pairs which have no column.
+         */
+        size_t m_droppedCounters;
+};
+
+/**
+ * @brief Counter ring reader.
+ *
+ * Maps ring file read only, after open, all reads are performed on shared
+ * memory only.
+ */
+class CounterRingReader
+{
+    public:
+
+        typedef struct _Sample
+        {
+            uint64_t index;
+
+            uint64_t timestamp;
+
+            std::vector<uint64_t> values;
+
+        } Sample;
+
+        CounterRingReader();
+
+        virtual ~CounterRingReader();
+
+    public:
+
+        /**
+         * @brief Opens and maps ring file.
+         *
+         * @return True on success, false when file is missing or invalid.
+         */
+        bool open(
+                _In_ const std::string &file);
+
+        void close();
+
+        uint32_t getPollIntervalMsec() const;
+
+        uint64_t getWriteIndex() const;
+
+        /**
+         * @brief Gets consistent copy of column table.
+         */
+        std::vector<sai_counter_ring_column_t> getColumns() const;
+
+        /**
+         * @brief Reads single sample by index.
+         *
+         * @return False if sample was already overwritten, not yet written or
+         * writer was modifying it during retries.
+         */
+        bool readSample(
+                _In_ uint64_t index,
+                _Out_ Sample &sample) const;
+
+        /**
+         * @brief Reads last samples covering given number of milliseconds.
+         *
+         * Samples that were overwritten during read are skipped.
+         */
+        std::vector<Sample> readHistory(
+                _In_ uint64_t msec) const;
+
+    private:
+
+        CounterRingReader(const CounterRingReader&);
+        CounterRingReader& operator=(const CounterRingReader&);
+
+        size_t m_size;
+
+        const uint8_t *m_base;
+
+        const sai_counter_ring_header_t *m_header;
+};
+
+#endif // __SYNCD_COUNTER_RING_H__
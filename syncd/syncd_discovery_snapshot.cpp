@@ -0,0 +1,259 @@
+#include "syncd_discovery_snapshot.h"
+
+#include "swss/logger.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+DiscoverySnapshot::DiscoverySnapshot()
+{
+    SWSS_LOG_ENTER();
+
+    memset(defaultMacAddress, 0, sizeof(defaultMacAddress));
+}
+
+template <typename T>
+static void writeValue(
+        _Inout_ std::ofstream &out,
+        _In_ const T &value)
+{
+    SWSS_LOG_ENTER();
+
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+static bool readValue(
+        _Inout_ std::ifstream &in,
+        _Out_ T &value)
+{
+    SWSS_LOG_ENTER();
+
+    in.read(reinterpret_cast<char*>(&value), sizeof(value));
+
+    return in.good();
+}
+
+static bool readString(
+        _Inout_ std::ifstream &in,
+        _Out_ std::string &value)
+{
+    SWSS_LOG_ENTER();
+
+    uint32_t size;
+
+    if (!readValue(in, size))
+    {
+        return false;
+    }
+
+    value.resize(size);
+
+    if (size)
+    {
+        in.read(&value[0], size);
+    }
+
+    return in.good();
+}
+
+bool DiscoverySnapshot::load(
+        _In_ const std::string &path,
+        _In_ const std::string &expectedKey)
+{
+    SWSS_LOG_ENTER();
+
+    std::ifstream in(path, std::ifstream::in | std::ifstream::binary);
+
+    if (!in.is_open())
+    {
+        SWSS_LOG_NOTICE("discovery snapshot %s not present", path.c_str());
+
+        return false;
+    }
+
+    char magic[sizeof(SYNCD_DISCOVERY_SNAPSHOT_MAGIC) - 1];
+
+    uint32_t version = 0;
+
+    in.read(magic, sizeof(magic));
+
+    if (!in.good() || memcmp(magic, SYNCD_DISCOVERY_SNAPSHOT_MAGIC, sizeof(magic)) != 0)
+    {
+        SWSS_LOG_WARN("discovery snapshot %s is not valid snapshot file", path.c_str());
+
+        return false;
+    }
+
+    if (!readValue(in, version) || version != SYNCD_DISCOVERY_SNAPSHOT_VERSION)
+    {
+        SWSS_LOG_NOTICE("discovery snapshot %s version %u is not supported", path.c_str(), version);
+
+        return false;
+    }
+
+    if (!readString(in, key) || key != expectedKey)
+    {
+        SWSS_LOG_NOTICE("discovery snapshot %s key don't match, hardware or configuration changed", path.c_str());
+
+        return false;
+    }
+
+    discoveredRids.clear();
+    defaultOidMap.clear();
+    laneMap.clear();
+
+    uint64_t count;
+
+    if (!readValue(in, count))
+    {
+        return false;
+    }
+
+    for (uint64_t idx = 0; idx < count; idx++)
+    {
+        sai_object_id_t rid;
+
+        if (!readValue(in, rid))
+        {
+            return false;
+        }
+
+        discoveredRids.insert(rid);
+    }
+
+    if (!readValue(in, count))
+    {
+        return false;
+    }
+
+    for (uint64_t idx = 0; idx < count; idx++)
+    {
+        sai_object_id_t rid;
+        sai_attr_id_t attrId;
+        sai_object_id_t oid;
+
+        if (!readValue(in, rid) || !readValue(in, attrId) || !readValue(in, oid))
+        {
+            return false;
+        }
+
+        defaultOidMap[rid][attrId] = oid;
+    }
+
+    if (!readValue(in, count))
+    {
+        return false;
+    }
+
+    for (uint64_t idx = 0; idx < count; idx++)
+    {
+        sai_uint32_t lane;
+        sai_object_id_t portRid;
+
+        if (!readValue(in, lane) || !readValue(in, portRid))
+        {
+            return false;
+        }
+
+        laneMap[lane] = portRid;
+    }
+
+    if (!readValue(in, defaultMacAddress))
+    {
+        return false;
+    }
+
+    SWSS_LOG_NOTICE("loaded discovery snapshot %s: %zu objects, %zu lanes",
+            path.c_str(),
+            discoveredRids.size(),
+            laneMap.size());
+
+    return true;
+}
+
+bool DiscoverySnapshot::save(
+        _In_ const std::string &path) const
+{
+    SWSS_LOG_ENTER();
+
+    std::string tmpPath = path + ".tmp";
+
+    std::ofstream out(tmpPath, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+
+    if (!out.is_open())
+    {
+        SWSS_LOG_ERROR("failed to open discovery snapshot %s", tmpPath.c_str());
+
+        return false;
+    }
+
+    out.write(SYNCD_DISCOVERY_SNAPSHOT_MAGIC, sizeof(SYNCD_DISCOVERY_SNAPSHOT_MAGIC) - 1);
+
+    writeValue(out, (uint32_t)SYNCD_DISCOVERY_SNAPSHOT_VERSION);
+
+    writeValue(out, (uint32_t)key.size());
+
+    out.write(key.data(), (std::streamsize)key.size());
+
+    writeValue(out, (uint64_t)discoveredRids.size());
+
+    for (sai_object_id_t rid: discoveredRids)
+    {
+        writeValue(out, rid);
+    }
+
+    uint64_t count = 0;
+
+    for (const auto &kvp: defaultOidMap)
+    {
+        count += kvp.second.size();
+    }
+
+    writeValue(out, count);
+
+    for (const auto &kvp: defaultOidMap)
+    {
+        for (const auto &attr: kvp.second)
+        {
+            writeValue(out, kvp.first);
+            writeValue(out, attr.first);
+            writeValue(out, attr.second);
+        }
+    }
+
+    writeValue(out, (uint64_t)laneMap.size());
+
+    for (const auto &kvp: laneMap)
+    {
+        writeValue(out, kvp.first);
+        writeValue(out, kvp.second);
+    }
+
+    writeValue(out, defaultMacAddress);
+
+    out.close();
+
+    if (out.fail())
+    {
+        SWSS_LOG_ERROR("failed to write discovery snapshot %s", tmpPath.c_str());
+
+        return false;
+    }
+
+    if (rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        SWSS_LOG_ERROR("failed to rename %s to %s: %s", tmpPath.c_str(), path.c_str(), strerror(errno));
+
+        return false;
+    }
+
+    SWSS_LOG_NOTICE("saved discovery snapshot %s: %zu objects, %zu lanes",
+            path.c_str(),
+            discoveredRids.size(),
+            laneMap.size());
+
+    return true;
+}
@@ -0,0 +1,79 @@
+#ifndef __SYNCD_DISCOVERY_SNAPSHOT_H__
+#define __SYNCD_DISCOVERY_SNAPSHOT_H__
+
+extern "C" {
+#include "sai.h"
+}
+
+#include <set>
+#include <string>
+#include <unordered_map>
+
+#define SYNCD_DISCOVERY_SNAPSHOT_MAGIC      "SYNCDDSS"
+
+/**
+ * @def SYNCD_DISCOVERY_SNAPSHOT_VERSION
+ *
+ * Version of snapshot file format, must be increased on every format change,
+ * snapshots with different version are ignored.
+ */
+#define SYNCD_DISCOVERY_SNAPSHOT_VERSION    2
+
+/**
+ * @brief Result of switch discovery persisted between syncd starts.
+ *
+ * Snapshot is valid only for the same key, which is composed of everything
+ * that can change discovered objects, like hardware info, SAI library and
+ * profile/port map.
+ *
+ * File is binary: magic, version, key, and then discovered RIDs, default OID
+ * map and lane map as counts followed by fixed size records in host byte order,
+ * and default MAC address.
+ *
+ * Same format is used to persist existing objects of switch for warm restart.
+ */
+class DiscoverySnapshot
+{
+    public:
+
+        DiscoverySnapshot();
+
+        virtual ~DiscoverySnapshot() = default;
+
+    public:
+
+        /**
+         * @brief Loads snapshot from file.
+         *
+         * @param path Snapshot file.
+         * @param expectedKey Expected snapshot key.
+         *
+         * @return True if file exists, is not corrupted and key matches.
+         */
+        bool load(
+                _In_ const std::string &path,
+                _In_ const std::string &expectedKey);
+
+        /**
+         * @brief Saves snapshot to file.
+         *
+         * Snapshot is written to temporary file which is then renamed, so
+         * crash during save will not leave corrupted snapshot.
+         */
+        bool save(
+                _In_ const std::string &path) const;
+
+    public:
+
+        std::string key;
+
+        std::set<sai_object_id_t> discoveredRids;
+
+        std::unordered_map<sai_object_id_t, std::unordered_map<sai_attr_id_t, sai_object_id_t>> defaultOidMap;
+
+        std::unordered_map<sai_uint32_t, sai_object_id_t> laneMap;
+
+        sai_mac_t defaultMacAddress;
+};
+
+#endif // __SYNCD_DISCOVERY_SNAPSHOT_H__
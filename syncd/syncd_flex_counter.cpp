@@ -1,8 +1,28 @@
 #include "syncd_flex_counter.h"
 #include "syncd.h"
 #include "swss/redisapi.h"
+#include "syncd_bulk_stats.h"
 
-#define FLEX_COUNTER_POLL_MSECS 100
+#include <algorithm>
+#include <chrono>
+
+#define FLEX_COUNTER_DEFAULT_POLL_MSECS 100
+
+#define FLEX_COUNTER_STATS_TABLE                "FLEX_COUNTER_STATS"
+#define FLEX_COUNTER_STATS_POLL_DURATION        "POLL_DURATION_USEC"
+#define FLEX_COUNTER_STATS_POLL_SAI_DURATION    "POLL_SAI_DURATION_USEC"
+
+#define FLEX_COUNTER_STATS_ADAPTIVE_POLLING     "ADAPTIVE_POLLING"
+
+// Publish poll duration histograms once per second
+#define FLEX_COUNTER_STATS_PUBLISH_MSECS        1000
+
+// Time without value change after which object poll interval starts to back
+// off
+#define FLEX_COUNTER_ADAPTIVE_IDLE_MSECS        1000
+
+// Maximum number of objects in single vendor bulk stats call
+#define FLEX_COUNTER_BULK_SIZE                  64
 
 FlexCounter::PortCounterIds::PortCounterIds(
         _In_ sai_object_id_t port,
@@ -25,6 +45,14 @@ FlexCounter::QueueAttrIds::QueueAttrIds(
 {
 }
 
+FlexCounter::ObjectCounterIds::ObjectCounterIds(
+        _In_ sai_object_id_t object,
+        _In_ const std::vector<int32_t> &objectIds,
+        _In_ bool clear):
+    objectId(object), objectCounterIds(objectIds), readAndClear(clear)
+{
+}
+
 void FlexCounter::setPortCounterList(
         _In_ sai_object_id_t portVid,
         _In_ sai_object_id_t portId,
@@ -67,6 +95,11 @@ void FlexCounter::setQueueCounterList(
     auto queueCounterIds = std::make_shared<QueueCounterIds>(queueId, counterIds);
     fc.m_queueCounterIdsMap.emplace(queueVid, queueCounterIds);
 
+    if (fc.m_adaptiveMaxPolls > 1)
+    {
+        fc.addQueuePort(queueVid, queueId);
+    }
+
     // Start flex counter thread in case it was not running due to empty counter IDs map
     fc.startFlexCounterThread();
 }
@@ -90,11 +123,51 @@ void FlexCounter::setQueueAttrList(
     auto queueAttrIds = std::make_shared<QueueAttrIds>(queueId, attrIds);
     fc.m_queueAttrIdsMap.emplace(queueVid, queueAttrIds);
 
+    if (fc.m_adaptiveMaxPolls > 1)
+    {
+        fc.addQueuePort(queueVid, queueId);
+    }
+
     // Start flex counter thread in case it was not running due to empty counter IDs map
     fc.startFlexCounterThread();
 }
 
 
+void FlexCounter::setObjectCounterList(
+        _In_ sai_object_type_t objectType,
+        _In_ sai_object_id_t vid,
+        _In_ sai_object_id_t rid,
+        _In_ const std::vector<int32_t> &counterIds,
+        _In_ bool readAndClear)
+{
+    SWSS_LOG_ENTER();
+
+    if (BulkStats::getStatsEnumMetadata(objectType) == NULL)
+    {
+        SWSS_LOG_ERROR("Stats are not supported on %s",
+                sai_serialize_object_type(objectType).c_str());
+        return;
+    }
+
+    FlexCounter &fc = getInstance();
+
+    auto &objectMap = fc.m_objectCounterIdsMap[objectType];
+
+    auto it = objectMap.find(vid);
+    if (it != objectMap.end())
+    {
+        (*it).second->objectCounterIds = counterIds;
+        (*it).second->readAndClear = readAndClear;
+        return;
+    }
+
+    auto objectCounterIds = std::make_shared<ObjectCounterIds>(rid, counterIds, readAndClear);
+    objectMap.emplace(vid, objectCounterIds);
+
+    // Start flex counter thread in case it was not running due to empty counter IDs map
+    fc.startFlexCounterThread();
+}
+
 void FlexCounter::removePort(
         _In_ sai_object_id_t portVid)
 {
@@ -111,8 +184,15 @@ void FlexCounter::removePort(
 
     fc.m_portCounterIdsMap.erase(it);
 
+    fc.m_adaptivePollState.erase(AdaptivePollKey(COLLECT_PORT_STATS, portVid));
+
+    if (fc.m_counterRing != nullptr)
+    {
+        fc.m_counterRing->removeObject(portVid);
+    }
+
     // Stop flex counter thread if counter IDs map is empty
-    if (fc.m_queueCounterIdsMap.empty() && fc.m_portCounterIdsMap.empty() && fc.m_queueAttrIdsMap.empty())
+    if (fc.isEmpty())
     {
         fc.endFlexCounterThread();
     }
@@ -134,6 +214,15 @@ void FlexCounter::removeQueue(
 
     fc.m_queueCounterIdsMap.erase(counterIter);
 
+    fc.m_adaptivePollState.erase(AdaptivePollKey(COLLECT_QUEUE_STATS, queueVid));
+    fc.m_adaptivePollState.erase(AdaptivePollKey(COLLECT_QUEUE_ATTRS, queueVid));
+    fc.m_queuePortMap.erase(queueVid);
+
+    if (fc.m_counterRing != nullptr)
+    {
+        fc.m_counterRing->removeObject(queueVid);
+    }
+
     auto attrIter = fc.m_queueAttrIdsMap.find(queueVid);
     if (attrIter == fc.m_queueAttrIdsMap.end())
     {
@@ -144,12 +233,105 @@ void FlexCounter::removeQueue(
     fc.m_queueAttrIdsMap.erase(attrIter);
 
     // Stop flex counter thread if counter IDs map is empty
-    if (fc.m_queueCounterIdsMap.empty() && fc.m_portCounterIdsMap.empty() && fc.m_queueAttrIdsMap.empty())
+    if (fc.isEmpty())
+    {
+        fc.endFlexCounterThread();
+    }
+}
+
+void FlexCounter::removeObject(
+        _In_ sai_object_type_t objectType,
+        _In_ sai_object_id_t vid)
+{
+    SWSS_LOG_ENTER();
+
+    FlexCounter &fc = getInstance();
+
+    auto &objectMap = fc.m_objectCounterIdsMap[objectType];
+
+    auto it = objectMap.find(vid);
+    if (it == objectMap.end())
+    {
+        SWSS_LOG_ERROR("Trying to remove nonexisting %s counter Ids 0x%lx",
+                sai_serialize_object_type(objectType).c_str(), vid);
+        return;
+    }
+
+    objectMap.erase(it);
+
+    fc.m_adaptivePollState.erase(AdaptivePollKey(COLLECT_OBJECT_STATS, vid));
+
+    if (fc.m_counterRing != nullptr)
+    {
+        fc.m_counterRing->removeObject(vid);
+    }
+
+    // Stop flex counter thread if counter IDs map is empty
+    if (fc.isEmpty())
     {
         fc.endFlexCounterThread();
     }
 }
 
+void FlexCounter::removeCounters(
+        _In_ sai_object_type_t objectType,
+        _In_ sai_object_id_t vid)
+{
+    SWSS_LOG_ENTER();
+
+    FlexCounter &fc = getInstance();
+
+    bool found = false;
+
+    /*
+     * Port and queue can be registered by generic counter id list as well
+     * as by legacy lists, legacy remove is used only when object was
+     * registered legacy way.
+     */
+
+    if (isObjectRegistered(objectType, vid))
+    {
+        removeObject(objectType, vid);
+
+        found = true;
+    }
+
+    if (objectType == SAI_OBJECT_TYPE_PORT && fc.m_portCounterIdsMap.find(vid) != fc.m_portCounterIdsMap.end())
+    {
+        removePort(vid);
+
+        found = true;
+    }
+
+    if (objectType == SAI_OBJECT_TYPE_QUEUE &&
+            (fc.m_queueCounterIdsMap.find(vid) != fc.m_queueCounterIdsMap.end() ||
+             fc.m_queueAttrIdsMap.find(vid) != fc.m_queueAttrIdsMap.end()))
+    {
+        removeQueue(vid);
+
+        found = true;
+    }
+
+    if (!found)
+    {
+        SWSS_LOG_ERROR("Trying to remove nonexisting %s counters 0x%lx",
+                sai_serialize_object_type(objectType).c_str(), vid);
+    }
+}
+
+bool FlexCounter::isObjectRegistered(
+        _In_ sai_object_type_t objectType,
+        _In_ sai_object_id_t vid)
+{
+    SWSS_LOG_ENTER();
+
+    FlexCounter &fc = getInstance();
+
+    auto it = fc.m_objectCounterIdsMap.find(objectType);
+
+    return it != fc.m_objectCounterIdsMap.end() && it->second.find(vid) != it->second.end();
+}
+
 void FlexCounter::addPortCounterPlugin(
         _In_ std::string sha)
 {
@@ -195,141 +377,621 @@ void FlexCounter::removeCounterPlugin(
     fc.m_portPlugins.erase(sha);
 }
 
-FlexCounter::~FlexCounter(void)
+void FlexCounter::enableCounterRing(
+        _In_ const std::string &file)
 {
-    endFlexCounterThread();
+    SWSS_LOG_ENTER();
+
+    FlexCounter &fc = getInstance();
+
+    fc.m_counterRing = std::make_shared<CounterRing>(
+            file,
+            SAI_COUNTER_RING_DEFAULT_COLUMNS,
+            SAI_COUNTER_RING_DEFAULT_DEPTH,
+            fc.m_pollIntervalMsec);
+
+    SWSS_LOG_NOTICE("flex counter ring enabled: %s", file.c_str());
 }
 
-FlexCounter::FlexCounter(void)
+void FlexCounter::setPollInterval(
+        _In_ uint32_t pollIntervalMsec)
 {
+    SWSS_LOG_ENTER();
+
+    FlexCounter &fc = getInstance();
+
+    fc.m_pollIntervalMsec = pollIntervalMsec ? pollIntervalMsec : FLEX_COUNTER_DEFAULT_POLL_MSECS;
+
+    SWSS_LOG_NOTICE("flex counter poll interval set to %u ms", fc.m_pollIntervalMsec);
 }
 
-FlexCounter& FlexCounter::getInstance(void)
+void FlexCounter::setCollectConcurrency(
+        _In_ uint32_t concurrency)
 {
-    static FlexCounter fc;
+    SWSS_LOG_ENTER();
 
-    return fc;
+    FlexCounter &fc = getInstance();
+
+    fc.m_collectConcurrency = concurrency ? concurrency : 1;
+
+    SWSS_LOG_NOTICE("flex counter collect concurrency set to %u", fc.m_collectConcurrency);
 }
 
-void FlexCounter::collectCounters(
-        _In_ swss::Table &countersTable)
+void FlexCounter::setAdaptivePolling(
+        _In_ uint32_t maxIntervalMsec)
 {
     SWSS_LOG_ENTER();
 
-    // Collect stats for every registered port
-    for (const auto &kv: m_portCounterIdsMap)
+    FlexCounter &fc = getInstance();
+
+    fc.m_adaptiveMaxPolls = std::max(1u, maxIntervalMsec / fc.m_pollIntervalMsec);
+
+    fc.m_adaptivePollState.clear();
+
+    if (fc.m_adaptiveMaxPolls > 1)
     {
-        const auto &portVid = kv.first;
-        const auto &portId = kv.second->portId;
-        const auto &portCounterIds = kv.second->portCounterIds;
+        /*
+         * Queues registered while adaptive polling was disabled don't have
+         * port resolved yet.
+         */
 
-        std::vector<uint64_t> portStats(portCounterIds.size());
+        for (const auto &kv: fc.m_queueCounterIdsMap)
+        {
+            fc.addQueuePort(kv.first, kv.second->queueId);
+        }
 
-        // Get port stats for queue
-        sai_status_t status = sai_metadata_sai_port_api->get_port_stats(
-                portId,
-                static_cast<uint32_t>(portCounterIds.size()),
-                portCounterIds.data(),
-                portStats.data());
-        if (status != SAI_STATUS_SUCCESS)
+        for (const auto &kv: fc.m_queueAttrIdsMap)
+        {
+            fc.addQueuePort(kv.first, kv.second->queueId);
+        }
+    }
+
+    SWSS_LOG_NOTICE("flex counter adaptive polling max interval set to %u ms (%u polls)",
+            maxIntervalMsec, fc.m_adaptiveMaxPolls);
+}
+
+void FlexCounter::updatePortOperStatus(
+        _In_ sai_object_id_t portRid,
+        _In_ sai_port_oper_status_t status)
+{
+    SWSS_LOG_ENTER();
+
+    FlexCounter &fc = getInstance();
+
+    if (fc.m_adaptiveMaxPolls <= 1)
+    {
+        return;
+    }
+
+    bool up = (status == SAI_PORT_OPER_STATUS_UP);
+
+    if (up)
+    {
+        fc.m_operDownPorts.erase(portRid);
+    }
+    else
+    {
+        fc.m_operDownPorts.insert(portRid);
+    }
+
+    for (auto &kv: fc.m_adaptivePollState)
+    {
+        AdaptivePollState &state = kv.second;
+
+        if (state.portRid != portRid)
         {
-            SWSS_LOG_ERROR("Failed to get stats of port 0x%lx: %d", portId, status);
             continue;
         }
 
-        // Push all counter values to a single vector
-        std::vector<swss::FieldValueTuple> values;
+        if (up)
+        {
+            /*
+             * Port went up, poll port and its queues at full rate starting
+             * from next poll.
+             */
+
+            state.interval = 1;
+            state.countdown = 0;
+            state.unchangedPolls = 0;
+        }
+        else
+        {
+            state.interval = fc.m_adaptiveMaxPolls;
+        }
+    }
+
+    SWSS_LOG_INFO("port 0x%lx oper status %d, adaptive polling %s",
+            portRid, status, up ? "reset" : "backed off");
+}
+
+FlexCounter::~FlexCounter(void)
+{
+    endFlexCounterThread();
+}
+
+FlexCounter::FlexCounter(void):
+    m_pollIntervalMsec(FLEX_COUNTER_DEFAULT_POLL_MSECS)
+{
+}
+
+bool FlexCounter::isEmpty() const
+{
+    SWSS_LOG_ENTER();
 
-        for (size_t i = 0; i != portCounterIds.size(); i++)
+    for (const auto &kv: m_objectCounterIdsMap)
+    {
+        if (!kv.second.empty())
         {
-            const std::string &counterName = sai_serialize_port_stat(portCounterIds[i]);
-            values.emplace_back(counterName, std::to_string(portStats[i]));
+            return false;
         }
+    }
 
-        // Write counters to DB
-        std::string portVidStr = sai_serialize_object_id(portVid);
+    return m_queueCounterIdsMap.empty() && m_portCounterIdsMap.empty() && m_queueAttrIdsMap.empty();
+}
+
+FlexCounter& FlexCounter::getInstance(void)
+{
+    static FlexCounter fc;
+
+    return fc;
+}
 
-        countersTable.set(portVidStr, values, "");
+void FlexCounter::addQueuePort(
+        _In_ sai_object_id_t queueVid,
+        _In_ sai_object_id_t queueId)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_queuePortMap.find(queueVid) == m_queuePortMap.end())
+    {
+        m_queuePortMap[queueVid] = getQueuePortRid(queueId);
     }
+}
 
-    // Collect stats for every registered queue
-    for (const auto &kv: m_queueCounterIdsMap)
+sai_object_id_t FlexCounter::getQueuePortRid(
+        _In_ sai_object_id_t queueId)
+{
+    SWSS_LOG_ENTER();
+
+    sai_attribute_t attr;
+
+    attr.id = SAI_QUEUE_ATTR_PORT;
+
+    sai_status_t status = sai_metadata_sai_queue_api->get_queue_attribute(queueId, 1, &attr);
+
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        /*
+         * Queue will still back off when idle, but not on port down.
+         */
+
+        SWSS_LOG_WARN("Failed to get port of queue 0x%lx: %d", queueId, status);
+
+        return SAI_NULL_OBJECT_ID;
+    }
+
+    return attr.value.oid;
+}
+
+bool FlexCounter::isCollectDue(
+        _In_ CollectType type,
+        _In_ sai_object_id_t vid,
+        _In_ sai_object_id_t portRid)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_adaptiveMaxPolls <= 1)
+    {
+        return true;
+    }
+
+    AdaptivePollState &state = m_adaptivePollState[AdaptivePollKey(type, vid)];
+
+    state.portRid = portRid;
+
+    if (state.countdown > 0)
     {
-        const auto &queueVid = kv.first;
-        const auto &queueId = kv.second->queueId;
-        const auto &queueCounterIds = kv.second->queueCounterIds;
+        state.countdown--;
+
+        m_adaptiveSkipped++;
+
+        return false;
+    }
+
+    m_adaptiveCollected++;
+
+    return true;
+}
+
+void FlexCounter::updateAdaptivePollState(
+        _In_ CollectType type,
+        _In_ sai_object_id_t vid,
+        _In_ const std::vector<swss::FieldValueTuple> &values)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_adaptiveMaxPolls <= 1)
+    {
+        return;
+    }
+
+    AdaptivePollState &state = m_adaptivePollState[AdaptivePollKey(type, vid)];
+
+    if (values != state.lastValues)
+    {
+        state.lastValues = values;
+        state.unchangedPolls = 0;
+        state.interval = 1;
+    }
+    else if (++state.unchangedPolls >= std::max(1u, FLEX_COUNTER_ADAPTIVE_IDLE_MSECS / m_pollIntervalMsec))
+    {
+        state.interval = std::min(state.interval * 2, m_adaptiveMaxPolls);
+    }
+
+    if (state.portRid != SAI_NULL_OBJECT_ID &&
+            m_operDownPorts.find(state.portRid) != m_operDownPorts.end())
+    {
+        state.interval = m_adaptiveMaxPolls;
+    }
+
+    state.countdown = state.interval - 1;
+}
+
+void FlexCounter::addStatsCollectJob(
+        _Inout_ std::vector<CollectJob> &jobs,
+        _Inout_ std::map<std::pair<bool, std::vector<int32_t>>, size_t> &openJobs,
+        _In_ CollectType type,
+        _In_ sai_object_type_t objectType,
+        _In_ sai_object_id_t vid,
+        _In_ sai_object_id_t rid,
+        _In_ const std::vector<int32_t> &counterIds,
+        _In_ bool readAndClear)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Without vendor bulk api each object is separate job, so per object
+     * calls are still spread across worker pool.
+     */
+
+    size_t bulkSize = BulkStats::isVendorBulkSupported(objectType) ? FLEX_COUNTER_BULK_SIZE : 1;
+
+    auto key = std::make_pair(readAndClear, counterIds);
+
+    auto it = openJobs.find(key);
+
+    if (it == openJobs.end() || jobs[it->second].vids.size() >= bulkSize)
+    {
+        CollectJob job;
+
+        job.type = type;
+        job.objectType = objectType;
+        job.counterIds = counterIds;
+        job.readAndClear = readAndClear;
+
+        jobs.push_back(job);
+
+        openJobs[key] = jobs.size() - 1;
+
+        it = openJobs.find(key);
+    }
+
+    CollectJob &job = jobs[it->second];
+
+    job.vids.push_back(vid);
+    job.rids.push_back(rid);
+}
+
+void FlexCounter::prepareCollectJobs(
+        _Out_ std::vector<CollectJob> &jobs)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Maps are ordered by VID, and objects with the same counter ids are
+     * grouped to the same bulk job, so jobs order is deterministic and
+     * counters are always written in the same order no matter which worker
+     * collected them.
+     */
 
-        std::vector<uint64_t> queueStats(queueCounterIds.size());
+    jobs.clear();
 
-        // Get queue stats
-        sai_status_t status = sai_metadata_sai_queue_api->get_queue_stats(
-                queueId,
-                static_cast<uint32_t>(queueCounterIds.size()),
-                queueCounterIds.data(),
-                queueStats.data());
-        if (status != SAI_STATUS_SUCCESS)
+    std::map<std::pair<bool, std::vector<int32_t>>, size_t> openJobs;
+
+    for (const auto &kv: m_portCounterIdsMap)
+    {
+        if (!isCollectDue(COLLECT_PORT_STATS, kv.first, kv.second->portId))
         {
-            SWSS_LOG_ERROR("Failed to get stats of queue 0x%lx: %d", queueVid, status);
             continue;
         }
 
-        // Push all counter values to a single vector
-        std::vector<swss::FieldValueTuple> values;
+        const auto &ids = kv.second->portCounterIds;
 
-        for (size_t i = 0; i != queueCounterIds.size(); i++)
+        std::vector<int32_t> counterIds(ids.begin(), ids.end());
+
+        addStatsCollectJob(jobs, openJobs, COLLECT_PORT_STATS, SAI_OBJECT_TYPE_PORT,
+                kv.first, kv.second->portId, counterIds, false);
+    }
+
+    openJobs.clear();
+
+    for (const auto &kv: m_queueCounterIdsMap)
+    {
+        auto portIt = m_queuePortMap.find(kv.first);
+
+        sai_object_id_t portRid = (portIt == m_queuePortMap.end()) ? SAI_NULL_OBJECT_ID : portIt->second;
+
+        if (!isCollectDue(COLLECT_QUEUE_STATS, kv.first, portRid))
         {
-            const std::string &counterName = sai_serialize_queue_stat(queueCounterIds[i]);
-            values.emplace_back(counterName, std::to_string(queueStats[i]));
+            continue;
         }
 
-        // Write counters to DB
-        std::string queueVidStr = sai_serialize_object_id(queueVid);
+        const auto &ids = kv.second->queueCounterIds;
+
+        std::vector<int32_t> counterIds(ids.begin(), ids.end());
 
-        countersTable.set(queueVidStr, values, "");
+        addStatsCollectJob(jobs, openJobs, COLLECT_QUEUE_STATS, SAI_OBJECT_TYPE_QUEUE,
+                kv.first, kv.second->queueId, counterIds, false);
     }
 
-    // Collect stats for every registered queue
-    for (const auto &kv: m_queueAttrIdsMap)
+    for (const auto &objectMap: m_objectCounterIdsMap)
     {
-        const auto &queueVid = kv.first;
-        const auto &queueId = kv.second->queueId;
-        const auto &queueAttrIds = kv.second->queueAttrIds;
-
-        std::vector<sai_attribute_t> queueAttr(queueAttrIds.size());
+        openJobs.clear();
 
-        for (uint64_t i =0; i< queueAttrIds.size(); i++)
+        for (const auto &kv: objectMap.second)
         {
-            queueAttr[i].id = queueAttrIds[i];
+            if (!isCollectDue(COLLECT_OBJECT_STATS, kv.first, SAI_NULL_OBJECT_ID))
+            {
+                continue;
+            }
+
+            addStatsCollectJob(jobs, openJobs, COLLECT_OBJECT_STATS, objectMap.first,
+                    kv.first, kv.second->objectId, kv.second->objectCounterIds, kv.second->readAndClear);
         }
+    }
 
-        // Get queue attr
-        sai_status_t status = sai_metadata_sai_queue_api->get_queue_attribute(
-                queueId,
-                static_cast<uint32_t>(queueAttrIds.size()),
-                queueAttr.data());
+    for (const auto &kv: m_queueAttrIdsMap)
+    {
+        auto portIt = m_queuePortMap.find(kv.first);
+
+        sai_object_id_t portRid = (portIt == m_queuePortMap.end()) ? SAI_NULL_OBJECT_ID : portIt->second;
 
-        if (status != SAI_STATUS_SUCCESS)
+        if (!isCollectDue(COLLECT_QUEUE_ATTRS, kv.first, portRid))
         {
-            SWSS_LOG_ERROR("Failed to get attr of queue 0x%lx: %d", queueVid, status);
             continue;
         }
 
-        // Push all counter values to a single vector
-        std::vector<swss::FieldValueTuple> values;
+        CollectJob job;
+
+        job.type = COLLECT_QUEUE_ATTRS;
+        job.objectType = SAI_OBJECT_TYPE_QUEUE;
+        job.vids.push_back(kv.first);
+        job.rids.push_back(kv.second->queueId);
+        job.queueAttrIds = kv.second;
+
+        jobs.push_back(job);
+    }
+}
+
+void FlexCounter::runCollectJob(
+        _Inout_ CollectJob &job)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * This method is executed by worker threads, it must not touch any shared
+     * state, only SAI api and job itself.
+     */
+
+    job.values.resize(job.vids.size());
+
+    switch (job.type)
+    {
+        case COLLECT_PORT_STATS:
+        case COLLECT_QUEUE_STATS:
+        case COLLECT_OBJECT_STATS:
+            {
+                BulkStats::getStats(job.objectType, job.rids, job.counterIds, job.matrix);
+
+                job.statuses = job.matrix.statuses;
+
+                if (job.readAndClear)
+                {
+                    /*
+                     * Watermarks are cleared right after read, so next poll
+                     * will report peak value since this poll. Increments
+                     * between read and clear are lost, since there is no
+                     * atomic read and clear api in current SAI version.
+                     */
+
+                    for (size_t idx = 0; idx < job.rids.size(); idx++)
+                    {
+                        if (job.statuses[idx] != SAI_STATUS_SUCCESS)
+                        {
+                            continue;
+                        }
+
+                        job.statuses[idx] = BulkStats::clearObjectStats(
+                                job.objectType,
+                                job.rids[idx],
+                                (uint32_t)job.counterIds.size(),
+                                job.counterIds.data());
+                    }
+                }
+
+                const sai_enum_metadata_t *statsMeta = BulkStats::getStatsEnumMetadata(job.objectType);
+
+                std::vector<std::string> counterNames;
+
+                for (auto counterId: job.counterIds)
+                {
+                    counterNames.push_back(sai_serialize_enum(counterId, statsMeta));
+                }
+
+                for (size_t idx = 0; idx < job.vids.size(); idx++)
+                {
+                    if (job.statuses[idx] != SAI_STATUS_SUCCESS)
+                    {
+                        continue;
+                    }
+
+                    const uint64_t *counters = job.matrix.getRow(idx);
+
+                    for (size_t i = 0; i != counterNames.size(); i++)
+                    {
+                        job.values[idx].emplace_back(counterNames[i], std::to_string(counters[i]));
+                    }
+                }
+
+                break;
+            }
+
+        case COLLECT_QUEUE_ATTRS:
+            {
+                const auto &queueAttrIds = job.queueAttrIds->queueAttrIds;
+
+                std::vector<sai_attribute_t> queueAttr(queueAttrIds.size());
+
+                for (uint64_t i =0; i< queueAttrIds.size(); i++)
+                {
+                    queueAttr[i].id = queueAttrIds[i];
+                }
+
+                sai_status_t status = sai_metadata_sai_queue_api->get_queue_attribute(
+                        job.rids[0],
+                        static_cast<uint32_t>(queueAttrIds.size()),
+                        queueAttr.data());
+
+                job.statuses.assign(1, status);
+
+                if (status != SAI_STATUS_SUCCESS)
+                {
+                    return;
+                }
+
+                for (size_t i = 0; i != queueAttrIds.size(); i++)
+                {
+                    const std::string &counterName = sai_serialize_queue_attr(queueAttrIds[i]);
+                    auto meta = sai_metadata_get_attr_metadata(SAI_OBJECT_TYPE_QUEUE, queueAttr[i].id);
+
+                    job.values[0].emplace_back(counterName, sai_serialize_attr_value(*meta, queueAttr[i]));
+                }
+
+                break;
+            }
+
+        default:
+            SWSS_LOG_THROW("unknown collect job type %d", job.type);
+    }
+}
+
+void FlexCounter::collectCounters(
+        _In_ swss::Table &countersTable)
+{
+    SWSS_LOG_ENTER();
 
-        for (size_t i = 0; i != queueAttrIds.size(); i++)
+    std::vector<CollectJob> jobs;
+
+    prepareCollectJobs(jobs);
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Collect stats for every registered object, SAI calls are sharded
+    // across worker pool
+    m_workerPool->run(jobs.size(), [&](size_t index) { runCollectJob(jobs[index]); });
+
+    auto saiEnd = std::chrono::steady_clock::now();
+
+    if (m_counterRing != nullptr)
+    {
+        m_counterRing->beginSample();
+    }
+
+    // Write counters to DB in the same order as jobs were created
+    for (const auto &job: jobs)
+    {
+        for (size_t idx = 0; idx < job.vids.size(); idx++)
         {
-            const std::string &counterName = sai_serialize_queue_attr(queueAttrIds[i]);
-            auto meta = sai_metadata_get_attr_metadata(SAI_OBJECT_TYPE_QUEUE, queueAttr[i].id);
+            sai_object_id_t vid = job.vids[idx];
+
+            if (job.statuses[idx] != SAI_STATUS_SUCCESS)
+            {
+                switch (job.type)
+                {
+                    case COLLECT_PORT_STATS:
+                        SWSS_LOG_ERROR("Failed to get stats of port 0x%lx: %d", job.rids[idx], job.statuses[idx]);
+                        break;
 
-            values.emplace_back(counterName, sai_serialize_attr_value(*meta, queueAttr[i]));
+                    case COLLECT_QUEUE_STATS:
+                        SWSS_LOG_ERROR("Failed to get stats of queue 0x%lx: %d", vid, job.statuses[idx]);
+                        break;
+
+                    case COLLECT_QUEUE_ATTRS:
+                        SWSS_LOG_ERROR("Failed to get attr of queue 0x%lx: %d", vid, job.statuses[idx]);
+                        break;
+
+                    default:
+                        SWSS_LOG_ERROR("Failed to get stats of %s 0x%lx: %d",
+                                sai_serialize_object_type(job.objectType).c_str(), vid, job.statuses[idx]);
+                        break;
+                }
+
+                continue;
+            }
+
+            updateAdaptivePollState(job.type, vid, job.values[idx]);
+
+            if (m_counterRing != nullptr && job.type != COLLECT_QUEUE_ATTRS)
+            {
+                const uint64_t *counters = job.matrix.getRow(idx);
+
+                for (size_t i = 0; i != job.counterIds.size(); i++)
+                {
+                    m_counterRing->put(vid, job.objectType, job.counterIds[i], counters[i]);
+                }
+            }
+
+            std::string vidStr = sai_serialize_object_id(vid);
+
+            countersTable.set(vidStr, job.values[idx], "");
         }
-        // Write counters to DB
-        std::string queueVidStr = sai_serialize_object_id(queueVid);
+    }
 
-        countersTable.set(queueVidStr, values, "");
+    if (m_counterRing != nullptr)
+    {
+        m_counterRing->commitSample();
     }
 
+    auto end = std::chrono::steady_clock::now();
+
+    m_pollSaiDuration.record((uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(saiEnd - start).count());
+    m_pollDuration.record((uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+}
+
+void FlexCounter::publishPollStats(
+        _In_ swss::Table &statsTable)
+{
+    SWSS_LOG_ENTER();
+
+    auto values = m_pollDuration.serialize();
+
+    values.emplace_back("concurrency", std::to_string(m_workerPool->getConcurrency()));
+
+    statsTable.set(FLEX_COUNTER_STATS_POLL_DURATION, values, "");
+
+    statsTable.set(FLEX_COUNTER_STATS_POLL_SAI_DURATION, m_pollSaiDuration.serialize(), "");
+
+    if (m_adaptiveMaxPolls > 1)
+    {
+        std::vector<swss::FieldValueTuple> adaptive;
+
+        adaptive.emplace_back("max_interval_msec", std::to_string(m_adaptiveMaxPolls * m_pollIntervalMsec));
+        adaptive.emplace_back("collected", std::to_string(m_adaptiveCollected));
+        adaptive.emplace_back("skipped", std::to_string(m_adaptiveSkipped));
+        adaptive.emplace_back("oper_down_ports", std::to_string(m_operDownPorts.size()));
+
+        statsTable.set(FLEX_COUNTER_STATS_ADAPTIVE_POLLING, adaptive, "");
+    }
 }
 
 void FlexCounter::runPlugins(
@@ -341,7 +1003,7 @@ void FlexCounter::runPlugins(
     {
         std::to_string(COUNTERS_DB),
         COUNTERS_TABLE,
-        std::to_string(FLEX_COUNTER_POLL_MSECS * 1000)
+        std::to_string(m_pollIntervalMsec * 1000)
     };
 
     std::vector<std::string> portList;
@@ -375,6 +1037,13 @@ void FlexCounter::flexCounterThread(void)
 
     swss::DBConnector db(COUNTERS_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
     swss::Table countersTable(&db, COUNTERS_TABLE);
+    swss::Table statsTable(&db, FLEX_COUNTER_STATS_TABLE);
+
+    m_workerPool = std::make_shared<WorkerPool>(m_collectConcurrency);
+
+    uint64_t pollCount = 0;
+
+    uint32_t publishPolls = std::max(1u, FLEX_COUNTER_STATS_PUBLISH_MSECS / m_pollIntervalMsec);
 
     while (m_runFlexCounterThread)
     {
@@ -383,8 +1052,13 @@ void FlexCounter::flexCounterThread(void)
         collectCounters(countersTable);
         runPlugins(db);
 
+        if (++pollCount % publishPolls == 0)
+        {
+            publishPollStats(statsTable);
+        }
+
         std::unique_lock<std::mutex> lk(m_mtxSleep);
-        m_cvSleep.wait_for(lk, std::chrono::milliseconds(FLEX_COUNTER_POLL_MSECS));
+        m_cvSleep.wait_for(lk, std::chrono::milliseconds(m_pollIntervalMsec));
     }
 }
 
@@ -11,6 +11,22 @@ extern "C" {
 #include <condition_variable>
 #include "swss/table.h"
 
+#include "syncd_bulk_stats.h"
+#include "syncd_counter_ring.h"
+#include "syncd_latency_histogram.h"
+#include "meta/saiworkerpool.h"
+
+/*
+ * Generic counters registration fields, used for all object types which
+ * stats are described by SAI stat enum metadata.
+ */
+
+#define FLEX_COUNTER_COUNTER_ID_LIST    "COUNTER_ID_LIST"
+#define FLEX_COUNTER_STATS_MODE         "STATS_MODE"
+
+#define STATS_MODE_READ                 "STATS_MODE_READ"
+#define STATS_MODE_READ_AND_CLEAR       "STATS_MODE_READ_AND_CLEAR"
+
 class FlexCounter
 {
     public:
@@ -27,10 +43,50 @@ class FlexCounter
                 _In_ sai_object_id_t queueId,
                 _In_ const std::vector<sai_queue_attr_t> &attrIds);
 
+        /**
+         * @brief Sets counters of object of any type which stats are
+         * supported by bulk stats.
+         *
+         * Counter ids are values of stat enum of given object type, as
+         * described by SAI stat enum metadata.
+         *
+         * @param objectType Object type.
+         * @param vid Object virtual ID.
+         * @param rid Object real ID.
+         * @param counterIds Stat enum values.
+         * @param readAndClear Counters are cleared right after each read,
+         * so for watermarks value in DB is peak since previous poll.
+         */
+        static void setObjectCounterList(
+                _In_ sai_object_type_t objectType,
+                _In_ sai_object_id_t vid,
+                _In_ sai_object_id_t rid,
+                _In_ const std::vector<int32_t> &counterIds,
+                _In_ bool readAndClear);
+
         static void removePort(
                 _In_ sai_object_id_t portVid);
         static void removeQueue(
                 _In_ sai_object_id_t queueVid);
+        static void removeObject(
+                _In_ sai_object_type_t objectType,
+                _In_ sai_object_id_t vid);
+
+        /**
+         * @brief Removes all counters of object, registered either by
+         * generic counter id list or by legacy PFC WD port and queue lists.
+         */
+        static void removeCounters(
+                _In_ sai_object_type_t objectType,
+                _In_ sai_object_id_t vid);
+
+        /**
+         * @brief Checks if object has counters registered by generic
+         * counter id list.
+         */
+        static bool isObjectRegistered(
+                _In_ sai_object_type_t objectType,
+                _In_ sai_object_id_t vid);
 
         static void addPortCounterPlugin(
                 _In_ std::string sha);
@@ -39,6 +95,67 @@ class FlexCounter
         static void removeCounterPlugin(
                 _In_ std::string sha);
 
+        /**
+         * @brief Enables publishing of each poll to shared memory ring.
+         *
+         * Must be called before any counters are registered, since ring is
+         * used by flex counter thread.
+         *
+         * @param file Ring file path, usually on tmpfs.
+         */
+        static void enableCounterRing(
+                _In_ const std::string &file);
+
+        /**
+         * @brief Sets interval between flex counter polls.
+         *
+         * Interval is also published in counter ring header and adaptive
+         * polling intervals are multiples of it, so it must be called
+         * before counter ring and adaptive polling are enabled and before
+         * flex counter thread is started.
+         *
+         * @param pollIntervalMsec Poll interval, 0 means default.
+         */
+        static void setPollInterval(
+                _In_ uint32_t pollIntervalMsec);
+
+        /**
+         * @brief Sets maximum number of concurrent SAI stats calls.
+         *
+         * Some vendor SDKs serialize stats calls internally, for those
+         * concurrency should be left at 1, which means serial collection.
+         * Must be called before flex counter thread is started.
+         *
+         * @param concurrency Number of threads collecting counters.
+         */
+        static void setCollectConcurrency(
+                _In_ uint32_t concurrency);
+
+        /**
+         * @brief Enables adaptive polling.
+         *
+         * Objects which values didn't change for a number of polls, and ports
+         * which are operationally down together with their queues, are
+         * polled less often. Poll interval of such object is doubled up to
+         * given ceiling, and returns to full rate on first value change or
+         * when port goes up. Skipped objects keep their last values in DB.
+         *
+         * @param maxIntervalMsec Maximum poll interval of single object, 0
+         * disables adaptive polling.
+         */
+        static void setAdaptivePolling(
+                _In_ uint32_t maxIntervalMsec);
+
+        /**
+         * @brief Notifies flex counter about port operational status change.
+         *
+         * @param portRid Port real ID.
+         * @param status New port operational status.
+         */
+        static void updatePortOperStatus(
+                _In_ sai_object_id_t portRid,
+                _In_ sai_port_oper_status_t status);
+
         FlexCounter(
                 _In_ const FlexCounter&) = delete;
         ~FlexCounter(void);
@@ -74,10 +191,100 @@ class FlexCounter
             std::vector<sai_port_stat_t> portCounterIds;
         };
 
+        struct ObjectCounterIds
+        {
+            ObjectCounterIds(
+                    _In_ sai_object_id_t object,
+                    _In_ const std::vector<int32_t> &objectIds,
+                    _In_ bool clear);
+
+            sai_object_id_t objectId;
+            std::vector<int32_t> objectCounterIds;
+            bool readAndClear;
+        };
+
+        enum CollectType
+        {
+            COLLECT_PORT_STATS,
+            COLLECT_QUEUE_STATS,
+            COLLECT_QUEUE_ATTRS,
+            COLLECT_OBJECT_STATS
+        };
+
+        /**
+         * @brief Collection job of objects of the same type.
+         *
+         * Stats job contains objects with the same counter ids which are
+         * collected with single bulk stats call, attributes job always
+         * contains single object. Job is executed by worker pool, and
+         * results are written to DB afterwards in job order.
+         */
+        struct CollectJob
+        {
+            CollectType type;
+            sai_object_type_t objectType;
+
+            std::vector<sai_object_id_t> vids;
+            std::vector<sai_object_id_t> rids;
+
+            std::vector<int32_t> counterIds;
+            bool readAndClear = false;
+            std::shared_ptr<QueueAttrIds> queueAttrIds;
+
+            BulkStatsMatrix matrix;
+            std::vector<sai_status_t> statuses;
+            std::vector<std::vector<swss::FieldValueTuple>> values;
+        };
+
+        /**
+         * @brief Adaptive polling state of single collect job.
+         *
+         * Interval and countdown are expressed in number of polls.
+         */
+        struct AdaptivePollState
+        {
+            sai_object_id_t portRid = SAI_NULL_OBJECT_ID;
+            uint32_t interval = 1;
+            uint32_t countdown = 0;
+            uint32_t unchangedPolls = 0;
+            std::vector<swss::FieldValueTuple> lastValues;
+        };
+
+        typedef std::pair<CollectType, sai_object_id_t> AdaptivePollKey;
+
         FlexCounter(void);
         static FlexCounter& getInstance(void);
+        void prepareCollectJobs(
+                _Out_ std::vector<CollectJob> &jobs);
+        void addQueuePort(
+                _In_ sai_object_id_t queueVid,
+                _In_ sai_object_id_t queueId);
+        sai_object_id_t getQueuePortRid(
+                _In_ sai_object_id_t queueId);
+        bool isCollectDue(
+                _In_ CollectType type,
+                _In_ sai_object_id_t vid,
+                _In_ sai_object_id_t portRid);
+        void updateAdaptivePollState(
+                _In_ CollectType type,
+                _In_ sai_object_id_t vid,
+                _In_ const std::vector<swss::FieldValueTuple> &values);
+        void addStatsCollectJob(
+                _Inout_ std::vector<CollectJob> &jobs,
+                _Inout_ std::map<std::pair<bool, std::vector<int32_t>>, size_t> &openJobs,
+                _In_ CollectType type,
+                _In_ sai_object_type_t objectType,
+                _In_ sai_object_id_t vid,
+                _In_ sai_object_id_t rid,
+                _In_ const std::vector<int32_t> &counterIds,
+                _In_ bool readAndClear);
+        bool isEmpty() const;
+        void runCollectJob(
+                _Inout_ CollectJob &job);
         void collectCounters(
                 _In_ swss::Table &countersTable);
+        void publishPollStats(
+                _In_ swss::Table &statsTable);
         void runPlugins(
                 _In_ swss::DBConnector& db);
         void flexCounterThread(void);
@@ -88,11 +295,33 @@ class FlexCounter
         std::map<sai_object_id_t, std::shared_ptr<PortCounterIds>> m_portCounterIdsMap;
         std::map<sai_object_id_t, std::shared_ptr<QueueCounterIds>> m_queueCounterIdsMap;
         std::map<sai_object_id_t, std::shared_ptr<QueueAttrIds>> m_queueAttrIdsMap;
+        std::map<sai_object_type_t, std::map<sai_object_id_t, std::shared_ptr<ObjectCounterIds>>> m_objectCounterIdsMap;
 
         // Plugins
         std::set<std::string> m_queuePlugins;
         std::set<std::string> m_portPlugins;
 
+        uint32_t m_pollIntervalMsec;
+
+        // Optional shared memory history of each poll
+        std::shared_ptr<CounterRing> m_counterRing;
+
+        // Parallel collection
+        uint32_t m_collectConcurrency = 1;
+        std::shared_ptr<WorkerPool> m_workerPool;
+
+        // Adaptive polling, key of port map is queue VID, value is port RID
+        uint32_t m_adaptiveMaxPolls = 1;
+        std::map<AdaptivePollKey, AdaptivePollState> m_adaptivePollState;
+        std::map<sai_object_id_t, sai_object_id_t> m_queuePortMap;
+        std::set<sai_object_id_t> m_operDownPorts;
+        uint64_t m_adaptiveCollected = 0;
+        uint64_t m_adaptiveSkipped = 0;
+
+        // Poll duration statistics
+        LatencyHistogram m_pollDuration;
+        LatencyHistogram m_pollSaiDuration;
+
         std::atomic_bool m_runFlexCounterThread = { false };
         std::shared_ptr<std::thread> m_flexCounterThread = nullptr;
         std::mutex m_mtxSleep;
@@ -1,9 +1,16 @@
 #include "syncd.h"
 #include "sairedis.h"
+#include "syncd_timeline.h"
+#include "meta/saiworkerpool.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <set>
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <tuple>
 
 /*
@@ -33,8 +40,46 @@ static StringHash g_neighbors;
 #ifdef ENABLE_PERF
 static std::map<sai_object_type_t, std::tuple<int,double>> g_perf_create;
 static std::map<sai_object_type_t, std::tuple<int,double>> g_perf_set;
+
+static void perfAdd(
+        _Inout_ std::map<sai_object_type_t, std::tuple<int,double>> &perf,
+        _In_ sai_object_type_t objectType,
+        _In_ int count,
+        _In_ const std::chrono::high_resolution_clock::time_point &start)
+{
+    SWSS_LOG_ENTER();
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    typedef std::chrono::duration<double, std::ratio<1>> second_t;
+
+    double duration = std::chrono::duration_cast<second_t>(end - start).count();
+
+    std::get<0>(perf[objectType]) += count;
+    std::get<1>(perf[objectType]) += duration;
+}
 #endif
 
+/**
+ * @def HARD_REINIT_PROGRESS_INTERVAL
+ *
+ * Number of processed objects after which progress is logged.
+ */
+#define HARD_REINIT_PROGRESS_INTERVAL 10000
+
+static void logProgress(
+        _In_ const char *what,
+        _In_ size_t processed,
+        _In_ size_t total)
+{
+    SWSS_LOG_ENTER();
+
+    if (processed % HARD_REINIT_PROGRESS_INTERVAL == 0 || processed == total)
+    {
+        SWSS_LOG_NOTICE("processed %s: %zu/%zu", what, processed, total);
+    }
+}
+
 
 /*
  * Since we are only supporting 1 switch we can declare this as global, and we
@@ -74,30 +119,6 @@ sai_object_type_t getObjectTypeFromVid(
     return objectType;
 }
 
-std::shared_ptr<SaiAttributeList> redisGetAttributesFromAsicKey(
-        _In_ const std::string &key)
-{
-    SWSS_LOG_ENTER();
-
-    sai_object_type_t objectType = getObjectTypeFromAsicKey(key);
-
-    std::vector<swss::FieldValueTuple> values;
-
-    auto hash = g_redisClient->hgetall(key);
-
-    for (auto &kv: hash)
-    {
-        const std::string &skey = kv.first;
-        const std::string &svalue = kv.second;
-
-        swss::FieldValueTuple fvt(skey, svalue);
-
-        values.push_back(fvt);
-    }
-
-    return std::make_shared<SaiAttributeList>(objectType, values, false);
-}
-
 sai_object_type_t getObjectTypeFromAsicKey(
         _In_ const std::string &key)
 {
@@ -446,6 +467,13 @@ void processSwitches()
 
         g_sw = sw;
 
+        /*
+         * Existing objects are compared with objects from previous run, so
+         * all of them needs to be discovered.
+         */
+
+        g_sw->completeLazyDiscovery(false);
+
         /*
          * We processed switch. We have switch vid/rid so we can process all
          * other attributes of switches that are not mandatory on create and are
@@ -557,6 +585,45 @@ void listFailedAttributes(
     }
 }
 
+static sai_object_id_t createSingleObject(
+        _In_ sai_object_type_t objectType,
+        _In_ uint32_t attrCount,
+        _In_ sai_attribute_t *attrList)
+{
+    SWSS_LOG_ENTER();
+
+    auto info = sai_metadata_get_object_type_info(objectType);
+
+    sai_object_meta_key_t meta_key;
+
+    meta_key.objecttype = objectType;
+
+    /*
+     * Since we have only one switch, we can get away using g_switch_rid here.
+     */
+
+#ifdef ENABLE_PERF
+    auto start = std::chrono::high_resolution_clock::now();
+#endif
+
+    sai_status_t status = info->create(&meta_key, g_switch_rid, attrCount, attrList);
+
+#ifdef ENABLE_PERF
+    perfAdd(g_perf_create, objectType, 1, start);
+#endif
+
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        listFailedAttributes(objectType, attrCount, attrList);
+
+        SWSS_LOG_THROW("failed to create object %s: %s",
+                sai_serialize_object_type(objectType).c_str(),
+                sai_serialize_status(status).c_str());
+    }
+
+    return meta_key.objectkey.key.object_id;
+}
+
 sai_object_id_t processSingleVid(
         _In_ sai_object_id_t vid)
 {
@@ -651,41 +718,7 @@ sai_object_id_t processSingleVid(
 
     if (createObject)
     {
-        sai_object_meta_key_t meta_key;
-
-        meta_key.objecttype = objectType;
-
-        /*
-         * Since we have only one switch, we can get away using g_switch_rid here.
-         */
-
-#ifdef ENABLE_PERF
-        auto start = std::chrono::high_resolution_clock::now();
-#endif
-
-        sai_status_t status = info->create(&meta_key, g_switch_rid, attrCount, attrList);
-
-#ifdef ENABLE_PERF
-        auto end = std::chrono::high_resolution_clock::now();
-
-        typedef std::chrono::duration<double, std::ratio<1>> second_t;
-
-        double duration = std::chrono::duration_cast<second_t>(end - start).count();
-
-        std::get<0>(g_perf_create[objectType])++;
-        std::get<1>(g_perf_create[objectType]) += duration;
-#endif
-
-        if (status != SAI_STATUS_SUCCESS)
-        {
-            listFailedAttributes(objectType, attrCount, attrList);
-
-            SWSS_LOG_THROW("failed to create object %s: %s",
-                    sai_serialize_object_type(objectType).c_str(),
-                    sai_serialize_status(status).c_str());
-        }
-
-        rid = meta_key.objectkey.key.object_id;
+        rid = createSingleObject(objectType, attrCount, attrList);
 
         SWSS_LOG_DEBUG("created object of type %s, processed VID %s to RID %s",
                 sai_serialize_object_type(objectType).c_str(),
@@ -752,14 +785,7 @@ sai_object_id_t processSingleVid(
             sai_status_t status = info->set(&meta_key, attr);
 
 #ifdef ENABLE_PERF
-            auto end = std::chrono::high_resolution_clock::now();
-
-            typedef std::chrono::duration<double, std::ratio<1>> second_t;
-
-            double duration = std::chrono::duration_cast<second_t>(end - start).count();
-
-            std::get<0>(g_perf_set[objectType])++;
-            std::get<1>(g_perf_set[objectType]) += duration;
+            perfAdd(g_perf_set, objectType, 1, start);
 #endif
 
             if (status != SAI_STATUS_SUCCESS)
@@ -779,6 +805,93 @@ sai_object_id_t processSingleVid(
     return rid;
 }
 
+/**
+ * @brief Gets object ids contained in attribute value.
+ *
+ * @return False if attribute is not oid attribute.
+ */
+static bool getAttributeObjectIds(
+        _In_ sai_object_type_t objectType,
+        _Inout_ sai_attribute_t &attr,
+        _Out_ uint32_t &count,
+        _Out_ sai_object_id_t *&objectIdList)
+{
+    SWSS_LOG_ENTER();
+
+    auto meta = sai_metadata_get_attr_metadata(objectType, attr.id);
+
+    if (meta == NULL)
+    {
+        SWSS_LOG_THROW("unable to get metadata for object type %s, attribute %d",
+                sai_serialize_object_type(objectType).c_str(),
+                attr.id);
+    }
+
+    count = 0;
+    objectIdList = NULL;
+
+    switch (meta->attrvaluetype)
+    {
+        case SAI_ATTR_VALUE_TYPE_OBJECT_ID:
+            count = 1;
+            objectIdList = &attr.value.oid;
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_OBJECT_LIST:
+            count = attr.value.objlist.count;
+            objectIdList = attr.value.objlist.list;
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_ID:
+            if (attr.value.aclfield.enable)
+            {
+                count = 1;
+                objectIdList = &attr.value.aclfield.data.oid;
+            }
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
+            if (attr.value.aclfield.enable)
+            {
+                count = attr.value.aclfield.data.objlist.count;
+                objectIdList = attr.value.aclfield.data.objlist.list;
+            }
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_ID:
+            if (attr.value.aclaction.enable)
+            {
+                count = 1;
+                objectIdList = &attr.value.aclaction.parameter.oid;
+            }
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
+            if (attr.value.aclaction.enable)
+            {
+                count = attr.value.aclaction.parameter.objlist.count;
+                objectIdList = attr.value.aclaction.parameter.objlist.list;
+            }
+            break;
+
+        default:
+
+            // TODO later isoidattribute
+            if (meta->allowedobjecttypeslength > 0)
+            {
+                SWSS_LOG_THROW("attribute %s is oid attribute, but not processed, FIXME", meta->attridname);
+            }
+
+            /*
+             * This is not oid attribute, we can skip processing.
+             */
+
+            return false;
+    }
+
+    return true;
+}
+
 void processAttributesForOids(
         _In_ sai_object_type_t objectType,
         _In_ uint32_t attr_count,
@@ -791,105 +904,295 @@ void processAttributesForOids(
 
     for (uint32_t idx = 0; idx < attr_count; idx++)
     {
-        sai_attribute_t &attr = attr_list[idx];
+        uint32_t count;
+        sai_object_id_t *objectIdList;
 
-        auto meta = sai_metadata_get_attr_metadata(objectType, attr.id);
+        if (!getAttributeObjectIds(objectType, attr_list[idx], count, objectIdList))
+        {
+            continue;
+        }
 
-        if (meta == NULL)
+        /*
+         * Attribute contains object id's, they need to be translated some of
+         * them could be already translated.
+         */
+
+        for (uint32_t j = 0; j < count; j++)
         {
-            SWSS_LOG_THROW("unable to get metadata for object type %s, attribute %d",
-                    sai_serialize_object_type(objectType).c_str(),
-                    attr.id);
+            sai_object_id_t vid = objectIdList[j];
+
+            sai_object_id_t rid = processSingleVid(vid);
+
+            objectIdList[j] = rid;
         }
+    }
+}
 
-        uint32_t count = 0;
-        sai_object_id_t *objectIdList;
+/**
+ * @brief Gets level of VID in dependency graph.
+ *
+ * Objects without dependencies (or depending only on already processed
+ * objects) are on level 1, other objects are one level above their highest
+ * dependency, so all objects on the same level are independent.
+ */
+static size_t getVidLevel(
+        _In_ sai_object_id_t vid,
+        _Inout_ std::unordered_map<sai_object_id_t, size_t> &levels)
+{
+    SWSS_LOG_ENTER();
+
+    if (vid == SAI_NULL_OBJECT_ID || g_translatedV2R.find(vid) != g_translatedV2R.end())
+    {
+        return 0;
+    }
+
+    auto it = levels.find(vid);
 
-        switch (meta->attrvaluetype)
+    if (it != levels.end())
+    {
+        if (it->second == SIZE_MAX)
         {
-            case SAI_ATTR_VALUE_TYPE_OBJECT_ID:
-                count = 1;
-                objectIdList = &attr.value.oid;
-                break;
+            SWSS_LOG_THROW("dependency loop detected on VID %s",
+                    sai_serialize_object_id(vid).c_str());
+        }
 
-            case SAI_ATTR_VALUE_TYPE_OBJECT_LIST:
-                count = attr.value.objlist.count;
-                objectIdList = attr.value.objlist.list;
-                break;
+        return it->second;
+    }
 
-            case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_ID:
-                if (attr.value.aclfield.enable)
-                {
-                    count = 1;
-                    objectIdList = &attr.value.aclfield.data.oid;
-                }
-                break;
+    std::string strVid = sai_serialize_object_id(vid);
 
-            case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
-                if (attr.value.aclfield.enable)
-                {
-                    count = attr.value.aclfield.data.objlist.count;
-                    objectIdList = attr.value.aclfield.data.objlist.list;
-                }
-                break;
+    auto oit = g_oids.find(strVid);
 
-            case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_ID:
-                if (attr.value.aclaction.enable)
-                {
-                    count = 1;
-                    objectIdList = &attr.value.aclaction.parameter.oid;
-                }
-                break;
+    if (oit == g_oids.end())
+    {
+        SWSS_LOG_THROW("failed to find VID %s in OIDs map", strVid.c_str());
+    }
 
-            case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
-                if (attr.value.aclaction.enable)
-                {
-                    count = attr.value.aclaction.parameter.objlist.count;
-                    objectIdList = attr.value.aclaction.parameter.objlist.list;
-                }
-                break;
+    levels[vid] = SIZE_MAX;
 
-            default:
+    sai_object_type_t objectType = getObjectTypeFromVid(vid);
 
-                // TODO later isoidattribute
-                if (meta->allowedobjecttypeslength > 0)
-                {
-                    SWSS_LOG_THROW("attribute %s is oid attribute, but not processed, FIXME", meta->attridname);
-                }
+    std::shared_ptr<SaiAttributeList> list = g_attributesLists[oit->second];
 
-                /*
-                 * This is not oid attribute, we can skip processing.
-                 */
+    sai_attribute_t *attrList = list->get_attr_list();
 
-                continue;
+    uint32_t attrCount = list->get_attr_count();
+
+    size_t level = 1;
+
+    for (uint32_t idx = 0; idx < attrCount; idx++)
+    {
+        uint32_t count;
+        sai_object_id_t *objectIdList;
+
+        if (!getAttributeObjectIds(objectType, attrList[idx], count, objectIdList))
+        {
+            continue;
+        }
+
+        for (uint32_t j = 0; j < count; j++)
+        {
+            level = std::max(level, getVidLevel(objectIdList[j], levels) + 1);
         }
+    }
+
+    levels[vid] = level;
+
+    return level;
+}
+
+/*
+ * Bulk create API is present in SAI only for some object types, other types
+ * are created one by one.
+ */
+static sai_bulk_object_create_fn getBulkCreateFn(
+        _In_ sai_object_type_t objectType)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * When api is not provided by vendor, NULL is returned and objects are
+     * created one by one.
+     */
+
+    switch (objectType)
+    {
+        case SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER:
+            return sai_metadata_sai_next_hop_group_api ? sai_metadata_sai_next_hop_group_api->create_next_hop_group_members : NULL;
+
+        case SAI_OBJECT_TYPE_LAG_MEMBER:
+            return sai_metadata_sai_lag_api ? sai_metadata_sai_lag_api->create_lag_members : NULL;
+
+        default:
+            return NULL;
+    }
+}
+
+/*
+ * Object types on which vendor bulk create returned not supported, those are
+ * created one by one from that point.
+ */
+static std::set<sai_object_type_t> g_bulkCreateNotSupported;
+
+static void processBulkVids(
+        _In_ sai_object_type_t objectType,
+        _In_ const std::vector<sai_object_id_t> &vids)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<std::shared_ptr<SaiAttributeList>> lists;
+
+    std::vector<uint32_t> attrCounts;
+
+    std::vector<const sai_attribute_t*> attrLists;
+
+    for (sai_object_id_t vid: vids)
+    {
+        auto list = g_attributesLists[g_oids.at(sai_serialize_object_id(vid))];
 
         /*
-         * Attribute contains object id's, they need to be translated some of
-         * them could be already translated.
+         * All dependencies are on lower levels, so they are already
+         * translated.
          */
 
-        for (uint32_t j = 0; j < count; j++)
-        {
-            sai_object_id_t vid = objectIdList[j];
+        processAttributesForOids(objectType, list->get_attr_count(), list->get_attr_list());
 
-            sai_object_id_t rid = processSingleVid(vid);
+        lists.push_back(list);
+        attrCounts.push_back(list->get_attr_count());
+        attrLists.push_back(list->get_attr_list());
+    }
 
-            objectIdList[j] = rid;
+    uint32_t objectCount = (uint32_t)vids.size();
+
+    std::vector<sai_object_id_t> rids(vids.size(), SAI_NULL_OBJECT_ID);
+
+    std::vector<sai_status_t> statuses(vids.size(), SAI_STATUS_FAILURE);
+
+#ifdef ENABLE_PERF
+    auto start = std::chrono::high_resolution_clock::now();
+#endif
+
+    sai_status_t status = getBulkCreateFn(objectType)(g_switch_rid, objectCount, attrCounts.data(), attrLists.data(),
+            SAI_BULK_OP_TYPE_INGORE_ERROR, rids.data(), statuses.data());
+
+    bool executed = (status != SAI_STATUS_NOT_IMPLEMENTED && status != SAI_STATUS_NOT_SUPPORTED);
+
+    if (executed)
+    {
+#ifdef ENABLE_PERF
+        perfAdd(g_perf_create, objectType, (int)objectCount, start);
+#endif
+    }
+    else
+    {
+        SWSS_LOG_NOTICE("bulk create not supported on %s, creating one by one",
+                sai_serialize_object_type(objectType).c_str());
+
+        g_bulkCreateNotSupported.insert(objectType);
+    }
+
+    size_t failed = 0;
+
+    for (size_t idx = 0; idx < vids.size(); idx++)
+    {
+        sai_object_id_t rid = rids[idx];
+
+        if (!executed || statuses[idx] != SAI_STATUS_SUCCESS)
+        {
+            if (executed)
+            {
+                failed++;
+            }
+
+            rid = createSingleObject(objectType, attrCounts[idx], lists[idx]->get_attr_list());
         }
+
+        g_translatedV2R[vids[idx]] = rid;
+        g_translatedR2V[rid] = vids[idx];
+    }
+
+    if (failed)
+    {
+        SWSS_LOG_WARN("bulk create of %zu %s failed for %zu objects, created one by one",
+                vids.size(),
+                sai_serialize_object_type(objectType).c_str(),
+                failed);
     }
 }
 
 void processOids()
 {
+    SWSS_LOG_ENTER();
+
+    /*
+     * Dependency graph is built once, and objects are created level by level,
+     * so when object is processed all its dependencies already exist.
+     */
+
+    std::unordered_map<sai_object_id_t, size_t> levels;
+
+    std::vector<std::vector<sai_object_id_t>> objectsByLevel;
+
     for (const auto &kv: g_oids)
     {
-        const std::string &strObjectId = kv.first;
-
         sai_object_id_t vid;
-        sai_deserialize_object_id(strObjectId, vid);
+        sai_deserialize_object_id(kv.first, vid);
+
+        size_t level = getVidLevel(vid, levels);
+
+        if (level == 0)
+        {
+            continue;
+        }
+
+        if (objectsByLevel.size() <= level)
+        {
+            objectsByLevel.resize(level + 1);
+        }
+
+        objectsByLevel[level].push_back(vid);
+    }
+
+    size_t total = levels.size();
+    size_t processed = 0;
+
+    for (size_t level = 1; level < objectsByLevel.size(); level++)
+    {
+        const auto &vids = objectsByLevel[level];
+
+        SWSS_LOG_NOTICE("processing level %zu: %zu objects", level, vids.size());
+
+        std::map<sai_object_type_t, std::vector<sai_object_id_t>> bulk;
+
+        for (sai_object_id_t vid: vids)
+        {
+            sai_object_type_t objectType = getObjectTypeFromVid(vid);
+
+            auto v2rMapIt = g_vidToRidMap.find(vid);
+
+            if (getBulkCreateFn(objectType) != NULL &&
+                    g_bulkCreateNotSupported.find(objectType) == g_bulkCreateNotSupported.end() &&
+                    v2rMapIt != g_vidToRidMap.end() &&
+                    !g_sw->isDefaultCreatedRid(v2rMapIt->second))
+            {
+                bulk[objectType].push_back(vid);
+                continue;
+            }
+
+            processSingleVid(vid);
 
-        processSingleVid(vid);
+            logProgress("oids", ++processed, total);
+        }
+
+        for (const auto &kv: bulk)
+        {
+            processBulkVids(kv.first, kv.second);
+
+            for (size_t idx = 0; idx < kv.second.size(); idx++)
+            {
+                logProgress("oids", ++processed, total);
+            }
+        }
     }
 }
 
@@ -933,6 +1236,8 @@ void processFdbs()
 {
     SWSS_LOG_ENTER();
 
+    size_t processed = 0;
+
     for (auto &kv: g_fdbs)
     {
         const std::string &strFdbEntry = kv.first;
@@ -954,9 +1259,17 @@ void processFdbs()
 
         processAttributesForOids(SAI_OBJECT_TYPE_FDB_ENTRY, attrCount, attrList);
 
+#ifdef ENABLE_PERF
+        auto start = std::chrono::high_resolution_clock::now();
+#endif
+
         sai_status_t status = sai_metadata_sai_fdb_api->
             create_fdb_entry(&meta_key.objectkey.key.fdb_entry, attrCount, attrList);
 
+#ifdef ENABLE_PERF
+        perfAdd(g_perf_create, SAI_OBJECT_TYPE_FDB_ENTRY, 1, start);
+#endif
+
         if (status != SAI_STATUS_SUCCESS)
         {
             listFailedAttributes(SAI_OBJECT_TYPE_FDB_ENTRY, attrCount, attrList);
@@ -965,6 +1278,8 @@ void processFdbs()
                     strFdbEntry.c_str(),
                     sai_serialize_status(status).c_str());
         }
+
+        logProgress("fdbs", ++processed, g_fdbs.size());
     }
 }
 
@@ -972,6 +1287,8 @@ void processNeighbors()
 {
     SWSS_LOG_ENTER();
 
+    size_t processed = 0;
+
     for (auto &kv: g_neighbors)
     {
         const std::string &strNeighborEntry = kv.first;
@@ -993,9 +1310,17 @@ void processNeighbors()
 
         processAttributesForOids(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, attrCount, attrList);
 
+#ifdef ENABLE_PERF
+        auto start = std::chrono::high_resolution_clock::now();
+#endif
+
         sai_status_t status = sai_metadata_sai_neighbor_api->
             create_neighbor_entry(&meta_key.objectkey.key.neighbor_entry, attrCount, attrList);
 
+#ifdef ENABLE_PERF
+        perfAdd(g_perf_create, SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, 1, start);
+#endif
+
         if (status != SAI_STATUS_SUCCESS)
         {
             listFailedAttributes(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, attrCount, attrList);
@@ -1004,32 +1329,49 @@ void processNeighbors()
                     strNeighborEntry.c_str(),
                     sai_serialize_status(status).c_str());
         }
+
+        logProgress("neighbors", ++processed, g_neighbors.size());
     }
 }
 
-void processRoutes(bool defaultOnly)
+void processRoutes()
 {
     SWSS_LOG_ENTER();
 
     SWSS_LOG_TIMER("apply routes");
 
-    for (auto &kv: g_routes)
-    {
-        const std::string &strRouteEntry = kv.first;
-        const std::string &asicKey = kv.second;
+    /*
+     * Since there is a requirement in brcm that default route needs to be put
+     * first in the asic, then we execute default routes first and then other
+     * routes.
+     */
+
+    std::vector<const StringHash::value_type*> routes;
 
-        bool isDefault = strRouteEntry.find("/0") != std::string::npos;
+    routes.reserve(g_routes.size());
 
-        if (defaultOnly ^ isDefault)
+    for (const auto &kv: g_routes)
+    {
+        if (kv.first.find("/0") != std::string::npos)
         {
-            /*
-             * Since there is a requirement in brcm that default route needs to
-             * be put first in the asic, then we execute default routes first
-             * and then other routes.
-             */
+            routes.push_back(&kv);
+        }
+    }
 
-            continue;
+    for (const auto &kv: g_routes)
+    {
+        if (kv.first.find("/0") == std::string::npos)
+        {
+            routes.push_back(&kv);
         }
+    }
+
+    size_t processed = 0;
+
+    for (const auto *kv: routes)
+    {
+        const std::string &strRouteEntry = kv->first;
+        const std::string &asicKey = kv->second;
 
         sai_object_meta_key_t meta_key;
 
@@ -1047,9 +1389,17 @@ void processRoutes(bool defaultOnly)
 
         processAttributesForOids(SAI_OBJECT_TYPE_ROUTE_ENTRY, attrCount, attrList);
 
+#ifdef ENABLE_PERF
+        auto start = std::chrono::high_resolution_clock::now();
+#endif
+
         sai_status_t status = sai_metadata_sai_route_api->
             create_route_entry(&meta_key.objectkey.key.route_entry, attrCount, attrList);
 
+#ifdef ENABLE_PERF
+        perfAdd(g_perf_create, SAI_OBJECT_TYPE_ROUTE_ENTRY, 1, start);
+#endif
+
         if (status != SAI_STATUS_SUCCESS)
         {
             listFailedAttributes(SAI_OBJECT_TYPE_ROUTE_ENTRY, attrCount, attrList);
@@ -1062,14 +1412,166 @@ void processRoutes(bool defaultOnly)
                     strRouteEntry.c_str(),
                     sai_serialize_status(status).c_str());
         }
+
+        logProgress("routes", ++processed, routes.size());
     }
 }
 
-std::vector<std::string> redisGetAsicStateKeys()
+/**
+ * @def ASIC_STATE_SCAN_COUNT
+ *
+ * Number of keys requested by single SCAN when reading ASIC state, all hashes
+ * of one batch are requested in the same pipeline.
+ */
+#define ASIC_STATE_SCAN_COUNT 1000
+
+typedef std::vector<std::pair<std::string, std::vector<swss::FieldValueTuple>>> AsicStateEntries;
+
+static void redisAppendPipelineCommand(
+        _In_ redisContext *ctx,
+        _In_ const std::vector<std::string> &args)
 {
     SWSS_LOG_ENTER();
 
-    return g_redisClient->keys(ASIC_STATE_TABLE + std::string(":*"));
+    std::vector<const char*> argv;
+    std::vector<size_t> argvlen;
+
+    for (const auto &a: args)
+    {
+        argv.push_back(a.c_str());
+        argvlen.push_back(a.size());
+    }
+
+    if (redisAppendCommandArgv(ctx, (int)argv.size(), argv.data(), argvlen.data()) != REDIS_OK)
+    {
+        SWSS_LOG_THROW("failed to append %s command to redis pipeline", args.front().c_str());
+    }
+}
+
+static redisReply* redisGetPipelineReply(
+        _In_ redisContext *ctx)
+{
+    SWSS_LOG_ENTER();
+
+    void *r = NULL;
+
+    if (redisGetReply(ctx, &r) != REDIS_OK || r == NULL)
+    {
+        SWSS_LOG_THROW("failed to get redis pipeline reply: %s", ctx->errstr);
+    }
+
+    redisReply *reply = (redisReply*)r;
+
+    if (reply->type != REDIS_REPLY_ARRAY)
+    {
+        std::string error = (reply->type == REDIS_REPLY_ERROR) ? reply->str : "reply is not array";
+
+        freeReplyObject(reply);
+
+        SWSS_LOG_THROW("redis pipeline command failed: %s", error.c_str());
+    }
+
+    return reply;
+}
+
+AsicStateEntries redisGetAsicState()
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Separate connection is used, since replies are read from socket
+     * directly, and connection is dropped if something goes wrong in the
+     * middle of pipeline.
+     */
+
+    swss::DBConnector db(ASIC_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
+
+    redisContext *ctx = db.getContext();
+
+    const std::string pattern = ASIC_STATE_TABLE + std::string(":*");
+    const std::string count = std::to_string(ASIC_STATE_SCAN_COUNT);
+
+    AsicStateEntries entries;
+
+    std::unordered_set<std::string> seen;
+
+    redisAppendPipelineCommand(ctx, { "SCAN", "0", "MATCH", pattern, "COUNT", count });
+
+    while (true)
+    {
+        redisReply *scan = redisGetPipelineReply(ctx);
+
+        if (scan->elements != 2 ||
+                scan->element[0]->type != REDIS_REPLY_STRING ||
+                scan->element[1]->type != REDIS_REPLY_ARRAY)
+        {
+            freeReplyObject(scan);
+
+            SWSS_LOG_THROW("unexpected SCAN reply format");
+        }
+
+        std::string cursor(scan->element[0]->str, scan->element[0]->len);
+
+        std::vector<std::string> keys;
+
+        for (size_t idx = 0; idx < scan->element[1]->elements; idx++)
+        {
+            const redisReply *key = scan->element[1]->element[idx];
+
+            keys.emplace_back(key->str, key->len);
+        }
+
+        freeReplyObject(scan);
+
+        /*
+         * Hashes of this batch and next SCAN are sent together, so each batch
+         * costs single round trip.
+         */
+
+        for (const auto &key: keys)
+        {
+            redisAppendPipelineCommand(ctx, { "HGETALL", key });
+        }
+
+        if (cursor != "0")
+        {
+            redisAppendPipelineCommand(ctx, { "SCAN", cursor, "MATCH", pattern, "COUNT", count });
+        }
+
+        for (const auto &key: keys)
+        {
+            redisReply *hash = redisGetPipelineReply(ctx);
+
+            /*
+             * SCAN can return same key more than once.
+             */
+
+            if (hash->elements && seen.insert(key).second)
+            {
+                entries.emplace_back(key, std::vector<swss::FieldValueTuple>());
+
+                auto &values = entries.back().second;
+
+                values.reserve(hash->elements / 2);
+
+                for (size_t idx = 0; idx + 1 < hash->elements; idx += 2)
+                {
+                    values.emplace_back(
+                            std::string(hash->element[idx]->str, hash->element[idx]->len),
+                            std::string(hash->element[idx + 1]->str, hash->element[idx + 1]->len));
+                }
+            }
+
+            freeReplyObject(hash);
+        }
+
+        if (cursor == "0")
+        {
+            break;
+        }
+    }
+
+    return entries;
 }
 
 void readAsicState()
@@ -1090,10 +1592,43 @@ void readAsicState()
     g_vidToRidMap = redisGetVidToRidMap();
     g_ridToVidMap = redisGetRidToVidMap();
 
-    std::vector<std::string> asicStateKeys = redisGetAsicStateKeys();
+    AsicStateEntries entries;
+
+    {
+        Timeline::Span s("fetchAsicState");
+
+        entries = redisGetAsicState();
+
+        s.addArg("keys", entries.size());
+    }
+
+    SWSS_LOG_NOTICE("fetched %zu ASIC state keys", entries.size());
+
+    std::vector<std::shared_ptr<SaiAttributeList>> lists(entries.size());
 
-    for (const auto &key: asicStateKeys)
     {
+        SWSS_LOG_TIMER("deserialize asic state");
+
+        Timeline::Span s("deserializeAsicState");
+
+        WorkerPool &pool = SaiSwitch::getWorkerPool();
+
+        s.addArg("threads", pool.getConcurrency());
+
+        pool.run(entries.size(), [&](size_t idx)
+        {
+            const auto &entry = entries[idx];
+
+            lists[idx] = std::make_shared<SaiAttributeList>(getObjectTypeFromAsicKey(entry.first), entry.second, false);
+        });
+    }
+
+    g_attributesLists.reserve(entries.size());
+
+    for (size_t idx = 0; idx < entries.size(); idx++)
+    {
+        const std::string &key = entries[idx].first;
+
         /*
          * TODO if key will be meta_key anyway we could use deserialize here.
          */
@@ -1133,10 +1668,8 @@ void readAsicState()
                 break;
         }
 
-        g_attributesLists[key] = redisGetAttributesFromAsicKey(key);
+        g_attributesLists[key] = lists[idx];
     }
-
-
 }
 
 void hardReinit()
@@ -1145,18 +1678,60 @@ void hardReinit()
 
     SWSS_LOG_TIMER("hard reinit");
 
-    readAsicState();
+    Timeline::Span span("hardReinit");
 
-    processSwitches();
+    {
+        Timeline::Span s("readAsicState");
+
+        readAsicState();
+
+        s.addArg("objects", g_attributesLists.size());
+    }
+
+    {
+        Timeline::Span s("processSwitches");
+
+        s.addArg("switches", g_switches.size());
+
+        processSwitches();
+    }
 
     {
         SWSS_LOG_TIMER("processing objects after switch create");
 
-        processFdbs();
-        processNeighbors();
-        processOids();
-        processRoutes(true);
-        processRoutes(false);
+        Timeline::Span s("processObjects");
+
+        {
+            Timeline::Span f("processFdbs");
+
+            f.addArg("fdbs", g_fdbs.size());
+
+            processFdbs();
+        }
+
+        {
+            Timeline::Span n("processNeighbors");
+
+            n.addArg("neighbors", g_neighbors.size());
+
+            processNeighbors();
+        }
+
+        {
+            Timeline::Span o("processOids");
+
+            o.addArg("oids", g_oids.size());
+
+            processOids();
+        }
+
+        {
+            Timeline::Span r("processRoutes");
+
+            r.addArg("routes", g_routes.size());
+
+            processRoutes();
+        }
     }
 
 #ifdef ENABLE_PERF
@@ -1187,5 +1762,7 @@ void hardReinit()
     SWSS_LOG_NOTICE("create %lf, set: %lf", total_create, total_set);
 #endif
 
+    Timeline::Span c("checkAllIds");
+
     checkAllIds();
 }
@@ -0,0 +1,201 @@
+#include "syncd_latency_histogram.h"
+
+#include "swss/logger.h"
+
+#include <algorithm>
+
+LatencyHistogram::LatencyHistogram():
+    m_buckets(LATENCY_HISTOGRAM_BUCKETS, 0)
+{
+    SWSS_LOG_ENTER();
+
+    reset();
+}
+
+size_t LatencyHistogram::getBucketIndex(
+        _In_ uint64_t value)
+{
+    SWSS_LOG_ENTER();
+
+    if (value < LATENCY_HISTOGRAM_SUB_BUCKETS)
+    {
+        return (size_t)value;
+    }
+
+    /*
+     * Position of highest bit set, value is at least SUB_BUCKETS so it's at
+     * least SUB_BUCKET_BITS.
+     */
+
+    size_t msb = (size_t)(63 - __builtin_clzll(value));
+
+    size_t shift = msb - LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+
+    size_t sub = (size_t)((value >> shift) & (LATENCY_HISTOGRAM_SUB_BUCKETS - 1));
+
+    return LATENCY_HISTOGRAM_SUB_BUCKETS * (shift + 1) + sub;
+}
+
+uint64_t LatencyHistogram::getBucketLowValue(
+        _In_ size_t index)
+{
+    SWSS_LOG_ENTER();
+
+    if (index < LATENCY_HISTOGRAM_SUB_BUCKETS)
+    {
+        return index;
+    }
+
+    size_t shift = index / LATENCY_HISTOGRAM_SUB_BUCKETS - 1;
+
+    uint64_t sub = index % LATENCY_HISTOGRAM_SUB_BUCKETS;
+
+    return (LATENCY_HISTOGRAM_SUB_BUCKETS + sub) << shift;
+}
+
+uint64_t LatencyHistogram::getBucketHighValue(
+        _In_ size_t index)
+{
+    SWSS_LOG_ENTER();
+
+    if (index < LATENCY_HISTOGRAM_SUB_BUCKETS)
+    {
+        return index;
+    }
+
+    size_t shift = index / LATENCY_HISTOGRAM_SUB_BUCKETS - 1;
+
+    return getBucketLowValue(index) + ((uint64_t)1 << shift) - 1;
+}
+
+void LatencyHistogram::record(
+        _In_ uint64_t value)
+{
+    SWSS_LOG_ENTER();
+
+    m_buckets[getBucketIndex(value)]++;
+
+    m_count++;
+    m_sum += value;
+
+    m_min = std::min(m_min, value);
+    m_max = std::max(m_max, value);
+}
+
+void LatencyHistogram::merge(
+        _In_ const LatencyHistogram &other)
+{
+    SWSS_LOG_ENTER();
+
+    for (size_t idx = 0; idx < m_buckets.size(); idx++)
+    {
+        m_buckets[idx] += other.m_buckets[idx];
+    }
+
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+}
+
+void LatencyHistogram::reset()
+{
+    SWSS_LOG_ENTER();
+
+    std::fill(m_buckets.begin(), m_buckets.end(), 0);
+
+    m_count = 0;
+    m_sum = 0;
+    m_min = UINT64_MAX;
+    m_max = 0;
+}
+
+uint64_t LatencyHistogram::getCount() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_count;
+}
+
+uint64_t LatencyHistogram::getMin() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_count ? m_min : 0;
+}
+
+uint64_t LatencyHistogram::getMax() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_max;
+}
+
+uint64_t LatencyHistogram::getMean() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_count ? m_sum / m_count : 0;
+}
+
+uint64_t LatencyHistogram::getPercentile(
+        _In_ double percentile) const
+{
+    SWSS_LOG_ENTER();
+
+    if (m_count == 0)
+    {
+        return 0;
+    }
+
+    uint64_t rank = (uint64_t)((percentile / 100.0) * (double)m_count + 0.5);
+
+    rank = std::max((uint64_t)1, std::min(rank, m_count));
+
+    uint64_t seen = 0;
+
+    for (size_t idx = 0; idx < m_buckets.size(); idx++)
+    {
+        seen += m_buckets[idx];
+
+        if (seen >= rank)
+        {
+            return std::min(getBucketHighValue(idx), m_max);
+        }
+    }
+
+    return m_max;
+}
+
+std::vector<swss::FieldValueTuple> LatencyHistogram::serialize() const
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<swss::FieldValueTuple> values;
+
+    values.emplace_back("count", std::to_string(getCount()));
+    values.emplace_back("min", std::to_string(getMin()));
+    values.emplace_back("max", std::to_string(getMax()));
+    values.emplace_back("mean", std::to_string(getMean()));
+    values.emplace_back("p50", std::to_string(getPercentile(50)));
+    values.emplace_back("p90", std::to_string(getPercentile(90)));
+    values.emplace_back("p99", std::to_string(getPercentile(99)));
+    values.emplace_back("p999", std::to_string(getPercentile(99.9)));
+
+    for (size_t idx = 0; idx < m_buckets.size(); idx++)
+    {
+        if (m_buckets[idx] == 0)
+        {
+            continue;
+        }
+
+        std::string field = "bucket_" +
+            std::to_string(getBucketLowValue(idx)) + "_" +
+            std::to_string(getBucketHighValue(idx));
+
+        values.emplace_back(field, std::to_string(m_buckets[idx]));
+    }
+
+    return values;
+}
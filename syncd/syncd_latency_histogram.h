@@ -0,0 +1,102 @@
+#ifndef __SYNCD_LATENCY_HISTOGRAM_H__
+#define __SYNCD_LATENCY_HISTOGRAM_H__
+
+extern "C" {
+#include "sai.h"
+}
+
+#include <string>
+#include <vector>
+
+#include "swss/table.h"
+
+/**
+ * @def LATENCY_HISTOGRAM_SUB_BUCKET_BITS
+ *
+ * Number of bits used for linear sub buckets in each power of two range. With
+ * 3 bits each range is divided into 8 sub buckets, which gives maximum 12.5%
+ * relative error of reported value, similar to HDR histogram with 1
+ * significant digit.
+ */
+#define LATENCY_HISTOGRAM_SUB_BUCKET_BITS   3
+
+#define LATENCY_HISTOGRAM_SUB_BUCKETS       (1 << LATENCY_HISTOGRAM_SUB_BUCKET_BITS)
+
+#define LATENCY_HISTOGRAM_BUCKETS           (LATENCY_HISTOGRAM_SUB_BUCKETS * (64 - LATENCY_HISTOGRAM_SUB_BUCKET_BITS + 1))
+
+/**
+ * @brief Log-linear latency histogram.
+ *
+ * Records values (usually microseconds or nanoseconds) with constant memory
+ * and constant time per record. This class is not thread safe.
+ */
+class LatencyHistogram
+{
+    public:
+
+        LatencyHistogram();
+
+        virtual ~LatencyHistogram() = default;
+
+    public:
+
+        void record(
+                _In_ uint64_t value);
+
+        void merge(
+                _In_ const LatencyHistogram &other);
+
+        void reset();
+
+        uint64_t getCount() const;
+
+        uint64_t getMin() const;
+
+        uint64_t getMax() const;
+
+        uint64_t getMean() const;
+
+        /**
+         * @brief Gets value at given percentile.
+         *
+         * Returned value is highest value that could be recorded in the
+         * bucket where percentile falls, so it's upper bound of real value.
+         *
+         * @param percentile Percentile in range 0..100.
+         */
+        uint64_t getPercentile(
+                _In_ double percentile) const;
+
+        /**
+         * @brief Serializes histogram summary and all non empty buckets.
+         *
+         * Buckets are serialized as "bucket_LOW_HIGH" fields, where LOW and
+         * HIGH are inclusive values range of the bucket.
+         */
+        std::vector<swss::FieldValueTuple> serialize() const;
+
+    public:
+
+        static size_t getBucketIndex(
+                _In_ uint64_t value);
+
+        static uint64_t getBucketLowValue(
+                _In_ size_t index);
+
+        static uint64_t getBucketHighValue(
+                _In_ size_t index);
+
+    private:
+
+        std::vector<uint64_t> m_buckets;
+
+        uint64_t m_count;
+
+        uint64_t m_min;
+
+        uint64_t m_max;
+
+        uint64_t m_sum;
+};
+
+#endif // __SYNCD_LATENCY_HISTOGRAM_H__
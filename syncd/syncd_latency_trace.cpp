@@ -0,0 +1,347 @@
+#include "syncd_latency_trace.h"
+#include "syncd.h"
+#include "sairedis.h"
+
+#include "swss/redisreply.h"
+
+#include <chrono>
+
+OperationTrace LatencyTrace::m_current;
+bool LatencyTrace::m_enabled = false;
+bool LatencyTrace::m_active = false;
+uint64_t LatencyTrace::m_nextId = 0;
+uint64_t LatencyTrace::m_lastSequence = 0;
+uint64_t LatencyTrace::m_sequenceGaps = 0;
+uint64_t LatencyTrace::m_lastPublish = 0;
+std::map<LatencyTrace::HistogramKey, LatencyTrace::StageHistograms> LatencyTrace::m_histograms;
+std::vector<OperationTrace> LatencyTrace::m_traceRing;
+std::shared_ptr<swss::DBConnector> LatencyTrace::m_db;
+std::shared_ptr<swss::DBConnector> LatencyTrace::m_asicDb;
+
+uint64_t LatencyTrace::getTimestamp()
+{
+    SWSS_LOG_ENTER();
+
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+void LatencyTrace::setEnabled(
+        _In_ bool enabled)
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_NOTICE("latency trace %s", enabled ? "enabled" : "disabled");
+
+    m_enabled = enabled;
+
+    g_redisClient->del(SAI_REDIS_TRACE_TABLE);
+}
+
+bool LatencyTrace::isTraced(
+        _In_ const swss::KeyOpFieldsValuesTuple &kco)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_enabled)
+    {
+        return false;
+    }
+
+    const std::string &op = kfvOp(kco);
+
+    return op == "create" || op == "remove" || op == "set" || op == "bulkcreate" || op == "bulkset";
+}
+
+void LatencyTrace::begin(
+        _In_ const swss::KeyOpFieldsValuesTuple &kco)
+{
+    SWSS_LOG_ENTER();
+
+    m_current = OperationTrace();
+
+    m_current.dequeueTime = getTimestamp();
+    m_current.id = ++m_nextId;
+    m_current.api = kfvOp(kco);
+
+    const std::string &key = kfvKey(kco);
+
+    sai_deserialize_object_type(key.substr(0, key.find(":")), m_current.objectType);
+
+    m_active = true;
+
+    swss::RedisReply r(&getAsicDb(), "LPOP " SAI_REDIS_TRACE_TABLE);
+
+    redisReply *reply = r.getContext();
+
+    if (reply->type != REDIS_REPLY_STRING)
+    {
+        /*
+         * Stamps are pushed in the same order as stamped operations, so
+         * missing stamp means sairedis stopped stamping without notifying us.
+         */
+
+        SWSS_LOG_WARN("no trace stamp for %s, disabling latency trace", key.c_str());
+
+        m_enabled = false;
+        return;
+    }
+
+    // value is in format sequence:send_timestamp
+
+    const std::string stamp(reply->str, reply->len);
+
+    size_t pos = stamp.find(":");
+
+    if (pos == std::string::npos)
+    {
+        SWSS_LOG_WARN("invalid trace stamp %s on %s", stamp.c_str(), key.c_str());
+        return;
+    }
+
+    m_current.sequence = std::stoull(stamp.substr(0, pos));
+    m_current.sendTime = std::stoull(stamp.substr(pos + 1));
+
+    if (m_lastSequence != 0 && m_current.sequence != m_lastSequence + 1)
+    {
+        m_sequenceGaps++;
+    }
+
+    m_lastSequence = m_current.sequence;
+}
+
+void LatencyTrace::markDecoded()
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_active)
+    {
+        return;
+    }
+
+    m_current.decodeTime = getTimestamp();
+}
+
+void LatencyTrace::markSaiStart()
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_active)
+    {
+        return;
+    }
+
+    m_current.saiStartTime = getTimestamp();
+}
+
+void LatencyTrace::markSaiEnd()
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_active)
+    {
+        return;
+    }
+
+    m_current.saiEndTime = getTimestamp();
+}
+
+void LatencyTrace::end()
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_active)
+    {
+        return;
+    }
+
+    m_active = false;
+
+    m_current.responseTime = getTimestamp();
+
+    record(m_current);
+
+    if (m_current.responseTime - m_lastPublish >= (uint64_t)SYNCD_LATENCY_PUBLISH_MSECS * 1000000)
+    {
+        publish(false);
+
+        m_lastPublish = m_current.responseTime;
+    }
+}
+
+static void recordInterval(
+        _Inout_ LatencyHistogram &histogram,
+        _In_ uint64_t start,
+        _In_ uint64_t end)
+{
+    SWSS_LOG_ENTER();
+
+    if (start == 0 || end == 0 || end < start)
+    {
+        return;
+    }
+
+    histogram.record((end - start) / 1000);
+}
+
+void LatencyTrace::record(
+        _In_ const OperationTrace &trace)
+{
+    SWSS_LOG_ENTER();
+
+    auto &h = m_histograms[std::make_pair(trace.objectType, trace.api)];
+
+    recordInterval(h.queue, trace.sendTime, trace.dequeueTime);
+    recordInterval(h.decode, trace.dequeueTime, trace.decodeTime);
+    recordInterval(h.sai, trace.saiStartTime, trace.saiEndTime);
+    recordInterval(h.response, trace.saiEndTime, trace.responseTime);
+    recordInterval(h.total, trace.dequeueTime, trace.responseTime);
+    recordInterval(h.endToEnd, trace.sendTime, trace.responseTime);
+
+    h.dirty = true;
+
+    if (m_traceRing.size() < SYNCD_LATENCY_TRACE_RING_SIZE)
+    {
+        m_traceRing.push_back(trace);
+    }
+    else
+    {
+        m_traceRing[(trace.id - 1) % SYNCD_LATENCY_TRACE_RING_SIZE] = trace;
+    }
+}
+
+swss::DBConnector& LatencyTrace::getAsicDb()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_asicDb == nullptr)
+    {
+        m_asicDb = std::make_shared<swss::DBConnector>(ASIC_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
+    }
+
+    return *m_asicDb;
+}
+
+swss::DBConnector& LatencyTrace::getDb()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_db == nullptr)
+    {
+        m_db = std::make_shared<swss::DBConnector>(COUNTERS_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
+    }
+
+    return *m_db;
+}
+
+void LatencyTrace::publish(
+        _In_ bool all)
+{
+    SWSS_LOG_ENTER();
+
+    swss::Table statsTable(&getDb(), SYNCD_LATENCY_STATS_TABLE);
+
+    for (auto &kvp: m_histograms)
+    {
+        auto &h = kvp.second;
+
+        if (!h.dirty && !all)
+        {
+            continue;
+        }
+
+        h.dirty = false;
+
+        std::string prefix = sai_serialize_object_type(kvp.first.first) + ":" + kvp.first.second + ":";
+
+        const std::vector<std::pair<std::string, const LatencyHistogram*>> stages =
+        {
+            { "queue",      &h.queue },
+            { "decode",     &h.decode },
+            { "sai",        &h.sai },
+            { "response",   &h.response },
+            { "total",      &h.total },
+            { "end_to_end", &h.endToEnd },
+        };
+
+        for (const auto &stage: stages)
+        {
+            if (stage.second->getCount() == 0)
+            {
+                continue;
+            }
+
+            statsTable.set(prefix + stage.first, stage.second->serialize(), "");
+        }
+    }
+
+    std::vector<swss::FieldValueTuple> summary;
+
+    summary.emplace_back("operations", std::to_string(m_nextId));
+    summary.emplace_back("last_sequence", std::to_string(m_lastSequence));
+    summary.emplace_back("sequence_gaps", std::to_string(m_sequenceGaps));
+
+    statsTable.set("SUMMARY", summary, "");
+}
+
+void LatencyTrace::dump()
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_NOTICE("dumping latency trace, operations: %lu, recent: %zu",
+            m_nextId,
+            m_traceRing.size());
+
+    publish(true);
+
+    swss::Table traceTable(&getDb(), SYNCD_LATENCY_TRACE_TABLE);
+
+    std::vector<swss::FieldValueTuple> values;
+
+    for (const auto &trace: m_traceRing)
+    {
+        // id => object_type|api|sequence|send|dequeue|decode|sai_start|sai_end|response
+
+        std::string value = sai_serialize_object_type(trace.objectType) + "|" +
+            trace.api + "|" +
+            std::to_string(trace.sequence) + "|" +
+            std::to_string(trace.sendTime) + "|" +
+            std::to_string(trace.dequeueTime) + "|" +
+            std::to_string(trace.decodeTime) + "|" +
+            std::to_string(trace.saiStartTime) + "|" +
+            std::to_string(trace.saiEndTime) + "|" +
+            std::to_string(trace.responseTime);
+
+        values.emplace_back(std::to_string(trace.id), value);
+    }
+
+    traceTable.del("RECENT");
+
+    if (values.size())
+    {
+        traceTable.set("RECENT", values, "");
+    }
+}
+
+LatencyTrace::Scope::Scope(
+        _In_ const swss::KeyOpFieldsValuesTuple &kco)
+{
+    SWSS_LOG_ENTER();
+
+    LatencyTrace::begin(kco);
+}
+
+LatencyTrace::Scope::~Scope()
+{
+    SWSS_LOG_ENTER();
+
+    try
+    {
+        LatencyTrace::end();
+    }
+    catch (const std::exception &e)
+    {
+        SWSS_LOG_ERROR("failed to record latency trace: %s", e.what());
+    }
+}
@@ -0,0 +1,197 @@
+#ifndef __SYNCD_LATENCY_TRACE_H__
+#define __SYNCD_LATENCY_TRACE_H__
+
+extern "C" {
+#include "sai.h"
+}
+
+#include "syncd_latency_histogram.h"
+
+#include "swss/table.h"
+#include "swss/dbconnector.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define SYNCD_LATENCY_STATS_TABLE       "SYNCD_LATENCY_STATS"
+#define SYNCD_LATENCY_TRACE_TABLE       "SYNCD_LATENCY_TRACE"
+
+/**
+ * @def SYNCD_LATENCY_TRACE_RING_SIZE
+ *
+ * Number of most recent operations which stage timestamps are kept for
+ * dump.
+ */
+#define SYNCD_LATENCY_TRACE_RING_SIZE   4096
+
+#define SYNCD_LATENCY_PUBLISH_MSECS     10000
+
+/**
+ * @brief Stage timestamps of single operation received from sairedis.
+ *
+ * All timestamps are nanoseconds of monotonic clock, which is shared by all
+ * processes on the same host. Zero means stage was not reached, or in case
+ * of sequence and send time, that sairedis didn't stamp operation.
+ */
+typedef struct _OperationTrace
+{
+    uint64_t id;
+
+    uint64_t sequence;
+
+    uint64_t sendTime;
+
+    uint64_t dequeueTime;
+
+    uint64_t decodeTime;
+
+    uint64_t saiStartTime;
+
+    uint64_t saiEndTime;
+
+    uint64_t responseTime;
+
+    sai_object_type_t objectType;
+
+    std::string api;
+
+} OperationTrace;
+
+/**
+ * @brief Latency tracing of operations processed by syncd.
+ *
+ * Operation which is currently processed is tracked through all stages, and
+ * each stage duration is recorded in histogram per object type and api.
+ * Histograms are periodically published to COUNTERS_DB and together with
+ * recent operations they can be dumped on demand.
+ *
+ * Methods must be called under g_mutex.
+ */
+class LatencyTrace
+{
+    public:
+
+        /**
+         * @brief Gets monotonic timestamp in nanoseconds.
+         *
+         * Unlike other methods this one is thread safe.
+         */
+        static uint64_t getTimestamp();
+
+        /**
+         * @brief Enables or disables popping of trace stamps.
+         *
+         * Sairedis notifies syncd before it starts pushing stamps and after
+         * it stops, pending stamps are discarded on both.
+         */
+        static void setEnabled(
+                _In_ bool enabled);
+
+        /**
+         * @brief Checks whether operation was stamped by sairedis.
+         *
+         * Only stamped operations are traced, so when tracing is disabled in
+         * sairedis syncd doesn't pay for it.
+         */
+        static bool isTraced(
+                _In_ const swss::KeyOpFieldsValuesTuple &kco);
+
+        /**
+         * @brief Starts tracing of dequeued operation.
+         *
+         * Pops trace stamp of operation from SAI_REDIS_TRACE_TABLE.
+         *
+         * @param kco Operation popped from ASIC_STATE.
+         */
+        static void begin(
+                _In_ const swss::KeyOpFieldsValuesTuple &kco);
+
+        static void markDecoded();
+
+        static void markSaiStart();
+
+        static void markSaiEnd();
+
+        /**
+         * @brief Finishes tracing of current operation and records it.
+         */
+        static void end();
+
+        /**
+         * @brief Publishes all histograms and recent operations to
+         * COUNTERS_DB.
+         */
+        static void dump();
+
+    public:
+
+        /**
+         * @brief Records operation traced from begin to end.
+         */
+        class Scope
+        {
+            public:
+
+                Scope(
+                        _In_ const swss::KeyOpFieldsValuesTuple &kco);
+
+                virtual ~Scope();
+        };
+
+    private:
+
+        struct StageHistograms
+        {
+            LatencyHistogram queue;
+
+            LatencyHistogram decode;
+
+            LatencyHistogram sai;
+
+            LatencyHistogram response;
+
+            LatencyHistogram total;
+
+            LatencyHistogram endToEnd;
+
+            bool dirty = false;
+        };
+
+        typedef std::pair<sai_object_type_t, std::string> HistogramKey;
+
+        static void record(
+                _In_ const OperationTrace &trace);
+
+        static void publish(
+                _In_ bool all);
+
+        static swss::DBConnector& getDb();
+
+        static swss::DBConnector& getAsicDb();
+
+        static OperationTrace m_current;
+
+        static bool m_enabled;
+
+        static bool m_active;
+
+        static uint64_t m_nextId;
+
+        static uint64_t m_lastSequence;
+
+        static uint64_t m_sequenceGaps;
+
+        static uint64_t m_lastPublish;
+
+        static std::map<HistogramKey, StageHistograms> m_histograms;
+
+        static std::vector<OperationTrace> m_traceRing;
+
+        static std::shared_ptr<swss::DBConnector> m_db;
+
+        static std::shared_ptr<swss::DBConnector> m_asicDb;
+};
+
+#endif // __SYNCD_LATENCY_TRACE_H__
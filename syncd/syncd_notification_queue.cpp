@@ -0,0 +1,397 @@
+#include "syncd_notification_queue.h"
+
+#include "swss/logger.h"
+
+#include <algorithm>
+
+NotificationQueue::NotificationQueue(
+        _In_ const std::vector<size_t> &sizes,
+        _In_ const std::vector<bool> &critical):
+    m_consumerWaiting(false),
+    m_wakeup(false)
+{
+    SWSS_LOG_ENTER();
+
+    if (sizes.empty())
+    {
+        SWSS_LOG_THROW("notification queue requires at least one ring");
+    }
+
+    if (critical.size() && critical.size() != sizes.size())
+    {
+        SWSS_LOG_THROW("critical flags count %zu don't match rings count %zu", critical.size(), sizes.size());
+    }
+
+    for (size_t priority = 0; priority < sizes.size(); priority++)
+    {
+        size_t size = sizes[priority];
+
+        size_t capacity = 2;
+
+        while (capacity < size)
+        {
+            capacity <<= 1;
+        }
+
+        std::unique_ptr<Ring> ring(new Ring());
+
+        ring->mask = capacity - 1;
+        ring->cells.reset(new Cell[capacity]);
+        ring->enqueuePos = 0;
+        ring->dequeuePos = 0;
+        ring->enqueued = 0;
+        ring->dropped = 0;
+        ring->coalesced = 0;
+        ring->maxDepth = 0;
+        ring->critical = critical.size() ? critical[priority] : false;
+        ring->overflowed = 0;
+        ring->overflowSize = 0;
+
+        for (size_t idx = 0; idx < capacity; idx++)
+        {
+            ring->cells[idx].sequence.store(idx, std::memory_order_relaxed);
+        }
+
+        m_rings.push_back(std::move(ring));
+    }
+}
+
+NotificationQueue::Ring& NotificationQueue::getRing(
+        _In_ size_t priority) const
+{
+    SWSS_LOG_ENTER();
+
+    if (priority >= m_rings.size())
+    {
+        SWSS_LOG_THROW("invalid notification priority %zu, rings: %zu", priority, m_rings.size());
+    }
+
+    return *m_rings[priority];
+}
+
+bool NotificationQueue::enqueue(
+        _In_ size_t priority,
+        _In_ swss::KeyOpFieldsValuesTuple &&item)
+{
+    SWSS_LOG_ENTER();
+
+    Ring &ring = getRing(priority);
+
+    if (ring.critical && ring.overflowSize.load(std::memory_order_acquire))
+    {
+        /*
+         * Overflow list is not drained yet, notification can't go to ring
+         * ahead of older notifications.
+         */
+
+        enqueueOverflow(ring, std::move(item));
+
+        return true;
+    }
+
+    Cell *cell;
+
+    size_t pos = ring.enqueuePos.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        cell = &ring.cells[pos & ring.mask];
+
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+        if (diff == 0)
+        {
+            if (ring.enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            if (ring.critical)
+            {
+                enqueueOverflow(ring, std::move(item));
+
+                return true;
+            }
+
+            /*
+             * Ring is full, we can't block vendor SDK thread so drop
+             * notification, processing thread will report drops.
+             */
+
+            ring.dropped++;
+
+            return false;
+        }
+        else
+        {
+            pos = ring.enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->item = std::move(item);
+
+    ring.enqueued++;
+
+    /*
+     * Sequentially consistent store and load pairs with wait(), either
+     * consumer will see this item before going to sleep, or we will see that
+     * consumer is waiting.
+     */
+
+    cell->sequence.store(pos + 1, std::memory_order_seq_cst);
+
+    notifyConsumer();
+
+    return true;
+}
+
+void NotificationQueue::enqueueOverflow(
+        _In_ Ring &ring,
+        _In_ swss::KeyOpFieldsValuesTuple &&item)
+{
+    SWSS_LOG_ENTER();
+
+    {
+        std::lock_guard<std::mutex> lock(ring.overflowMutex);
+
+        ring.overflow.push_back(std::move(item));
+
+        ring.overflowSize.store(ring.overflow.size(), std::memory_order_seq_cst);
+    }
+
+    ring.overflowed++;
+    ring.enqueued++;
+
+    notifyConsumer();
+}
+
+void NotificationQueue::notifyConsumer()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_consumerWaiting.load(std::memory_order_seq_cst))
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_cv.notify_one();
+    }
+}
+
+bool NotificationQueue::tryDequeue(
+        _In_ size_t priority,
+        _Out_ swss::KeyOpFieldsValuesTuple &item)
+{
+    SWSS_LOG_ENTER();
+
+    Ring &ring = getRing(priority);
+
+    size_t pos = ring.dequeuePos.load(std::memory_order_relaxed);
+
+    Cell *cell = &ring.cells[pos & ring.mask];
+
+    size_t seq = cell->sequence.load(std::memory_order_acquire);
+
+    if ((intptr_t)seq - (intptr_t)(pos + 1) < 0)
+    {
+        if (ring.overflowSize.load(std::memory_order_acquire) == 0)
+        {
+            return false;
+        }
+
+        /*
+         * Ring is empty, so all notifications left are in overflow list.
+         */
+
+        std::lock_guard<std::mutex> lock(ring.overflowMutex);
+
+        item = std::move(ring.overflow.front());
+
+        ring.overflow.pop_front();
+
+        ring.overflowSize.store(ring.overflow.size(), std::memory_order_release);
+
+        return true;
+    }
+
+    item = std::move(cell->item);
+
+    cell->item = swss::KeyOpFieldsValuesTuple();
+
+    cell->sequence.store(pos + ring.mask + 1, std::memory_order_release);
+
+    ring.dequeuePos.store(pos + 1, std::memory_order_relaxed);
+
+    return true;
+}
+
+bool NotificationQueue::tryDequeue(
+        _Out_ swss::KeyOpFieldsValuesTuple &item)
+{
+    SWSS_LOG_ENTER();
+
+    for (size_t priority = 0; priority < m_rings.size(); priority++)
+    {
+        if (tryDequeue(priority, item))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool NotificationQueue::ringEmpty(
+        _In_ const Ring &ring)
+{
+    SWSS_LOG_ENTER();
+
+    size_t pos = ring.dequeuePos.load(std::memory_order_relaxed);
+
+    const Cell *cell = &ring.cells[pos & ring.mask];
+
+    return (intptr_t)cell->sequence.load(std::memory_order_seq_cst) - (intptr_t)(pos + 1) < 0 &&
+        ring.overflowSize.load(std::memory_order_seq_cst) == 0;
+}
+
+bool NotificationQueue::empty() const
+{
+    SWSS_LOG_ENTER();
+
+    for (const auto &ring: m_rings)
+    {
+        if (!ringEmpty(*ring))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void NotificationQueue::wait(
+        _In_ std::chrono::milliseconds timeout)
+{
+    SWSS_LOG_ENTER();
+
+    for (size_t priority = 0; priority < m_rings.size(); priority++)
+    {
+        Ring &ring = *m_rings[priority];
+
+        ring.maxDepth = std::max(ring.maxDepth, getDepth(priority));
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_consumerWaiting.store(true, std::memory_order_seq_cst);
+
+    m_cv.wait_for(lock, timeout, [&]{ return m_wakeup || !empty(); });
+
+    m_consumerWaiting.store(false, std::memory_order_relaxed);
+
+    m_wakeup = false;
+}
+
+void NotificationQueue::wakeup()
+{
+    SWSS_LOG_ENTER();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_wakeup = true;
+
+    m_cv.notify_one();
+}
+
+size_t NotificationQueue::getPriorityCount() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_rings.size();
+}
+
+size_t NotificationQueue::getDepth(
+        _In_ size_t priority) const
+{
+    SWSS_LOG_ENTER();
+
+    const Ring &ring = getRing(priority);
+
+    size_t enqueuePos = ring.enqueuePos.load(std::memory_order_relaxed);
+    size_t dequeuePos = ring.dequeuePos.load(std::memory_order_relaxed);
+
+    size_t depth = enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+
+    return depth + ring.overflowSize.load(std::memory_order_relaxed);
+}
+
+size_t NotificationQueue::getCapacity(
+        _In_ size_t priority) const
+{
+    SWSS_LOG_ENTER();
+
+    return getRing(priority).mask + 1;
+}
+
+uint64_t NotificationQueue::getEnqueuedCount(
+        _In_ size_t priority) const
+{
+    SWSS_LOG_ENTER();
+
+    return getRing(priority).enqueued.load();
+}
+
+uint64_t NotificationQueue::getDroppedCount(
+        _In_ size_t priority) const
+{
+    SWSS_LOG_ENTER();
+
+    return getRing(priority).dropped.load();
+}
+
+uint64_t NotificationQueue::getOverflowCount(
+        _In_ size_t priority) const
+{
+    SWSS_LOG_ENTER();
+
+    return getRing(priority).overflowed.load();
+}
+
+uint64_t NotificationQueue::getCoalescedCount(
+        _In_ size_t priority) const
+{
+    SWSS_LOG_ENTER();
+
+    return getRing(priority).coalesced.load();
+}
+
+void NotificationQueue::addCoalescedCount(
+        _In_ size_t priority,
+        _In_ uint64_t count)
+{
+    SWSS_LOG_ENTER();
+
+    getRing(priority).coalesced += count;
+}
+
+std::vector<swss::FieldValueTuple> NotificationQueue::getStats(
+        _In_ size_t priority) const
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<swss::FieldValueTuple> values;
+
+    values.emplace_back("priority", std::to_string(priority));
+    values.emplace_back("capacity", std::to_string(getCapacity(priority)));
+    values.emplace_back("depth", std::to_string(getDepth(priority)));
+    values.emplace_back("max_depth", std::to_string(getRing(priority).maxDepth));
+    values.emplace_back("enqueued", std::to_string(getEnqueuedCount(priority)));
+    values.emplace_back("dropped", std::to_string(getDroppedCount(priority)));
+    values.emplace_back("overflow", std::to_string(getOverflowCount(priority)));
+    values.emplace_back("coalesced", std::to_string(getCoalescedCount(priority)));
+
+    return values;
+}
@@ -0,0 +1,202 @@
+#ifndef __SYNCD_NOTIFICATION_QUEUE_H__
+#define __SYNCD_NOTIFICATION_QUEUE_H__
+
+extern "C" {
+#include "sai.h"
+}
+
+#include "swss/table.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+/**
+ * @def SYNCD_NOTIFICATION_QUEUE_DEFAULT_SIZE
+ *
+ * Default number of notifications that can wait for processing, when queue
+ * is full new notifications are dropped, unless ring is critical.
+ */
+#define SYNCD_NOTIFICATION_QUEUE_DEFAULT_SIZE   (64 * 1024)
+
+/**
+ * @brief Bounded multiple producers single consumer notification queue.
+ *
+ * Queue consists of multiple rings with strict priority, ring 0 has highest
+ * priority, and lower priority ring is dequeued only when all higher
+ * priority rings are empty. Order is preserved only inside single ring.
+ *
+ * Producers are SAI notification callbacks executed in vendor SDK context,
+ * which never block on enqueue. Enqueue is lock free unless consumer is
+ * sleeping on empty queue, then producer will take mutex only to wake it up.
+ *
+ * Notifications of critical ring are never dropped, when critical ring is
+ * full they are put into overflow list under mutex, and all following
+ * notifications of that ring go there too, until consumer drains it, so
+ * order is preserved.
+ *
+ * Dequeue and wait must be called only from single consumer thread.
+ */
+class NotificationQueue
+{
+    public:
+
+        /**
+         * @brief Creates notification queue.
+         *
+         * @param sizes Capacity of each priority ring, rounded up to power of
+         * 2, first ring has highest priority.
+         * @param critical Flag for each priority ring, if notifications of
+         * this ring must never be dropped, empty for none.
+         */
+        NotificationQueue(
+                _In_ const std::vector<size_t> &sizes,
+                _In_ const std::vector<bool> &critical = std::vector<bool>());
+
+        virtual ~NotificationQueue() = default;
+
+    public:
+
+        /**
+         * @brief Enqueues notification.
+         *
+         * @param priority Index of priority ring.
+         * @param item Notification.
+         *
+         * @return True on success, false when ring is full and notification
+         * was dropped. Enqueue to critical ring always succeeds.
+         */
+        bool enqueue(
+                _In_ size_t priority,
+                _In_ swss::KeyOpFieldsValuesTuple &&item);
+
+        /**
+         * @brief Dequeues notification from highest priority non empty ring.
+         */
+        bool tryDequeue(
+                _Out_ swss::KeyOpFieldsValuesTuple &item);
+
+        /**
+         * @brief Dequeues notification from given priority ring only.
+         */
+        bool tryDequeue(
+                _In_ size_t priority,
+                _Out_ swss::KeyOpFieldsValuesTuple &item);
+
+        /**
+         * @brief Waits until queue is not empty, timeout expires, or wakeup
+         * was called.
+         */
+        void wait(
+                _In_ std::chrono::milliseconds timeout);
+
+        void wakeup();
+
+        bool empty() const;
+
+        size_t getPriorityCount() const;
+
+        size_t getDepth(
+                _In_ size_t priority) const;
+
+        size_t getCapacity(
+                _In_ size_t priority) const;
+
+        uint64_t getEnqueuedCount(
+                _In_ size_t priority) const;
+
+        uint64_t getDroppedCount(
+                _In_ size_t priority) const;
+
+        /**
+         * @brief Gets number of notifications which were put into overflow
+         * list of critical ring, since ring was full.
+         */
+        uint64_t getOverflowCount(
+                _In_ size_t priority) const;
+
+        uint64_t getCoalescedCount(
+                _In_ size_t priority) const;
+
+        void addCoalescedCount(
+                _In_ size_t priority,
+                _In_ uint64_t count);
+
+        /**
+         * @brief Serializes statistics of given priority ring.
+         */
+        std::vector<swss::FieldValueTuple> getStats(
+                _In_ size_t priority) const;
+
+    private:
+
+        NotificationQueue(const NotificationQueue&);
+        NotificationQueue& operator=(const NotificationQueue&);
+
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+
+            swss::KeyOpFieldsValuesTuple item;
+        };
+
+        struct Ring
+        {
+            size_t mask;
+
+            std::unique_ptr<Cell[]> cells;
+
+            std::atomic<size_t> enqueuePos;
+
+            std::atomic<size_t> dequeuePos;
+
+            std::atomic<uint64_t> enqueued;
+
+            std::atomic<uint64_t> dropped;
+
+            std::atomic<uint64_t> coalesced;
+
+            size_t maxDepth;
+
+            bool critical;
+
+            std::atomic<uint64_t> overflowed;
+
+            /**
+             * @brief Number of notifications in overflow list, readable
+             * without lock.
+             */
+            std::atomic<size_t> overflowSize;
+
+            std::deque<swss::KeyOpFieldsValuesTuple> overflow;
+
+            std::mutex overflowMutex;
+        };
+
+        Ring& getRing(
+                _In_ size_t priority) const;
+
+        static bool ringEmpty(
+                _In_ const Ring &ring);
+
+        void enqueueOverflow(
+                _In_ Ring &ring,
+                _In_ swss::KeyOpFieldsValuesTuple &&item);
+
+        void notifyConsumer();
+
+        std::vector<std::unique_ptr<Ring>> m_rings;
+
+        std::atomic<bool> m_consumerWaiting;
+
+        bool m_wakeup;
+
+        std::mutex m_mutex;
+
+        std::condition_variable m_cv;
+};
+
+#endif // __SYNCD_NOTIFICATION_QUEUE_H__
@@ -1,9 +1,19 @@
 #include "syncd.h"
 #include "sairedis.h"
+#include "syncd_flex_counter.h"
+#include "syncd_notification_queue.h"
+#include "syncd_latency_trace.h"
 
-#include <queue>
+#include <atomic>
 #include <memory>
-#include <condition_variable>
+#include <unordered_map>
+
+/*
+ * Sequence number and time when notification which is currently processed
+ * was received from SAI, they are forwarded to notification consumer so it
+ * can measure delivery latency.
+ */
+std::vector<swss::FieldValueTuple> g_notificationStamps;
 
 void send_notification(
         _In_ std::string op,
@@ -14,6 +24,10 @@ void send_notification(
 
     SWSS_LOG_INFO("%s %s", op.c_str(), data.c_str());
 
+    entry.insert(entry.end(), g_notificationStamps.begin(), g_notificationStamps.end());
+
+    entry.emplace_back(SYNCD_NOTIFICATION_SEND_TIMESTAMP, std::to_string(LatencyTrace::getTimestamp()));
+
     notifications->send(op, data, entry);
 
     SWSS_LOG_DEBUG("notification send successfull");
@@ -63,18 +77,122 @@ sai_fdb_entry_type_t getFdbEntryType(
     return (sai_fdb_entry_type_t)ret;
 }
 
-void redisPutFdbEntryToAsicView(
-        _In_ const sai_fdb_event_notification_data_t *fdb)
+/*
+ * Maximum number of commands appended to redis pipeline before replies are
+ * read, this limits memory used by output buffers on both sides.
+ */
+#define FDB_ASIC_VIEW_PIPELINE_MAX  1024
+
+/**
+ * @brief Pipelined ASIC_STATE updates for fdb events.
+ *
+ * All commands are appended to output buffer of dedicated connection and
+ * replies are read once per batch, so whole fdb event batch is single round
+ * trip to redis instead of one round trip per field.
+ *
+ * Must be used under g_mutex like all other ASIC view updates.
+ */
+class FdbAsicViewPipeline
 {
-    // NOTE: this fdb entry already contains translated RID to VID
+    public:
 
-    std::vector<swss::FieldValueTuple> entry;
+        FdbAsicViewPipeline():
+            m_pending(0)
+        {
+            SWSS_LOG_ENTER();
 
-    entry = SaiAttributeList::serialize_attr_list(
-            SAI_OBJECT_TYPE_FDB_ENTRY,
-            fdb->attr_count,
-            fdb->attr,
-            false);
+            if (m_db == nullptr)
+            {
+                m_db = std::make_shared<swss::DBConnector>(ASIC_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
+            }
+        }
+
+        virtual ~FdbAsicViewPipeline()
+        {
+            SWSS_LOG_ENTER();
+
+            /*
+             * Replies must be always consumed, otherwise they would be read
+             * as replies of next batch.
+             */
+
+            try
+            {
+                flush();
+            }
+            catch (const std::exception &e)
+            {
+                SWSS_LOG_ERROR("failed to flush fdb pipeline: %s", e.what());
+            }
+        }
+
+    public:
+
+        void append(
+                _In_ const std::vector<std::string> &args)
+        {
+            SWSS_LOG_ENTER();
+
+            std::vector<const char*> argv;
+            std::vector<size_t> argvlen;
+
+            for (const auto &a: args)
+            {
+                argv.push_back(a.c_str());
+                argvlen.push_back(a.size());
+            }
+
+            if (redisAppendCommandArgv(m_db->getContext(), (int)argv.size(), argv.data(), argvlen.data()) != REDIS_OK)
+            {
+                SWSS_LOG_THROW("failed to append %s command to redis pipeline", args.front().c_str());
+            }
+
+            if (++m_pending >= FDB_ASIC_VIEW_PIPELINE_MAX)
+            {
+                flush();
+            }
+        }
+
+        void flush()
+        {
+            SWSS_LOG_ENTER();
+
+            for (; m_pending > 0; m_pending--)
+            {
+                void *r = NULL;
+
+                if (redisGetReply(m_db->getContext(), &r) != REDIS_OK || r == NULL)
+                {
+                    SWSS_LOG_THROW("failed to get redis pipeline reply: %s", m_db->getContext()->errstr);
+                }
+
+                redisReply *reply = (redisReply*)r;
+
+                if (reply->type == REDIS_REPLY_ERROR)
+                {
+                    SWSS_LOG_ERROR("redis pipeline command failed: %s", reply->str);
+                }
+
+                freeReplyObject(reply);
+            }
+        }
+
+    private:
+
+        static std::shared_ptr<swss::DBConnector> m_db;
+
+        size_t m_pending;
+};
+
+std::shared_ptr<swss::DBConnector> FdbAsicViewPipeline::m_db;
+
+void redisPutFdbEntryToAsicView(
+        _In_ const sai_fdb_event_notification_data_t *fdb,
+        _Inout_ FdbAsicViewPipeline &pipeline)
+{
+    SWSS_LOG_ENTER();
+
+    // NOTE: this fdb entry already contains translated RID to VID
 
     sai_object_type_t objectType = SAI_OBJECT_TYPE_FDB_ENTRY;
 
@@ -92,14 +210,20 @@ void redisPutFdbEntryToAsicView(
         return;
     }
 
-    for (const auto &e: entry)
+    if (fdb->event_type == SAI_FDB_EVENT_AGED)
     {
-        const std::string &strField = fvField(e);
-        const std::string &strValue = fvValue(e);
-
-        g_redisClient->hset(key, strField, strValue);
+        pipeline.append({ "DEL", key });
+        return;
     }
 
+    std::vector<swss::FieldValueTuple> entry;
+
+    entry = SaiAttributeList::serialize_attr_list(
+            SAI_OBJECT_TYPE_FDB_ENTRY,
+            fdb->attr_count,
+            fdb->attr,
+            false);
+
     // currently we need to add type manually since fdb event don't contain type
     sai_attribute_t attr;
 
@@ -119,10 +243,17 @@ void redisPutFdbEntryToAsicView(
          */
     }
 
-    std::string strAttrId = sai_serialize_attr_id(*meta);
-    std::string strAttrValue = sai_serialize_attr_value(*meta, attr);
+    entry.emplace_back(sai_serialize_attr_id(*meta), sai_serialize_attr_value(*meta, attr));
+
+    std::vector<std::string> args = { "HMSET", key };
 
-    g_redisClient->hset(key, strAttrId, strAttrValue);
+    for (const auto &e: entry)
+    {
+        args.push_back(fvField(e));
+        args.push_back(fvValue(e));
+    }
+
+    pipeline.append(args);
 }
 
 void process_on_fdb_event(
@@ -133,16 +264,45 @@ void process_on_fdb_event(
 
     SWSS_LOG_DEBUG("fdb event count: %d", count);
 
+    FdbAsicViewPipeline pipeline;
+
+    /*
+     * Whole batch usually refers to the same switch and few bridges, so
+     * translate each of them only once.
+     */
+
+    std::unordered_map<sai_object_id_t, sai_object_id_t> switchVids;
+    std::unordered_map<sai_object_id_t, sai_object_id_t> bridgeVids;
+
     for (uint32_t i = 0; i < count; i++)
     {
         sai_fdb_event_notification_data_t *fdb = &data[i];
 
         SWSS_LOG_DEBUG("fdb %u: type: %d", i, fdb->event_type);
 
-        fdb->fdb_entry.switch_id = translate_rid_to_vid(fdb->fdb_entry.switch_id, SAI_NULL_OBJECT_ID);
+        sai_object_id_t switchRid = fdb->fdb_entry.switch_id;
+
+        auto sit = switchVids.find(switchRid);
+
+        if (sit == switchVids.end())
+        {
+            sit = switchVids.emplace(switchRid, translate_rid_to_vid(switchRid, SAI_NULL_OBJECT_ID)).first;
+        }
+
+        fdb->fdb_entry.switch_id = sit->second;
 
         // TODO later it should be bv_id
-        fdb->fdb_entry.bridge_id = translate_rid_to_vid(fdb->fdb_entry.bridge_id, fdb->fdb_entry.switch_id);
+
+        sai_object_id_t bridgeRid = fdb->fdb_entry.bridge_id;
+
+        auto bit = bridgeVids.find(bridgeRid);
+
+        if (bit == bridgeVids.end())
+        {
+            bit = bridgeVids.emplace(bridgeRid, translate_rid_to_vid(bridgeRid, fdb->fdb_entry.switch_id)).first;
+        }
+
+        fdb->fdb_entry.bridge_id = bit->second;
 
         translate_rid_to_vid_list(SAI_OBJECT_TYPE_FDB_ENTRY, fdb->fdb_entry.switch_id, fdb->attr_count, fdb->attr);
 
@@ -152,9 +312,15 @@ void process_on_fdb_event(
          * required on creation.
          */
 
-        redisPutFdbEntryToAsicView(fdb);
+        redisPutFdbEntryToAsicView(fdb, pipeline);
     }
 
+    pipeline.flush();
+
+    /*
+     * All events from batch are sent to orch agent as single notification.
+     */
+
     std::string s = sai_serialize_fdb_event_ntf(count, data);
 
     send_notification("fdb_event", s);
@@ -172,6 +338,8 @@ void process_on_port_state_change(
     {
         sai_port_oper_status_notification_t *oper_stat = &data[i];
 
+        FlexCounter::updatePortOperStatus(oper_stat->port_id, oper_stat->port_state);
+
         /*
          * We are using switch_rid as null, since port should be already
          * defined inside local db after creation.
@@ -201,6 +369,35 @@ void process_on_switch_shutdown_request(
     send_notification("switch_shutdown_request", s);
 }
 
+void process_on_queue_deadlock(
+        _In_ uint32_t count,
+        _In_ sai_queue_deadlock_notification_data_t *data)
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_DEBUG("queue deadlock notification count: %u", count);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        sai_queue_deadlock_notification_data_t *deadlock_data = &data[i];
+
+        /*
+         * We are using switch_rid as null, since queue should be already
+         * defined inside local db after creation.
+         *
+         * If this will be faster than return from create queue then we can use
+         * query switch id and extract rid of switch id and then convert it to
+         * switch vid.
+         */
+
+        deadlock_data->queue_id = translate_rid_to_vid(deadlock_data->queue_id, SAI_NULL_OBJECT_ID);
+    }
+
+    std::string s = sai_serialize_queue_deadlock_ntf(count, data);
+
+    send_notification("queue_deadlock", s);
+}
+
 void handle_switch_state_change(
         _In_ const std::string &data)
 {
@@ -256,6 +453,21 @@ void handle_switch_shutdown_request(
     process_on_switch_shutdown_request(switch_id);
 }
 
+void handle_queue_deadlock(
+        _In_ const std::string &data)
+{
+    SWSS_LOG_ENTER();
+
+    uint32_t count;
+    sai_queue_deadlock_notification_data_t *deadlock = NULL;
+
+    sai_deserialize_queue_deadlock_ntf(data, count, &deadlock);
+
+    process_on_queue_deadlock(count, deadlock);
+
+    sai_deserialize_free_queue_deadlock_ntf(count, deadlock);
+}
+
 void processNotification(
         _In_ const swss::KeyOpFieldsValuesTuple &item)
 {
@@ -266,6 +478,16 @@ void processNotification(
     std::string notification = kfvKey(item);
     std::string data = kfvOp(item);
 
+    g_notificationStamps.clear();
+
+    for (const auto &fv: kfvFieldsValues(item))
+    {
+        if (fvField(fv) == SYNCD_NOTIFICATION_TIMESTAMP || fvField(fv) == SYNCD_NOTIFICATION_SEQUENCE)
+        {
+            g_notificationStamps.push_back(fv);
+        }
+    }
+
     if (notification == "switch_state_change")
     {
         handle_switch_state_change(data);
@@ -282,18 +504,93 @@ void processNotification(
     {
         handle_switch_shutdown_request(data);
     }
+    else if (notification == "queue_deadlock")
+    {
+        handle_queue_deadlock(data);
+    }
     else
     {
         SWSS_LOG_ERROR("unknow notification: %s", notification.c_str());
     }
+
+    g_notificationStamps.clear();
+}
+
+typedef struct _notification_priority_t
+{
+    std::string name;
+
+    size_t size;
+
+    /**
+     * @brief Notification is never dropped, since orchagent would stay out
+     * of sync with hardware.
+     */
+    bool critical;
+
+} notification_priority_t;
+
+/*
+ * Notification types in strict priority order, each type has its own ring.
+ * Shutdown request, port state and queue deadlock are processed ahead of fdb
+ * events, so port flap is not delayed by fdb learning storm.
+ */
+static const std::vector<notification_priority_t> g_notificationPriorities =
+{
+    { "switch_shutdown_request",    64,                                     true },
+    { "port_state_change",          4096,                                   true },
+    { "queue_deadlock",             4096,                                   true },
+    { "switch_state_change",        64,                                     true },
+    { "fdb_event",                  SYNCD_NOTIFICATION_QUEUE_DEFAULT_SIZE,  false },
+};
+
+std::shared_ptr<NotificationQueue> createNotificationQueue()
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<size_t> sizes;
+    std::vector<bool> critical;
+
+    for (const auto &p: g_notificationPriorities)
+    {
+        sizes.push_back(p.size);
+        critical.push_back(p.critical);
+    }
+
+    return std::make_shared<NotificationQueue>(sizes, critical);
+}
+
+size_t getNotificationPriority(
+        _In_ const std::string &notification)
+{
+    SWSS_LOG_ENTER();
+
+    for (size_t idx = 0; idx < g_notificationPriorities.size(); idx++)
+    {
+        if (g_notificationPriorities[idx].name == notification)
+        {
+            return idx;
+        }
+    }
+
+    SWSS_LOG_THROW("notification %s has no priority defined", notification.c_str());
 }
 
-// condition variable will be used to notify processing thread
-// that some notiffication arrived
+/*
+ * Queue between SAI notifications context and notifications processing
+ * thread. SAI callbacks are executed by vendor SDK, and they should never
+ * block, so enqueue is lock free and notification is dropped when queue is
+ * full, except critical notifications which go to overflow list.
+ */
 
-std::condition_variable cv;
-std::mutex queue_mutex;
-std::queue<swss::KeyOpFieldsValuesTuple> ntf_queue;
+std::shared_ptr<NotificationQueue> g_notificationQueue = createNotificationQueue();
+
+/*
+ * Sequence number of last notification per type, dropped notifications also
+ * consume sequence number, so consumer can detect them.
+ */
+static std::unique_ptr<std::atomic<uint64_t>[]> g_notificationSequence(
+        new std::atomic<uint64_t>[g_notificationPriorities.size()]());
 
 void enqueue_notification(
         _In_ std::string op,
@@ -304,15 +601,17 @@ void enqueue_notification(
 
     SWSS_LOG_INFO("%s %s", op.c_str(), data.c_str());
 
-    swss::KeyOpFieldsValuesTuple item(op, data, entry);
-
-    // this is notification context, so we need to protect queue
+    size_t priority = getNotificationPriority(op);
 
-    std::lock_guard<std::mutex> lock(queue_mutex);
+    entry.emplace_back(SYNCD_NOTIFICATION_SEQUENCE, std::to_string(++g_notificationSequence[priority]));
+    entry.emplace_back(SYNCD_NOTIFICATION_TIMESTAMP, std::to_string(LatencyTrace::getTimestamp()));
 
-    ntf_queue.push(item);
+    swss::KeyOpFieldsValuesTuple item(op, data, entry);
 
-    cv.notify_all();
+    if (!g_notificationQueue->enqueue(priority, std::move(item)))
+    {
+        SWSS_LOG_DEBUG("notification queue is full, dropped %s", op.c_str());
+    }
 }
 
 void enqueue_notification(
@@ -366,7 +665,7 @@ void on_switch_shutdown_request(
 
     std::string s = sai_serialize_switch_shutdown_request(switch_id);
 
-    enqueue_notification("switch_shutdown_request", "");
+    enqueue_notification("switch_shutdown_request", s);
 }
 
 void on_packet_event(
@@ -385,36 +684,208 @@ void on_packet_event(
 
 volatile bool runThread;
 
-std::mutex ntf_mutex;
-std::unique_lock<std::mutex> ulock(ntf_mutex);
+#define NOTIFICATION_STATS_TABLE            "NOTIFICATION_STATS"
+#define NOTIFICATION_STATS_QUEUE            "QUEUE"
+#define NOTIFICATION_STATS_PUBLISH_MSECS    1000
+
+/*
+ * Maximum number of fdb_event notifications merged together, this limits time
+ * spent under g_mutex when processing single coalesced notification.
+ */
+#define FDB_EVENT_COALESCE_MAX_RUN          4096
+
+/*
+ * Time in milliseconds for which fdb events are hold in processing thread, so
+ * more events for the same MAC/BV could be coalesced. When zero, only events
+ * which are already waiting in the queue are coalesced.
+ */
+uint32_t g_fdbCoalesceWindow = 0;
+
+void setFdbCoalesceWindow(
+        _In_ uint32_t msec)
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_NOTICE("fdb event coalesce window set to %u ms", msec);
 
-bool tryDequeue(
-        _Out_ swss::KeyOpFieldsValuesTuple &item)
+    g_fdbCoalesceWindow = msec;
+}
+
+/**
+ * @brief Merges multiple fdb_event notifications into single notification.
+ *
+ * Only latest event for given fdb entry (MAC, bridge) is preserved, at the
+ * position of first event for that entry. Flush event is never merged, and
+ * events after flush are not merged with events before it, since flush could
+ * affect entries by wildcard.
+ */
+void processFdbEventRun(
+        _Inout_ std::vector<swss::KeyOpFieldsValuesTuple> &run)
 {
-    std::lock_guard<std::mutex> lock(queue_mutex);
+    SWSS_LOG_ENTER();
+
+    if (run.empty())
+    {
+        return;
+    }
+
+    if (run.size() == 1)
+    {
+        processNotification(run.front());
+
+        run.clear();
+
+        return;
+    }
+
+    std::vector<std::pair<uint32_t, sai_fdb_event_notification_data_t*>> deserialized;
+
+    std::vector<sai_fdb_event_notification_data_t> events;
+
+    std::unordered_map<std::string, size_t> positions;
+
+    uint64_t coalesced = 0;
+
+    for (const auto &item: run)
+    {
+        uint32_t count;
+        sai_fdb_event_notification_data_t *fdbevent = NULL;
+
+        sai_deserialize_fdb_event_ntf(kfvOp(item), count, &fdbevent);
+
+        deserialized.emplace_back(count, fdbevent);
+
+        for (uint32_t idx = 0; idx < count; idx++)
+        {
+            const sai_fdb_event_notification_data_t &event = fdbevent[idx];
+
+            if (event.event_type == SAI_FDB_EVENT_FLUSHED)
+            {
+                positions.clear();
+
+                events.push_back(event);
+
+                continue;
+            }
+
+            std::string key = sai_serialize_fdb_entry(event.fdb_entry);
+
+            auto it = positions.find(key);
+
+            if (it == positions.end())
+            {
+                positions[key] = events.size();
+
+                events.push_back(event);
+
+                continue;
+            }
+
+            events[it->second] = event;
+
+            coalesced++;
+        }
+    }
+
+    SWSS_LOG_DEBUG("merged %zu fdb notifications, %zu events, %lu coalesced",
+            run.size(),
+            events.size(),
+            coalesced);
+
+    std::string s = sai_serialize_fdb_event_ntf((uint32_t)events.size(), events.data());
+
+    for (auto &d: deserialized)
+    {
+        sai_deserialize_free_fdb_event_ntf(d.first, d.second);
+    }
+
+    g_notificationQueue->addCoalescedCount(getNotificationPriority("fdb_event"), coalesced);
+
+    /*
+     * Merged notification inherits timestamp of the oldest event.
+     */
 
+    std::vector<swss::FieldValueTuple> entry = kfvFieldsValues(run.front());
+
+    processNotification(swss::KeyOpFieldsValuesTuple("fdb_event", s, entry));
+
+    run.clear();
+}
+
+void publishNotificationQueueStats(
+        _In_ swss::Table &statsTable)
+{
     SWSS_LOG_ENTER();
 
-    if (ntf_queue.empty())
+    for (size_t priority = 0; priority < g_notificationPriorities.size(); priority++)
     {
-        return false;
+        const std::string &name = g_notificationPriorities[priority].name;
+
+        statsTable.set(NOTIFICATION_STATS_QUEUE ":" + name, g_notificationQueue->getStats(priority), "");
     }
+}
+
+/**
+ * @brief Logs notifications dropped or put into overflow list since last
+ * check, it's cheap so it's called on each processing loop.
+ */
+void reportNotificationQueueDrops(
+        _Inout_ std::vector<uint64_t> &lastDropped,
+        _Inout_ std::vector<uint64_t> &lastOverflowed)
+{
+    SWSS_LOG_ENTER();
+
+    lastDropped.resize(g_notificationPriorities.size());
+    lastOverflowed.resize(g_notificationPriorities.size());
 
-    item = ntf_queue.front();
+    for (size_t priority = 0; priority < g_notificationPriorities.size(); priority++)
+    {
+        const std::string &name = g_notificationPriorities[priority].name;
 
-    ntf_queue.pop();
+        uint64_t dropped = g_notificationQueue->getDroppedCount(priority);
+
+        if (dropped != lastDropped[priority])
+        {
+            SWSS_LOG_WARN("notification queue %s full, dropped %lu notifications (total %lu)",
+                    name.c_str(),
+                    dropped - lastDropped[priority],
+                    dropped);
 
-    return true;
+            lastDropped[priority] = dropped;
+        }
+
+        uint64_t overflowed = g_notificationQueue->getOverflowCount(priority);
+
+        if (overflowed != lastOverflowed[priority])
+        {
+            SWSS_LOG_NOTICE("notification queue %s full, %lu notifications put into overflow list (total %lu)",
+                    name.c_str(),
+                    overflowed - lastOverflowed[priority],
+                    overflowed);
+
+            lastOverflowed[priority] = overflowed;
+        }
+    }
 }
 
 void ntf_process_function()
 {
     SWSS_LOG_ENTER();
 
+    swss::DBConnector db(COUNTERS_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
+    swss::Table statsTable(&db, NOTIFICATION_STATS_TABLE);
+
+    std::vector<uint64_t> lastDropped;
+    std::vector<uint64_t> lastOverflowed;
+
+    auto lastPublish = std::chrono::steady_clock::now();
+
+    std::vector<swss::KeyOpFieldsValuesTuple> fdbRun;
+
+    auto fdbRunStart = lastPublish;
+
     while (runThread)
     {
-        cv.wait(ulock);
-
         // this is notifications processing thread context, which is different
         // from SAI notifications context, we can safe use g_mutex here,
         // processing each notification is under same mutex as processing main
@@ -422,11 +893,66 @@ void ntf_process_function()
 
         swss::KeyOpFieldsValuesTuple item;
 
-        while (tryDequeue(item))
+        while (g_notificationQueue->tryDequeue(item))
         {
+            if (kfvKey(item) == "fdb_event")
+            {
+                if (fdbRun.empty())
+                {
+                    fdbRunStart = std::chrono::steady_clock::now();
+                }
+
+                fdbRun.push_back(std::move(item));
+
+                if (fdbRun.size() >= FDB_EVENT_COALESCE_MAX_RUN)
+                {
+                    processFdbEventRun(fdbRun);
+                }
+
+                continue;
+            }
+
+            /*
+             * Higher priority notifications are processed right away, even
+             * when fdb events are still waiting to be coalesced.
+             */
+
             processNotification(item);
         }
+
+        auto now = std::chrono::steady_clock::now();
+
+        auto timeout = std::chrono::milliseconds(NOTIFICATION_STATS_PUBLISH_MSECS);
+
+        if (fdbRun.size())
+        {
+            auto window = std::chrono::milliseconds(g_fdbCoalesceWindow);
+
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - fdbRunStart);
+
+            if (elapsed >= window)
+            {
+                processFdbEventRun(fdbRun);
+            }
+            else
+            {
+                timeout = window - elapsed;
+            }
+        }
+
+        reportNotificationQueueDrops(lastDropped, lastOverflowed);
+
+        if (now - lastPublish >= std::chrono::milliseconds(NOTIFICATION_STATS_PUBLISH_MSECS))
+        {
+            publishNotificationQueueStats(statsTable);
+
+            lastPublish = now;
+        }
+
+        g_notificationQueue->wait(timeout);
     }
+
+    processFdbEventRun(fdbRun);
 }
 
 std::shared_ptr<std::thread> ntf_process_thread;
@@ -438,8 +964,6 @@ void startNotificationsProcessingThread()
     runThread = true;
 
     ntf_process_thread = std::make_shared<std::thread>(ntf_process_function);
-
-    ntf_process_thread->detach();
 }
 
 void stopNotificationsProcessingThread()
@@ -448,7 +972,7 @@ void stopNotificationsProcessingThread()
 
     runThread = false;
 
-    cv.notify_all();
+    g_notificationQueue->wakeup();
 
     if (ntf_process_thread != nullptr)
     {
@@ -462,31 +986,11 @@ void on_queue_deadlock(
         _In_ uint32_t count,
         _In_ sai_queue_deadlock_notification_data_t *data)
 {
-    std::lock_guard<std::mutex> lock(g_mutex);
-
     SWSS_LOG_ENTER();
 
-    SWSS_LOG_DEBUG("queue deadlock notification count: %u", count);
-
-    for (uint32_t i = 0; i < count; i++)
-    {
-        sai_queue_deadlock_notification_data_t *deadlock_data = &data[i];
-
-        /*
-         * We are using switch_rid as null, since queue should be already
-         * defined inside local db after creation.
-         *
-         * If this will be faster than return from create queue then we can use
-         * query switch id and extract rid of switch id and then convert it to
-         * switch vid.
-         */
-
-        deadlock_data->queue_id = translate_rid_to_vid(deadlock_data->queue_id, SAI_NULL_OBJECT_ID);
-    }
-
     std::string s = sai_serialize_queue_deadlock_ntf(count, data);
 
-    send_notification("queue_deadlock", s);
+    enqueue_notification("queue_deadlock", s);
 }
 
 sai_switch_state_change_notification_fn     on_switch_state_change_ntf = on_switch_state_change;
@@ -0,0 +1,593 @@
+#include "syncd_sai_profiler.h"
+#include "syncd.h"
+
+#include <chrono>
+
+std::atomic<bool> SaiProfiler::m_installed(false);
+std::mutex SaiProfiler::m_mutex;
+std::map<SaiProfiler::CallKey, SaiProfiler::CallStats> SaiProfiler::m_stats;
+std::string SaiProfiler::m_traceFile;
+std::shared_ptr<ChromeTrace> SaiProfiler::m_trace;
+
+/*
+ * For each api we keep copy of vendor table, which wrappers are calling, and
+ * profiled table which is exposed through sai_metadata_sai_*_api pointer.
+ */
+
+#define PROFILER_API(api)                                                   \
+    static sai_ ## api ## _api_t g_vendor_ ## api ## _api;                  \
+    static sai_ ## api ## _api_t g_profiled_ ## api ## _api;
+
+// object id
+
+#define PROFILER_QUAD(api,OT,ot)                                            \
+    static sai_status_t profiler_create_ ## ot(                             \
+            _Out_ sai_object_id_t *object_id,                               \
+            _In_ sai_object_id_t switch_id,                                 \
+            _In_ uint32_t attr_count,                                       \
+            _In_ const sai_attribute_t *attr_list)                          \
+    {                                                                       \
+        SWSS_LOG_ENTER();                                                   \
+        uint64_t start = SaiProfiler::getTimestamp();                       \
+        sai_status_t status = g_vendor_ ## api ## _api.create_ ## ot(       \
+                object_id, switch_id, attr_count, attr_list);               \
+        SaiProfiler::record(SAI_COMMON_API_CREATE,                          \
+                SAI_OBJECT_TYPE_ ## OT, SAI_PROFILER_NO_ATTR, start, status); \
+        return status;                                                      \
+    }                                                                       \
+    static sai_status_t profiler_remove_ ## ot(                             \
+            _In_ sai_object_id_t object_id)                                 \
+    {                                                                       \
+        SWSS_LOG_ENTER();                                                   \
+        uint64_t start = SaiProfiler::getTimestamp();                       \
+        sai_status_t status = g_vendor_ ## api ## _api.remove_ ## ot(       \
+                object_id);                                                 \
+        SaiProfiler::record(SAI_COMMON_API_REMOVE,                          \
+                SAI_OBJECT_TYPE_ ## OT, SAI_PROFILER_NO_ATTR, start, status); \
+        return status;                                                      \
+    }                                                                       \
+    static sai_status_t profiler_set_ ## ot ## _attribute(                  \
+            _In_ sai_object_id_t object_id,                                 \
+            _In_ const sai_attribute_t *attr)                               \
+    {                                                                       \
+        SWSS_LOG_ENTER();                                                   \
+        uint64_t start = SaiProfiler::getTimestamp();                       \
+        sai_status_t status = g_vendor_ ## api ## _api.set_ ## ot ## _attribute( \
+                object_id, attr);                                           \
+        SaiProfiler::record(SAI_COMMON_API_SET,                             \
+                SAI_OBJECT_TYPE_ ## OT,                                     \
+                attr ? attr->id : SAI_PROFILER_NO_ATTR, start, status);     \
+        return status;                                                      \
+    }                                                                       \
+    static sai_status_t profiler_get_ ## ot ## _attribute(                  \
+            _In_ sai_object_id_t object_id,                                 \
+            _In_ uint32_t attr_count,                                       \
+            _Inout_ sai_attribute_t *attr_list)                             \
+    {                                                                       \
+        SWSS_LOG_ENTER();                                                   \
+        uint64_t start = SaiProfiler::getTimestamp();                       \
+        sai_status_t status = g_vendor_ ## api ## _api.get_ ## ot ## _attribute( \
+                object_id, attr_count, attr_list);                          \
+        SaiProfiler::record(SAI_COMMON_API_GET,                             \
+                SAI_OBJECT_TYPE_ ## OT,                                     \
+                (attr_count == 1 && attr_list) ? attr_list[0].id : SAI_PROFILER_NO_ATTR, \
+                start, status);                                             \
+        return status;                                                      \
+    }
+
+// struct object id
+
+#define PROFILER_QUAD_ENTRY(api,OT,ot)                                      \
+    static sai_status_t profiler_create_ ## ot(                             \
+            _In_ const sai_ ## ot ## _t *ot,                                \
+            _In_ uint32_t attr_count,                                       \
+            _In_ const sai_attribute_t *attr_list)                          \
+    {                                                                       \
+        SWSS_LOG_ENTER();                                                   \
+        uint64_t start = SaiProfiler::getTimestamp();                       \
+        sai_status_t status = g_vendor_ ## api ## _api.create_ ## ot(       \
+                ot, attr_count, attr_list);                                 \
+        SaiProfiler::record(SAI_COMMON_API_CREATE,                          \
+                SAI_OBJECT_TYPE_ ## OT, SAI_PROFILER_NO_ATTR, start, status); \
+        return status;                                                      \
+    }                                                                       \
+    static sai_status_t profiler_remove_ ## ot(                             \
+            _In_ const sai_ ## ot ## _t *ot)                                \
+    {                                                                       \
+        SWSS_LOG_ENTER();                                                   \
+        uint64_t start = SaiProfiler::getTimestamp();                       \
+        sai_status_t status = g_vendor_ ## api ## _api.remove_ ## ot(ot);   \
+        SaiProfiler::record(SAI_COMMON_API_REMOVE,                          \
+                SAI_OBJECT_TYPE_ ## OT, SAI_PROFILER_NO_ATTR, start, status); \
+        return status;                                                      \
+    }                                                                       \
+    static sai_status_t profiler_set_ ## ot ## _attribute(                  \
+            _In_ const sai_ ## ot ## _t *ot,                                \
+            _In_ const sai_attribute_t *attr)                               \
+    {                                                                       \
+        SWSS_LOG_ENTER();                                                   \
+        uint64_t start = SaiProfiler::getTimestamp();                       \
+        sai_status_t status = g_vendor_ ## api ## _api.set_ ## ot ## _attribute( \
+                ot, attr);                                                  \
+        SaiProfiler::record(SAI_COMMON_API_SET,                             \
+                SAI_OBJECT_TYPE_ ## OT,                                     \
+                attr ? attr->id : SAI_PROFILER_NO_ATTR, start, status);     \
+        return status;                                                      \
+    }                                                                       \
+    static sai_status_t profiler_get_ ## ot ## _attribute(                  \
+            _In_ const sai_ ## ot ## _t *ot,                                \
+            _In_ uint32_t attr_count,                                       \
+            _Inout_ sai_attribute_t *attr_list)                             \
+    {                                                                       \
+        SWSS_LOG_ENTER();                                                   \
+        uint64_t start = SaiProfiler::getTimestamp();                       \
+        sai_status_t status = g_vendor_ ## api ## _api.get_ ## ot ## _attribute( \
+                ot, attr_count, attr_list);                                 \
+        SaiProfiler::record(SAI_COMMON_API_GET,                             \
+                SAI_OBJECT_TYPE_ ## OT,                                     \
+                (attr_count == 1 && attr_list) ? attr_list[0].id : SAI_PROFILER_NO_ATTR, \
+                start, status);                                             \
+        return status;                                                      \
+    }
+
+#define PROFILER_INSTALL_BEGIN(api)                                         \
+    if (sai_metadata_sai_ ## api ## _api != NULL)                           \
+    {                                                                       \
+        g_vendor_ ## api ## _api = *sai_metadata_sai_ ## api ## _api;       \
+        g_profiled_ ## api ## _api = g_vendor_ ## api ## _api;
+
+#define PROFILER_INSTALL_QUAD(api,ot)                                       \
+        if (g_vendor_ ## api ## _api.create_ ## ot)                         \
+            g_profiled_ ## api ## _api.create_ ## ot = profiler_create_ ## ot; \
+        if (g_vendor_ ## api ## _api.remove_ ## ot)                         \
+            g_profiled_ ## api ## _api.remove_ ## ot = profiler_remove_ ## ot; \
+        if (g_vendor_ ## api ## _api.set_ ## ot ## _attribute)              \
+            g_profiled_ ## api ## _api.set_ ## ot ## _attribute = profiler_set_ ## ot ## _attribute; \
+        if (g_vendor_ ## api ## _api.get_ ## ot ## _attribute)              \
+            g_profiled_ ## api ## _api.get_ ## ot ## _attribute = profiler_get_ ## ot ## _attribute;
+
+#define PROFILER_INSTALL_END(api)                                           \
+        sai_metadata_sai_ ## api ## _api = &g_profiled_ ## api ## _api;     \
+        SWSS_LOG_NOTICE("profiling vendor %s api", #api);                   \
+    }
+
+PROFILER_API(acl);
+PROFILER_API(bridge);
+PROFILER_API(buffer);
+PROFILER_API(fdb);
+PROFILER_API(hash);
+PROFILER_API(hostif);
+PROFILER_API(lag);
+PROFILER_API(mirror);
+PROFILER_API(neighbor);
+PROFILER_API(next_hop);
+PROFILER_API(next_hop_group);
+PROFILER_API(policer);
+PROFILER_API(port);
+PROFILER_API(qos_map);
+PROFILER_API(queue);
+PROFILER_API(route);
+PROFILER_API(router_interface);
+PROFILER_API(samplepacket);
+PROFILER_API(scheduler);
+PROFILER_API(scheduler_group);
+PROFILER_API(stp);
+PROFILER_API(switch);
+PROFILER_API(tunnel);
+PROFILER_API(udf);
+PROFILER_API(virtual_router);
+PROFILER_API(vlan);
+PROFILER_API(wred);
+
+PROFILER_QUAD(acl,ACL_TABLE,acl_table);
+PROFILER_QUAD(acl,ACL_ENTRY,acl_entry);
+PROFILER_QUAD(acl,ACL_COUNTER,acl_counter);
+PROFILER_QUAD(acl,ACL_RANGE,acl_range);
+PROFILER_QUAD(acl,ACL_TABLE_GROUP,acl_table_group);
+PROFILER_QUAD(acl,ACL_TABLE_GROUP_MEMBER,acl_table_group_member);
+PROFILER_QUAD(bridge,BRIDGE,bridge);
+PROFILER_QUAD(bridge,BRIDGE_PORT,bridge_port);
+PROFILER_QUAD(buffer,BUFFER_POOL,buffer_pool);
+PROFILER_QUAD(buffer,INGRESS_PRIORITY_GROUP,ingress_priority_group);
+PROFILER_QUAD(buffer,BUFFER_PROFILE,buffer_profile);
+PROFILER_QUAD_ENTRY(fdb,FDB_ENTRY,fdb_entry);
+PROFILER_QUAD(hash,HASH,hash);
+PROFILER_QUAD(hostif,HOSTIF,hostif);
+PROFILER_QUAD(hostif,HOSTIF_TABLE_ENTRY,hostif_table_entry);
+PROFILER_QUAD(hostif,HOSTIF_TRAP_GROUP,hostif_trap_group);
+PROFILER_QUAD(hostif,HOSTIF_TRAP,hostif_trap);
+PROFILER_QUAD(lag,LAG,lag);
+PROFILER_QUAD(lag,LAG_MEMBER,lag_member);
+PROFILER_QUAD(mirror,MIRROR_SESSION,mirror_session);
+PROFILER_QUAD_ENTRY(neighbor,NEIGHBOR_ENTRY,neighbor_entry);
+PROFILER_QUAD(next_hop,NEXT_HOP,next_hop);
+PROFILER_QUAD(next_hop_group,NEXT_HOP_GROUP,next_hop_group);
+PROFILER_QUAD(next_hop_group,NEXT_HOP_GROUP_MEMBER,next_hop_group_member);
+PROFILER_QUAD(policer,POLICER,policer);
+PROFILER_QUAD(port,PORT,port);
+PROFILER_QUAD(qos_map,QOS_MAP,qos_map);
+PROFILER_QUAD(queue,QUEUE,queue);
+PROFILER_QUAD_ENTRY(route,ROUTE_ENTRY,route_entry);
+PROFILER_QUAD(router_interface,ROUTER_INTERFACE,router_interface);
+PROFILER_QUAD(samplepacket,SAMPLEPACKET,samplepacket);
+PROFILER_QUAD(scheduler,SCHEDULER,scheduler);
+PROFILER_QUAD(scheduler_group,SCHEDULER_GROUP,scheduler_group);
+PROFILER_QUAD(stp,STP,stp);
+PROFILER_QUAD(stp,STP_PORT,stp_port);
+PROFILER_QUAD(tunnel,TUNNEL_MAP,tunnel_map);
+PROFILER_QUAD(tunnel,TUNNEL,tunnel);
+PROFILER_QUAD(tunnel,TUNNEL_TERM_TABLE_ENTRY,tunnel_term_table_entry);
+PROFILER_QUAD(tunnel,TUNNEL_MAP_ENTRY,tunnel_map_entry);
+PROFILER_QUAD(udf,UDF,udf);
+PROFILER_QUAD(udf,UDF_MATCH,udf_match);
+PROFILER_QUAD(udf,UDF_GROUP,udf_group);
+PROFILER_QUAD(virtual_router,VIRTUAL_ROUTER,virtual_router);
+PROFILER_QUAD(vlan,VLAN,vlan);
+PROFILER_QUAD(vlan,VLAN_MEMBER,vlan_member);
+PROFILER_QUAD(wred,WRED,wred);
+
+/*
+ * Switch create has different signature than other objects.
+ */
+
+static sai_status_t profiler_create_switch(
+        _Out_ sai_object_id_t *switch_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+{
+    SWSS_LOG_ENTER();
+
+    uint64_t start = SaiProfiler::getTimestamp();
+
+    sai_status_t status = g_vendor_switch_api.create_switch(switch_id, attr_count, attr_list);
+
+    SaiProfiler::record(SAI_COMMON_API_CREATE, SAI_OBJECT_TYPE_SWITCH, SAI_PROFILER_NO_ATTR, start, status);
+
+    return status;
+}
+
+static sai_status_t profiler_remove_switch(
+        _In_ sai_object_id_t switch_id)
+{
+    SWSS_LOG_ENTER();
+
+    uint64_t start = SaiProfiler::getTimestamp();
+
+    sai_status_t status = g_vendor_switch_api.remove_switch(switch_id);
+
+    SaiProfiler::record(SAI_COMMON_API_REMOVE, SAI_OBJECT_TYPE_SWITCH, SAI_PROFILER_NO_ATTR, start, status);
+
+    return status;
+}
+
+static sai_status_t profiler_set_switch_attribute(
+        _In_ sai_object_id_t switch_id,
+        _In_ const sai_attribute_t *attr)
+{
+    SWSS_LOG_ENTER();
+
+    uint64_t start = SaiProfiler::getTimestamp();
+
+    sai_status_t status = g_vendor_switch_api.set_switch_attribute(switch_id, attr);
+
+    SaiProfiler::record(SAI_COMMON_API_SET, SAI_OBJECT_TYPE_SWITCH,
+            attr ? attr->id : SAI_PROFILER_NO_ATTR, start, status);
+
+    return status;
+}
+
+static sai_status_t profiler_get_switch_attribute(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _Inout_ sai_attribute_t *attr_list)
+{
+    SWSS_LOG_ENTER();
+
+    uint64_t start = SaiProfiler::getTimestamp();
+
+    sai_status_t status = g_vendor_switch_api.get_switch_attribute(switch_id, attr_count, attr_list);
+
+    SaiProfiler::record(SAI_COMMON_API_GET, SAI_OBJECT_TYPE_SWITCH,
+            (attr_count == 1 && attr_list) ? attr_list[0].id : SAI_PROFILER_NO_ATTR, start, status);
+
+    return status;
+}
+
+void SaiProfiler::install(
+        _In_ const std::string &traceFile)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_installed)
+    {
+        SWSS_LOG_WARN("sai profiler is already installed");
+
+        return;
+    }
+
+    m_traceFile = traceFile;
+
+    if (m_traceFile.size())
+    {
+        m_trace = std::make_shared<ChromeTrace>(SAI_PROFILER_TRACE_MAX_EVENTS);
+    }
+
+    PROFILER_INSTALL_BEGIN(acl)
+    PROFILER_INSTALL_QUAD(acl,acl_table)
+    PROFILER_INSTALL_QUAD(acl,acl_entry)
+    PROFILER_INSTALL_QUAD(acl,acl_counter)
+    PROFILER_INSTALL_QUAD(acl,acl_range)
+    PROFILER_INSTALL_QUAD(acl,acl_table_group)
+    PROFILER_INSTALL_QUAD(acl,acl_table_group_member)
+    PROFILER_INSTALL_END(acl)
+
+    PROFILER_INSTALL_BEGIN(bridge)
+    PROFILER_INSTALL_QUAD(bridge,bridge)
+    PROFILER_INSTALL_QUAD(bridge,bridge_port)
+    PROFILER_INSTALL_END(bridge)
+
+    PROFILER_INSTALL_BEGIN(buffer)
+    PROFILER_INSTALL_QUAD(buffer,buffer_pool)
+    PROFILER_INSTALL_QUAD(buffer,ingress_priority_group)
+    PROFILER_INSTALL_QUAD(buffer,buffer_profile)
+    PROFILER_INSTALL_END(buffer)
+
+    PROFILER_INSTALL_BEGIN(fdb)
+    PROFILER_INSTALL_QUAD(fdb,fdb_entry)
+    PROFILER_INSTALL_END(fdb)
+
+    PROFILER_INSTALL_BEGIN(hash)
+    PROFILER_INSTALL_QUAD(hash,hash)
+    PROFILER_INSTALL_END(hash)
+
+    PROFILER_INSTALL_BEGIN(hostif)
+    PROFILER_INSTALL_QUAD(hostif,hostif)
+    PROFILER_INSTALL_QUAD(hostif,hostif_table_entry)
+    PROFILER_INSTALL_QUAD(hostif,hostif_trap_group)
+    PROFILER_INSTALL_QUAD(hostif,hostif_trap)
+    PROFILER_INSTALL_END(hostif)
+
+    PROFILER_INSTALL_BEGIN(lag)
+    PROFILER_INSTALL_QUAD(lag,lag)
+    PROFILER_INSTALL_QUAD(lag,lag_member)
+    PROFILER_INSTALL_END(lag)
+
+    PROFILER_INSTALL_BEGIN(mirror)
+    PROFILER_INSTALL_QUAD(mirror,mirror_session)
+    PROFILER_INSTALL_END(mirror)
+
+    PROFILER_INSTALL_BEGIN(neighbor)
+    PROFILER_INSTALL_QUAD(neighbor,neighbor_entry)
+    PROFILER_INSTALL_END(neighbor)
+
+    PROFILER_INSTALL_BEGIN(next_hop)
+    PROFILER_INSTALL_QUAD(next_hop,next_hop)
+    PROFILER_INSTALL_END(next_hop)
+
+    PROFILER_INSTALL_BEGIN(next_hop_group)
+    PROFILER_INSTALL_QUAD(next_hop_group,next_hop_group)
+    PROFILER_INSTALL_QUAD(next_hop_group,next_hop_group_member)
+    PROFILER_INSTALL_END(next_hop_group)
+
+    PROFILER_INSTALL_BEGIN(policer)
+    PROFILER_INSTALL_QUAD(policer,policer)
+    PROFILER_INSTALL_END(policer)
+
+    PROFILER_INSTALL_BEGIN(port)
+    PROFILER_INSTALL_QUAD(port,port)
+    PROFILER_INSTALL_END(port)
+
+    PROFILER_INSTALL_BEGIN(qos_map)
+    PROFILER_INSTALL_QUAD(qos_map,qos_map)
+    PROFILER_INSTALL_END(qos_map)
+
+    PROFILER_INSTALL_BEGIN(queue)
+    PROFILER_INSTALL_QUAD(queue,queue)
+    PROFILER_INSTALL_END(queue)
+
+    PROFILER_INSTALL_BEGIN(route)
+    PROFILER_INSTALL_QUAD(route,route_entry)
+    PROFILER_INSTALL_END(route)
+
+    PROFILER_INSTALL_BEGIN(router_interface)
+    PROFILER_INSTALL_QUAD(router_interface,router_interface)
+    PROFILER_INSTALL_END(router_interface)
+
+    PROFILER_INSTALL_BEGIN(samplepacket)
+    PROFILER_INSTALL_QUAD(samplepacket,samplepacket)
+    PROFILER_INSTALL_END(samplepacket)
+
+    PROFILER_INSTALL_BEGIN(scheduler)
+    PROFILER_INSTALL_QUAD(scheduler,scheduler)
+    PROFILER_INSTALL_END(scheduler)
+
+    PROFILER_INSTALL_BEGIN(scheduler_group)
+    PROFILER_INSTALL_QUAD(scheduler_group,scheduler_group)
+    PROFILER_INSTALL_END(scheduler_group)
+
+    PROFILER_INSTALL_BEGIN(stp)
+    PROFILER_INSTALL_QUAD(stp,stp)
+    PROFILER_INSTALL_QUAD(stp,stp_port)
+    PROFILER_INSTALL_END(stp)
+
+    PROFILER_INSTALL_BEGIN(switch)
+    PROFILER_INSTALL_QUAD(switch,switch)
+    PROFILER_INSTALL_END(switch)
+
+    PROFILER_INSTALL_BEGIN(tunnel)
+    PROFILER_INSTALL_QUAD(tunnel,tunnel_map)
+    PROFILER_INSTALL_QUAD(tunnel,tunnel)
+    PROFILER_INSTALL_QUAD(tunnel,tunnel_term_table_entry)
+    PROFILER_INSTALL_QUAD(tunnel,tunnel_map_entry)
+    PROFILER_INSTALL_END(tunnel)
+
+    PROFILER_INSTALL_BEGIN(udf)
+    PROFILER_INSTALL_QUAD(udf,udf)
+    PROFILER_INSTALL_QUAD(udf,udf_match)
+    PROFILER_INSTALL_QUAD(udf,udf_group)
+    PROFILER_INSTALL_END(udf)
+
+    PROFILER_INSTALL_BEGIN(virtual_router)
+    PROFILER_INSTALL_QUAD(virtual_router,virtual_router)
+    PROFILER_INSTALL_END(virtual_router)
+
+    PROFILER_INSTALL_BEGIN(vlan)
+    PROFILER_INSTALL_QUAD(vlan,vlan)
+    PROFILER_INSTALL_QUAD(vlan,vlan_member)
+    PROFILER_INSTALL_END(vlan)
+
+    PROFILER_INSTALL_BEGIN(wred)
+    PROFILER_INSTALL_QUAD(wred,wred)
+    PROFILER_INSTALL_END(wred)
+
+    m_installed = true;
+
+    SWSS_LOG_NOTICE("sai profiler installed, trace file: '%s'", m_traceFile.c_str());
+}
+
+bool SaiProfiler::isInstalled()
+{
+    SWSS_LOG_ENTER();
+
+    return m_installed;
+}
+
+uint64_t SaiProfiler::getTimestamp()
+{
+    SWSS_LOG_ENTER();
+
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+void SaiProfiler::record(
+        _In_ sai_common_api_t api,
+        _In_ sai_object_type_t objectType,
+        _In_ int64_t attrId,
+        _In_ uint64_t start,
+        _In_ sai_status_t status)
+{
+    SWSS_LOG_ENTER();
+
+    uint64_t end = getTimestamp();
+
+    uint64_t duration = end > start ? end - start : 0;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto &stats = m_stats[std::make_tuple(objectType, api, attrId)];
+
+        stats.latency.record(duration / 1000);
+
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            stats.errors[status]++;
+        }
+    }
+
+    if (m_trace == nullptr)
+    {
+        return;
+    }
+
+    ChromeTraceEvent event;
+
+    event.name = sai_serialize_common_api(api) + ":" + sai_serialize_object_type(objectType);
+    event.category = "sai";
+    event.start = start;
+    event.duration = duration;
+    event.tid = ChromeTrace::getThreadId();
+
+    if (attrId != SAI_PROFILER_NO_ATTR)
+    {
+        auto meta = sai_metadata_get_attr_metadata(objectType, (sai_attr_id_t)attrId);
+
+        event.args.emplace_back("attr", meta ? meta->attridname : std::to_string(attrId));
+    }
+
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        event.args.emplace_back("status", sai_serialize_status(status));
+    }
+
+    m_trace->add(std::move(event));
+}
+
+std::string SaiProfiler::serializeKey(
+        _In_ const CallKey &key)
+{
+    SWSS_LOG_ENTER();
+
+    sai_object_type_t objectType = std::get<0>(key);
+
+    int64_t attrId = std::get<2>(key);
+
+    // OBJECT_TYPE:COMMON_API[:ATTR]
+
+    std::string str = sai_serialize_object_type(objectType) + ":" + sai_serialize_common_api(std::get<1>(key));
+
+    if (attrId != SAI_PROFILER_NO_ATTR)
+    {
+        auto meta = sai_metadata_get_attr_metadata(objectType, (sai_attr_id_t)attrId);
+
+        str += ":" + (meta ? std::string(meta->attridname) : std::to_string(attrId));
+    }
+
+    return str;
+}
+
+void SaiProfiler::dump()
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_installed)
+    {
+        SWSS_LOG_WARN("sai profiler is not installed, nothing to dump");
+
+        return;
+    }
+
+    std::map<CallKey, CallStats> stats;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        stats = m_stats;
+    }
+
+    SWSS_LOG_NOTICE("dumping sai profiler, %zu entries", stats.size());
+
+    swss::DBConnector db(COUNTERS_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
+
+    swss::Table table(&db, SAI_PROFILER_STATS_TABLE);
+
+    for (const auto &kvp: stats)
+    {
+        auto values = kvp.second.latency.serialize();
+
+        for (const auto &err: kvp.second.errors)
+        {
+            values.emplace_back(sai_serialize_status(err.first), std::to_string(err.second));
+        }
+
+        table.set(serializeKey(kvp.first), values, "");
+    }
+
+    if (m_trace == nullptr)
+    {
+        return;
+    }
+
+    uint64_t dropped = m_trace->getDropped();
+
+    if (dropped)
+    {
+        SWSS_LOG_WARN("trace window exceeded %d calls, %lu oldest calls were dropped",
+                SAI_PROFILER_TRACE_MAX_EVENTS,
+                dropped);
+    }
+
+    m_trace->write(m_traceFile, true);
+}
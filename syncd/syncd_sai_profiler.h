@@ -0,0 +1,108 @@
+#ifndef __SYNCD_SAI_PROFILER_H__
+#define __SYNCD_SAI_PROFILER_H__
+
+extern "C" {
+#include "sai.h"
+}
+
+#include "syncd_latency_histogram.h"
+#include "syncd_chrome_trace.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+#define SAI_PROFILER_STATS_TABLE        "SAI_PROFILER_STATS"
+
+/**
+ * @def SAI_PROFILER_TRACE_MAX_EVENTS
+ *
+ * Maximum number of vendor calls kept for Chrome trace, when exceeded oldest
+ * calls are dropped.
+ */
+#define SAI_PROFILER_TRACE_MAX_EVENTS   (1 << 18)
+
+/**
+ * @brief Attribute id used for remove and create, and get with more than one
+ * attribute.
+ */
+#define SAI_PROFILER_NO_ATTR            ((int64_t)-1)
+
+/**
+ * @brief Profiler of calls made to vendor SAI.
+ *
+ * When installed, all vendor API tables obtained by sai_metadata_apis_query
+ * are replaced by copies which entries are measuring wrappers of vendor
+ * functions. Since syncd (and metadata generic functions) always call vendor
+ * through those tables, every create/remove/set/get is accounted. When not
+ * installed vendor is called directly, so there is no cost at all.
+ *
+ * Call count, latency histogram in microseconds and returned error codes are
+ * kept per object type, api and attribute id (for set and single attribute
+ * get). Each call is also recorded as Chrome trace event, and trace of calls
+ * since previous dump is written to file on dump.
+ *
+ * This class is thread safe, vendor is called from multiple threads.
+ */
+class SaiProfiler
+{
+    public:
+
+        /**
+         * @brief Wraps vendor API tables.
+         *
+         * Must be called after sai_metadata_apis_query and before any vendor
+         * call.
+         *
+         * @param traceFile Chrome trace output file, if empty trace events
+         * are not recorded.
+         */
+        static void install(
+                _In_ const std::string &traceFile);
+
+        static bool isInstalled();
+
+        static uint64_t getTimestamp();
+
+        static void record(
+                _In_ sai_common_api_t api,
+                _In_ sai_object_type_t objectType,
+                _In_ int64_t attrId,
+                _In_ uint64_t start,
+                _In_ sai_status_t status);
+
+        /**
+         * @brief Publishes statistics to COUNTERS_DB and writes Chrome trace
+         * of calls recorded since previous dump.
+         */
+        static void dump();
+
+    private:
+
+        struct CallStats
+        {
+            LatencyHistogram latency;
+
+            std::map<sai_status_t, uint64_t> errors;
+        };
+
+        typedef std::tuple<sai_object_type_t, sai_common_api_t, int64_t> CallKey;
+
+        static std::string serializeKey(
+                _In_ const CallKey &key);
+
+        static std::atomic<bool> m_installed;
+
+        static std::mutex m_mutex;
+
+        static std::map<CallKey, CallStats> m_stats;
+
+        static std::string m_traceFile;
+
+        static std::shared_ptr<ChromeTrace> m_trace;
+};
+
+#endif // __SYNCD_SAI_PROFILER_H__
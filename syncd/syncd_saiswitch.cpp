@@ -1,11 +1,20 @@
 #include "syncd.h"
 #include "syncd_saiswitch.h"
+#include "syncd_bulk_stats.h"
 #include "sairedis.h"
+#include "syncd_timeline.h"
+#include "meta/saiworkerpool.h"
+#include "syncd_discovery_snapshot.h"
 
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include <set>
+#include <chrono>
+#include <cstdint>
+
+#include <dlfcn.h>
+#include <sys/stat.h>
 
 /*
  * NOTE: all those methods could be implemented inside SaiSwitch class so then
@@ -100,6 +109,83 @@ std::string SaiSwitch::saiGetHardwareInfo() const
     return std::string(info);
 }
 
+std::string SaiSwitch::saiGetFirmwareInfo() const
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Firmware attributes are queried by metadata, since they are not
+     * supported by all SAI versions and vendors.
+     */
+
+    std::string firmware;
+
+    const sai_object_type_info_t *info = sai_metadata_get_object_type_info(SAI_OBJECT_TYPE_SWITCH);
+
+    for (size_t idx = 0; info->attrmetadata[idx] != NULL; ++idx)
+    {
+        const sai_attr_metadata_t *md = info->attrmetadata[idx];
+
+        if (strncmp(md->attridname, "SAI_SWITCH_ATTR_FIRMWARE_", strlen("SAI_SWITCH_ATTR_FIRMWARE_")) != 0)
+        {
+            continue;
+        }
+
+        sai_attribute_t attr;
+
+        char data[MAX_HARDWARE_INFO_LENGTH];
+
+        memset(&attr, 0, sizeof(attr));
+        memset(data, 0, MAX_HARDWARE_INFO_LENGTH);
+
+        attr.id = md->attrid;
+
+        switch (md->attrvaluetype)
+        {
+            case SAI_ATTR_VALUE_TYPE_BOOL:
+            case SAI_ATTR_VALUE_TYPE_UINT8:
+            case SAI_ATTR_VALUE_TYPE_INT8:
+            case SAI_ATTR_VALUE_TYPE_UINT16:
+            case SAI_ATTR_VALUE_TYPE_INT16:
+            case SAI_ATTR_VALUE_TYPE_UINT32:
+            case SAI_ATTR_VALUE_TYPE_INT32:
+            case SAI_ATTR_VALUE_TYPE_UINT64:
+            case SAI_ATTR_VALUE_TYPE_INT64:
+            case SAI_ATTR_VALUE_TYPE_CHARDATA:
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_INT8_LIST:
+                attr.value.s8list.count = MAX_HARDWARE_INFO_LENGTH - 1;
+                attr.value.s8list.list = (int8_t*)data;
+                break;
+
+            default:
+                continue;
+        }
+
+        sai_status_t status = sai_metadata_sai_switch_api->get_switch_attribute(m_switch_rid, 1, &attr);
+
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_INFO("failed to get %s: %s", md->attridname, sai_serialize_status(status).c_str());
+            continue;
+        }
+
+        if (md->attrvaluetype == SAI_ATTR_VALUE_TYPE_INT8_LIST)
+        {
+            firmware += std::string(md->attridname) + "=" + data + ";";
+        }
+        else
+        {
+            firmware += std::string(md->attridname) + "=" + sai_serialize_attr_value(*md, attr, false) + ";";
+        }
+    }
+
+    SWSS_LOG_DEBUG("firmware info: '%s'", firmware.c_str());
+
+    return firmware;
+}
+
 std::vector<sai_object_id_t> SaiSwitch::saiGetPortList() const
 {
     SWSS_LOG_ENTER();
@@ -312,8 +398,15 @@ void SaiSwitch::helperCheckLaneMap()
 
     auto redisLaneMap = redisGetLaneMap();
 
+    /*
+     * Lane map is always queried from hardware, since m_laneMap can be
+     * loaded from discovery snapshot.
+     */
+
     auto laneMap = saiGetHardwareLaneMap();
 
+    m_laneMap = laneMap;
+
     if (redisLaneMap.size() == 0)
     {
         SWSS_LOG_INFO("no lanes defined in redis, seems like it is first syncd start");
@@ -559,21 +652,19 @@ void SaiSwitch::collectCounters(
         return;
     }
 
-    uint32_t countersSize = (uint32_t)m_supported_counters.size();
+    std::vector<int32_t> counterIds(m_supported_counters.begin(), m_supported_counters.end());
 
-    std::vector<uint64_t> counters;
+    auto ports = saiGetPortList();
 
-    counters.resize(countersSize);
+    BulkStatsMatrix matrix;
 
-    auto ports = saiGetPortList();
+    BulkStats::getStats(SAI_OBJECT_TYPE_PORT, ports, counterIds, matrix);
 
-    for (auto &port_rid: ports)
+    for (size_t portIdx = 0; portIdx < ports.size(); portIdx++)
     {
-        sai_status_t status = sai_metadata_sai_port_api->get_port_stats(
-                port_rid,
-                countersSize,
-                m_supported_counters.data(),
-                counters.data());
+        sai_object_id_t port_rid = ports[portIdx];
+
+        sai_status_t status = matrix.statuses[portIdx];
 
         if (status != SAI_STATUS_SUCCESS)
         {
@@ -583,12 +674,14 @@ void SaiSwitch::collectCounters(
             continue;
         }
 
+        const uint64_t *counters = matrix.getRow(portIdx);
+
         sai_object_id_t vid = translate_rid_to_vid(port_rid, m_switch_vid);
 
         std::string strPortId = sai_serialize_object_id(vid);
         std::vector<swss::FieldValueTuple> values;
 
-        for (size_t idx = 0; idx < counters.size(); idx++)
+        for (size_t idx = 0; idx < counterIds.size(); idx++)
         {
             const std::string &field = sai_serialize_port_stat(m_supported_counters[idx]);
             const std::string &value = std::to_string(counters[idx]);
@@ -812,182 +905,197 @@ bool SaiSwitch::isNonRemovableRid(
     return true;
 }
 
-void SaiSwitch::saiDiscover(
-        _In_ sai_object_id_t rid,
-        _Inout_ std::set<sai_object_id_t> &discovered)
+/**
+ * @brief Result of querying all OID attributes of single object during
+ * discovery.
+ */
+typedef struct _DiscoveredObject
 {
-    SWSS_LOG_ENTER();
+    /**
+     * @brief Values of OID attributes, used for default oid map.
+     */
+    std::vector<std::pair<sai_attr_id_t, sai_object_id_t>> oidAttrs;
 
-    /*
-     * NOTE: This method is only good after switch init since we are making
-     * assumptions that tere are no ACL after initialization.
-     *
-     * NOTE: Input set could be a map of sets, this way we will also have
-     * dependency on each oid.
+    /**
+     * @brief Objects referenced by attributes (oid and list) together with
+     * attribute which referenced them.
      */
+    std::vector<std::pair<const sai_attr_metadata_t*, sai_object_id_t>> references;
 
-    if (rid == SAI_NULL_OBJECT_ID)
-    {
-        return;
-    }
+    uint32_t getCalls;
 
-    if (discovered.find(rid) != discovered.end())
-    {
-        return;
-    }
+    uint64_t duration;
 
-    sai_object_type_t ot = sai_object_type_query(rid);
+} DiscoveredObject;
 
-    if (ot == SAI_OBJECT_TYPE_NULL)
+typedef struct _DiscoveryTypeStats
+{
+    uint64_t objects;
+
+    uint64_t getCalls;
+
+    uint64_t duration;
+
+} DiscoveryTypeStats;
+
+size_t SaiSwitch::m_discoveryConcurrency = 1;
+std::shared_ptr<WorkerPool> SaiSwitch::m_workerPool;
+
+void SaiSwitch::setDiscoveryConcurrency(
+        _In_ size_t concurrency)
+{
+    SWSS_LOG_ENTER();
+
+    m_discoveryConcurrency = concurrency ? concurrency : 1;
+
+    SWSS_LOG_NOTICE("discovery concurrency set to %zu", m_discoveryConcurrency);
+
+    m_workerPool = std::make_shared<WorkerPool>(m_discoveryConcurrency);
+}
+
+WorkerPool& SaiSwitch::getWorkerPool()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_workerPool == nullptr)
     {
-        SWSS_LOG_THROW("sai_object_type_query: rid %s returned NULL object type",
-                sai_serialize_object_id(rid).c_str());
+        m_workerPool = std::make_shared<WorkerPool>(m_discoveryConcurrency);
     }
 
-    SWSS_LOG_DEBUG("processing %s: %s",
-            sai_serialize_object_id(rid).c_str(),
-            sai_serialize_object_type(ot).c_str());
+    return *m_workerPool;
+}
+
+static bool skipDiscoveryAttribute(
+        _In_ const sai_attr_metadata_t *md)
+{
+    SWSS_LOG_ENTER();
 
     /*
-     * We will ignore STP ports by now, since when removing bridge port, then
-     * associated stp port is automatically removed, and we don't use STP in
-     * out solution.  This causing inconsestincy with redis ASIC view vs
-     * actual ASIC asic state.
-     *
-     * TODO: This needs to be solved by sending discovered state to sairedis
-     * metadata db for reference count.
-     *
-     * XXX: workaround
+     * Note that we don't care about ACL object id's since we assume that
+     * there are no ACLs on switch after init.
      */
 
-    if (ot != SAI_OBJECT_TYPE_STP_PORT)
+    if (md->objecttype == SAI_OBJECT_TYPE_STP &&
+            md->attrid == SAI_STP_ATTR_BRIDGE_ID)
     {
-        discovered.insert(rid);
+        // XXX workaround (for mlnx)
+        SWSS_LOG_WARN("skipping since it causes crash: %s", md->attridname);
+        return true;
     }
 
-    // TODO later use sai_metadata_get_object_type_info(ot);
-    const sai_object_type_info_t *info =  sai_metadata_get_object_type_info(ot);
+    if (md->objecttype == SAI_OBJECT_TYPE_BRIDGE_PORT)
+    {
+        if (md->attrid == SAI_BRIDGE_PORT_ATTR_TUNNEL_ID ||
+                md->attrid == SAI_BRIDGE_PORT_ATTR_RIF_ID)
+        {
+            /*
+             * We know that bridge port is binded on PORT, no need to query
+             * those attributes.
+             */
 
-    /*
-     * We will query only oid object types
-     * then we don't need meta key, but we need to add to metadata
-     * pointers to only generic functions.
-     */
+            return true;
+        }
+    }
 
-    sai_object_meta_key_t mk = { .objecttype = ot, .objectkey = { .key = { .object_id = rid } } };
+    return false;
+}
 
-    for (int idx = 0; info->attrmetadata[idx] != NULL; ++idx)
-    {
-        const sai_attr_metadata_t *md = info->attrmetadata[idx];
+/**
+ * @brief Queries all OID attributes of single object.
+ *
+ * All attributes are obtained using single GET, when vendor fails it (usually
+ * because one of attributes is not supported) each attribute is queried
+ * separately and failed ones are skipped.
+ *
+ * This function can be called from multiple threads at the same time.
+ */
+static void discoverObject(
+        _In_ sai_object_id_t rid,
+        _In_ sai_object_type_t ot,
+        _Out_ DiscoveredObject &result)
+{
+    SWSS_LOG_ENTER();
 
-        /*
-         * Note that we don't care about ACL object id's since
-         * we assume that there are no ACLs on switch after init.
-         */
+    auto start = std::chrono::steady_clock::now();
 
-        sai_attribute_t attr;
+    result.getCalls = 0;
 
-        attr.id = md->attrid;
+    const sai_object_type_info_t *info = sai_metadata_get_object_type_info(ot);
 
-        if (md->attrvaluetype == SAI_ATTR_VALUE_TYPE_OBJECT_ID)
-        {
-            if (md->defaultvaluetype == SAI_DEFAULT_VALUE_TYPE_CONST)
-            {
-                /*
-                 * This means that default value for this object is
-                 * SAI_NULL_OBJECT_ID, since this is discovery after
-                 * create, we don't need to query this attribute.
-                 */
+    std::vector<const sai_attr_metadata_t*> mds;
 
-                //continue;
-            }
+    for (size_t idx = 0; info->attrmetadata[idx] != NULL; ++idx)
+    {
+        const sai_attr_metadata_t *md = info->attrmetadata[idx];
 
-            if (md->objecttype == SAI_OBJECT_TYPE_STP &&
-                    md->attrid == SAI_STP_ATTR_BRIDGE_ID)
-            {
-                // XXX workaround (for mlnx)
-                SWSS_LOG_WARN("skipping since it causes crash: %s", md->attridname);
-                continue;
-            }
+        if (md->attrvaluetype != SAI_ATTR_VALUE_TYPE_OBJECT_ID &&
+                md->attrvaluetype != SAI_ATTR_VALUE_TYPE_OBJECT_LIST)
+        {
+            continue;
+        }
 
-            if (md->objecttype == SAI_OBJECT_TYPE_BRIDGE_PORT)
-            {
-                if (md->attrid == SAI_BRIDGE_PORT_ATTR_TUNNEL_ID ||
-                        md->attrid == SAI_BRIDGE_PORT_ATTR_RIF_ID)
-                {
-                    /*
-                     * We know that bridge port is binded on PORT, no need
-                     * to query those attributes.
-                     */
+        if (skipDiscoveryAttribute(md))
+        {
+            continue;
+        }
 
-                    continue;
-                }
-            }
+        mds.push_back(md);
+    }
 
-            SWSS_LOG_DEBUG("getting %s for %s", md->attridname,
-                    sai_serialize_object_id(rid).c_str());
+    std::vector<sai_attribute_t> attrs(mds.size());
 
-            sai_status_t status = info->get(&mk, 1, &attr);
+    std::vector<std::vector<sai_object_id_t>> lists(mds.size());
 
-            if (status != SAI_STATUS_SUCCESS)
-            {
-                /*
-                 * We failed to get value, maybe it's not supported ?
-                 */
+    std::vector<bool> valid(mds.size(), true);
 
-                SWSS_LOG_INFO("%s: %s on %s",
-                        md->attridname,
-                        sai_serialize_status(status).c_str(),
-                        sai_serialize_object_id(rid).c_str());
+    auto prepare = [&](size_t idx)
+    {
+        attrs[idx].id = mds[idx]->attrid;
 
-                continue;
-            }
+        if (mds[idx]->attrvaluetype == SAI_ATTR_VALUE_TYPE_OBJECT_LIST)
+        {
+            lists[idx].resize(SAI_DISCOVERY_LIST_MAX_ELEMENTS);
 
-            m_defaultOidMap[rid][attr.id] = attr.value.oid;
+            attrs[idx].value.objlist.count = SAI_DISCOVERY_LIST_MAX_ELEMENTS;
+            attrs[idx].value.objlist.list = lists[idx].data();
+        }
+    };
 
-            if (!md->allownullobjectid && attr.value.oid == SAI_NULL_OBJECT_ID)
-            {
-                // SWSS_LOG_WARN("got null on %s, but not allowed", md->attridname);
-            }
+    for (size_t idx = 0; idx < mds.size(); idx++)
+    {
+        prepare(idx);
+    }
 
-            if (attr.value.oid != SAI_NULL_OBJECT_ID)
-            {
-                ot = sai_object_type_query(attr.value.oid);
+    sai_object_meta_key_t mk = { .objecttype = ot, .objectkey = { .key = { .object_id = rid } } };
 
-                if (ot == SAI_OBJECT_TYPE_NULL)
-                {
-                    SWSS_LOG_THROW("when query %s (on %s RID %s) got value %s sai_object_type_query returned NULL object type",
-                            md->attridname,
-                            sai_serialize_object_type(md->objecttype).c_str(),
-                            sai_serialize_object_id(rid).c_str(),
-                            sai_serialize_object_id(attr.value.oid).c_str());
-                }
-            }
+    sai_status_t status = SAI_STATUS_SUCCESS;
 
-            saiDiscover(attr.value.oid, discovered); // recursion
-        }
-        else if (md->attrvaluetype == SAI_ATTR_VALUE_TYPE_OBJECT_LIST)
-        {
-            if (md->defaultvaluetype == SAI_DEFAULT_VALUE_TYPE_EMPTY_LIST)
-            {
-                /*
-                 * This means that default value for this object is
-                 * empty list, since this is discovery after
-                 * create, we don't need to query this attribute.
-                 */
+    if (mds.size())
+    {
+        result.getCalls++;
 
-                //continue;
-            }
+        status = info->get(&mk, (uint32_t)attrs.size(), attrs.data());
+    }
 
-            SWSS_LOG_DEBUG("getting %s for %s", md->attridname,
-                    sai_serialize_object_id(rid).c_str());
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_INFO("get of %zu attributes on %s failed: %s, querying one by one",
+                attrs.size(),
+                sai_serialize_object_id(rid).c_str(),
+                sai_serialize_status(status).c_str());
+
+        for (size_t idx = 0; idx < mds.size(); idx++)
+        {
+            /*
+             * Failed get could modify list count, so attribute needs to be
+             * prepared again.
+             */
 
-            sai_object_id_t local[SAI_DISCOVERY_LIST_MAX_ELEMENTS];
+            prepare(idx);
 
-            attr.value.objlist.count = SAI_DISCOVERY_LIST_MAX_ELEMENTS;
-            attr.value.objlist.list = local;
+            result.getCalls++;
 
-            sai_status_t status = info->get(&mk, 1, &attr);
+            status = info->get(&mk, 1, &attrs[idx]);
 
             if (status != SAI_STATUS_SUCCESS)
             {
@@ -996,88 +1104,430 @@ void SaiSwitch::saiDiscover(
                  */
 
                 SWSS_LOG_INFO("%s: %s on %s",
-                        md->attridname,
+                        mds[idx]->attridname,
                         sai_serialize_status(status).c_str(),
                         sai_serialize_object_id(rid).c_str());
 
-                continue;
+                valid[idx] = false;
             }
+        }
+    }
+
+    for (size_t idx = 0; idx < mds.size(); idx++)
+    {
+        if (!valid[idx])
+        {
+            continue;
+        }
+
+        const sai_attr_metadata_t *md = mds[idx];
+
+        const sai_attribute_t &attr = attrs[idx];
 
-            SWSS_LOG_DEBUG("list count %s %u", md->attridname, attr.value.objlist.count);
+        if (md->attrvaluetype == SAI_ATTR_VALUE_TYPE_OBJECT_ID)
+        {
+            result.oidAttrs.emplace_back(attr.id, attr.value.oid);
 
-            for (uint32_t i = 0; i < attr.value.objlist.count; ++i)
+            if (attr.value.oid != SAI_NULL_OBJECT_ID)
             {
-                sai_object_id_t oid = attr.value.objlist.list[i];
+                result.references.emplace_back(md, attr.value.oid);
+            }
 
-                ot = sai_object_type_query(oid);
+            continue;
+        }
 
-                if (ot == SAI_OBJECT_TYPE_NULL)
-                {
-                    SWSS_LOG_THROW("when query %s (on %s RID %s) got value %s sai_object_type_query returned NULL object type",
-                            md->attridname,
-                            sai_serialize_object_type(md->objecttype).c_str(),
-                            sai_serialize_object_id(rid).c_str(),
-                            sai_serialize_object_id(oid).c_str());
-                }
+        SWSS_LOG_DEBUG("list count %s %u", md->attridname, attr.value.objlist.count);
 
-                saiDiscover(oid, discovered); // recursion
-            }
+        for (uint32_t i = 0; i < attr.value.objlist.count; ++i)
+        {
+            result.references.emplace_back(md, attr.value.objlist.list[i]);
         }
     }
+
+    auto duration = std::chrono::steady_clock::now() - start;
+
+    result.duration = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
 }
 
-void SaiSwitch::helperDiscover()
+void SaiSwitch::saiDiscover(
+        _In_ sai_object_id_t rid,
+        _Inout_ std::set<sai_object_id_t> &discovered)
 {
     SWSS_LOG_ENTER();
 
     /*
-     * Preform discovery on the switch to obtain ASIC view of
-     * objects that are created internally.
+     * NOTE: This method is only good after switch init since we are making
+     * assumptions that tere are no ACL after initialization.
+     *
+     * NOTE: Input set could be a map of sets, this way we will also have
+     * dependency on each oid.
      */
 
-    m_discovered_rids.clear();
-
+    if (rid == SAI_NULL_OBJECT_ID)
     {
-        SWSS_LOG_TIMER("discover");
-
-        saiDiscover(m_switch_rid, m_discovered_rids);
+        return;
     }
 
-    SWSS_LOG_NOTICE("discovered objects count: %zu", m_discovered_rids.size());
-
-    std::map<sai_object_type_t,int> map;
-
-    for (sai_object_id_t rid: m_discovered_rids)
+    if (discovered.find(rid) != discovered.end())
     {
-        /*
-         * We don't need to check for null since saiDiscovery already checked
-         * that.
-         */
-
-        map[sai_object_type_query(rid)]++;
+        return;
     }
 
-    for (const auto &p: map)
+    if (sai_object_type_query(rid) == SAI_OBJECT_TYPE_NULL)
     {
-        SWSS_LOG_NOTICE("%s: %d", sai_serialize_object_type(p.first).c_str(), p.second);
+        SWSS_LOG_THROW("sai_object_type_query: rid %s returned NULL object type",
+                sai_serialize_object_id(rid).c_str());
     }
+
+    saiDiscoverLevels(getWorkerPool(), { rid }, discovered, SIZE_MAX);
 }
 
-void SaiSwitch::helperPutDiscoveredRidsToRedis()
+std::vector<sai_object_id_t> SaiSwitch::saiDiscoverLevels(
+        _In_ WorkerPool &pool,
+        _In_ std::vector<sai_object_id_t> level,
+        _Inout_ std::set<sai_object_id_t> &discovered,
+        _In_ size_t maxLevels)
 {
     SWSS_LOG_ENTER();
 
-    SWSS_LOG_TIMER("put discovered objects to redis");
-
     /*
-     * There is a problem:
-     *
-     * After switch creation, on the switch objects are created internally like
-     * VLAN members, queys, SGs etc.  Some of those obejct's are removable.
-     * User can decide that he don't want VLAN members and he will remove them.
-     * Those obejcts will be removed from ASIC view in redis as well.
-     *
-     * Now after hard reinit, syncd will picku up what is in the db and it will
+     * Discovery is done in breadth first order. All objects on the same level
+     * are independent, so they can be queried in parallel, and results are
+     * merged serially before next level.
+     */
+
+    std::set<sai_object_id_t> visited(level.begin(), level.end());
+
+    std::map<sai_object_type_t, DiscoveryTypeStats> stats;
+
+    for (size_t depth = 0; depth < maxLevels && level.size(); depth++)
+    {
+        std::vector<DiscoveredObject> results(level.size());
+
+        pool.run(level.size(), [&](size_t idx)
+        {
+            discoverObject(level[idx], sai_object_type_query(level[idx]), results[idx]);
+        });
+
+        std::vector<sai_object_id_t> next;
+
+        for (size_t idx = 0; idx < level.size(); idx++)
+        {
+            sai_object_id_t obj = level[idx];
+
+            sai_object_type_t ot = sai_object_type_query(obj);
+
+            SWSS_LOG_DEBUG("processed %s: %s",
+                    sai_serialize_object_id(obj).c_str(),
+                    sai_serialize_object_type(ot).c_str());
+
+            /*
+             * We will ignore STP ports by now, since when removing bridge
+             * port, then associated stp port is automatically removed, and we
+             * don't use STP in out solution.  This causing inconsestincy with
+             * redis ASIC view vs actual ASIC asic state.
+             *
+             * TODO: This needs to be solved by sending discovered state to
+             * sairedis metadata db for reference count.
+             *
+             * XXX: workaround
+             */
+
+            if (ot != SAI_OBJECT_TYPE_STP_PORT)
+            {
+                discovered.insert(obj);
+            }
+
+            const DiscoveredObject &result = results[idx];
+
+            for (const auto &a: result.oidAttrs)
+            {
+                m_defaultOidMap[obj][a.first] = a.second;
+            }
+
+            auto &st = stats[ot];
+
+            st.objects++;
+            st.getCalls += result.getCalls;
+            st.duration += result.duration;
+
+            for (const auto &ref: result.references)
+            {
+                if (sai_object_type_query(ref.second) == SAI_OBJECT_TYPE_NULL)
+                {
+                    SWSS_LOG_THROW("when query %s (on %s RID %s) got value %s sai_object_type_query returned NULL object type",
+                            ref.first->attridname,
+                            sai_serialize_object_type(ref.first->objecttype).c_str(),
+                            sai_serialize_object_id(obj).c_str(),
+                            sai_serialize_object_id(ref.second).c_str());
+                }
+
+                if (discovered.find(ref.second) != discovered.end())
+                {
+                    continue;
+                }
+
+                if (visited.insert(ref.second).second)
+                {
+                    next.push_back(ref.second);
+                }
+            }
+        }
+
+        level.swap(next);
+    }
+
+    for (const auto &p: stats)
+    {
+        SWSS_LOG_NOTICE("discovered %s: %lu objects, %lu get calls, %lu us",
+                sai_serialize_object_type(p.first).c_str(),
+                p.second.objects,
+                p.second.getCalls,
+                p.second.duration);
+    }
+
+    return level;
+}
+
+void SaiSwitch::helperDiscover()
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Preform discovery on the switch to obtain ASIC view of
+     * objects that are created internally.
+     */
+
+    m_discovered_rids.clear();
+
+    {
+        SWSS_LOG_TIMER("discover");
+
+        Timeline::Span span("helperDiscover");
+
+        saiDiscover(m_switch_rid, m_discovered_rids);
+
+        span.addArg("objects", m_discovered_rids.size());
+    }
+
+    SWSS_LOG_NOTICE("discovered objects count: %zu", m_discovered_rids.size());
+
+    std::map<sai_object_type_t,int> map;
+
+    for (sai_object_id_t rid: m_discovered_rids)
+    {
+        /*
+         * We don't need to check for null since saiDiscovery already checked
+         * that.
+         */
+
+        map[sai_object_type_query(rid)]++;
+    }
+
+    for (const auto &p: map)
+    {
+        SWSS_LOG_NOTICE("%s: %d", sai_serialize_object_type(p.first).c_str(), p.second);
+    }
+}
+
+bool SaiSwitch::m_lazyDiscovery = false;
+
+void SaiSwitch::setLazyDiscovery(
+        _In_ bool lazy)
+{
+    SWSS_LOG_ENTER();
+
+    m_lazyDiscovery = lazy;
+
+    SWSS_LOG_NOTICE("lazy discovery: %s", m_lazyDiscovery ? "true" : "false");
+}
+
+void SaiSwitch::helperLazyDiscover()
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Only switch object is queried, objects referenced by switch attributes
+     * (ports, cpu port, default virtual router, default vlan, etc.) are
+     * considered discovered, but their attributes will be queried when they
+     * are spotted or when lazy discovery is completed.
+     */
+
+    m_discovered_rids.clear();
+    m_lazyPendingRids.clear();
+    m_lazySpottedRids.clear();
+
+    {
+        SWSS_LOG_TIMER("lazy discover");
+
+        Timeline::Span span("helperLazyDiscover");
+
+        saiLazyDiscover({ m_switch_rid });
+
+        span.addArg("objects", m_discovered_rids.size());
+    }
+
+    SWSS_LOG_NOTICE("lazy discovered objects count: %zu, pending: %zu",
+            m_discovered_rids.size(),
+            m_lazyPendingRids.size());
+}
+
+void SaiSwitch::saiLazyDiscover(
+        _In_ const std::vector<sai_object_id_t> &rids)
+{
+    SWSS_LOG_ENTER();
+
+    auto pending = saiDiscoverLevels(getWorkerPool(), rids, m_discovered_rids, 1);
+
+    for (sai_object_id_t obj: pending)
+    {
+        if (sai_object_type_query(obj) != SAI_OBJECT_TYPE_STP_PORT)
+        {
+            m_discovered_rids.insert(obj);
+        }
+
+        m_lazyPendingRids.insert(obj);
+    }
+}
+
+void SaiSwitch::onRidSpotted(
+        _In_ sai_object_id_t rid)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_lazyDiscovery || rid == m_switch_rid)
+    {
+        return;
+    }
+
+    if (m_lazyPendingRids.find(rid) == m_lazyPendingRids.end() &&
+            m_discovered_rids.find(rid) != m_discovered_rids.end())
+    {
+        /*
+         * Object was already discovered and queried.
+         */
+
+        return;
+    }
+
+    /*
+     * RID which don't have VID assigned yet can only be object created
+     * internally by switch, since objects created by user get VID on create.
+     *
+     * Object is only queued here, since we are in the middle of translating
+     * GET response or notification.
+     */
+
+    SWSS_LOG_INFO("spotted %s", sai_serialize_object_id(rid).c_str());
+
+    m_lazySpottedRids.insert(rid);
+}
+
+void SaiSwitch::processSpottedRids(
+        _In_ size_t maxCount)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_lazySpottedRids.empty())
+    {
+        return;
+    }
+
+    std::vector<sai_object_id_t> spotted;
+
+    for (auto it = m_lazySpottedRids.begin(); it != m_lazySpottedRids.end() && spotted.size() < maxCount; )
+    {
+        spotted.push_back(*it);
+
+        m_lazyPendingRids.erase(*it);
+
+        it = m_lazySpottedRids.erase(it);
+    }
+
+    SWSS_LOG_INFO("lazy discovering %zu spotted objects", spotted.size());
+
+    saiLazyDiscover(spotted);
+
+    /*
+     * Put objects to current view, so apply view will see them same way as
+     * objects discovered when switch was created.
+     */
+
+    for (sai_object_id_t rid: spotted)
+    {
+        if (m_discovered_rids.find(rid) != m_discovered_rids.end())
+        {
+            redisSetDummyAsicStateForRealObjectId(rid);
+        }
+    }
+}
+
+void SaiSwitch::completeLazyDiscovery(
+        _In_ bool putToRedis)
+{
+    SWSS_LOG_ENTER();
+
+    processSpottedRids(SIZE_MAX);
+
+    if (m_lazyPendingRids.empty())
+    {
+        return;
+    }
+
+    SWSS_LOG_TIMER("complete lazy discovery");
+
+    Timeline::Span span("completeLazyDiscovery");
+
+    span.addArg("pending", m_lazyPendingRids.size());
+
+    std::vector<sai_object_id_t> level(m_lazyPendingRids.begin(), m_lazyPendingRids.end());
+
+    m_lazyPendingRids.clear();
+
+    saiDiscoverLevels(getWorkerPool(), level, m_discovered_rids, SIZE_MAX);
+
+    SWSS_LOG_NOTICE("discovered objects count after completing lazy discovery: %zu",
+            m_discovered_rids.size());
+
+    span.addArg("objects", m_discovered_rids.size());
+
+    if (!putToRedis)
+    {
+        return;
+    }
+
+    auto ridToVid = redisGetRidToVidMap();
+
+    size_t count = 0;
+
+    for (sai_object_id_t rid: m_discovered_rids)
+    {
+        if (ridToVid.find(rid) == ridToVid.end())
+        {
+            redisSetDummyAsicStateForRealObjectId(rid);
+
+            count++;
+        }
+    }
+
+    SWSS_LOG_NOTICE("put %zu lazy discovered objects to redis", count);
+}
+
+void SaiSwitch::helperPutDiscoveredRidsToRedis()
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_TIMER("put discovered objects to redis");
+
+    /*
+     * There is a problem:
+     *
+     * After switch creation, on the switch objects are created internally like
+     * VLAN members, queys, SGs etc.  Some of those obejct's are removable.
+     * User can decide that he don't want VLAN members and he will remove them.
+     * Those obejcts will be removed from ASIC view in redis as well.
+     *
+     * Now after hard reinit, syncd will picku up what is in the db and it will
      * try to recreate ASIC state.  First it will create switch, and this
      * switch will create those VLAN members again inside ASIC and it will try
      * to put them back to the DB, since we need to keep track of all default
@@ -1185,6 +1635,267 @@ sai_object_id_t SaiSwitch::getDefaultValueForOidAttr(
     return ita->second;
 }
 
+std::string SaiSwitch::m_discoverySnapshotFile;
+std::string SaiSwitch::m_discoverySnapshotConfigKey;
+
+void SaiSwitch::setDiscoverySnapshot(
+        _In_ const std::string &snapshotFile,
+        _In_ const std::string &configKey)
+{
+    SWSS_LOG_ENTER();
+
+    m_discoverySnapshotFile = snapshotFile;
+    m_discoverySnapshotConfigKey = configKey;
+
+    SWSS_LOG_NOTICE("discovery snapshot file: %s", m_discoverySnapshotFile.c_str());
+}
+
+std::string SaiSwitch::getDiscoverySnapshotKey() const
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * SAI version can't be queried from SAI, so we identify vendor library by
+     * its path, size and modification time.
+     */
+
+    std::string library = "unknown";
+
+    Dl_info info;
+
+    if (dladdr((void*)&sai_api_query, &info) && info.dli_fname)
+    {
+        struct stat st;
+
+        if (stat(info.dli_fname, &st) == 0)
+        {
+            library = std::string(info.dli_fname) + ":" +
+                std::to_string(st.st_size) + ":" +
+                std::to_string(st.st_mtime);
+        }
+    }
+
+    return "hw=" + m_hardware_info +
+        "|sai=" + library +
+        "|firmware=" + saiGetFirmwareInfo() +
+        "|config=" + m_discoverySnapshotConfigKey;
+}
+
+bool SaiSwitch::helperLoadDiscoverySnapshot()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_discoverySnapshotFile.empty())
+    {
+        return false;
+    }
+
+    Timeline::Span span("loadDiscoverySnapshot");
+
+    DiscoverySnapshot snapshot;
+
+    if (!snapshot.load(m_discoverySnapshotFile, getDiscoverySnapshotKey()))
+    {
+        return false;
+    }
+
+    if (snapshot.discoveredRids.find(m_switch_rid) == snapshot.discoveredRids.end())
+    {
+        SWSS_LOG_WARN("switch RID %s not present in discovery snapshot, snapshot is stale",
+                sai_serialize_object_id(m_switch_rid).c_str());
+
+        return false;
+    }
+
+    /*
+     * Spot check sample of objects, switch is always checked since it refers
+     * to ports and other top level objects.
+     */
+
+    std::vector<sai_object_id_t> sample = { m_switch_rid };
+
+    size_t stride = std::max((size_t)1, snapshot.discoveredRids.size() / SYNCD_DISCOVERY_SNAPSHOT_SAMPLE);
+
+    size_t index = 0;
+
+    for (sai_object_id_t rid: snapshot.discoveredRids)
+    {
+        if (index++ % stride == 0 && rid != m_switch_rid)
+        {
+            sample.push_back(rid);
+        }
+    }
+
+    for (sai_object_id_t rid: sample)
+    {
+        sai_object_type_t ot = sai_object_type_query(rid);
+
+        if (ot == SAI_OBJECT_TYPE_NULL)
+        {
+            SWSS_LOG_WARN("snapshot RID %s is not valid object, snapshot is stale",
+                    sai_serialize_object_id(rid).c_str());
+
+            return false;
+        }
+
+        DiscoveredObject result;
+
+        discoverObject(rid, ot, result);
+
+        auto it = snapshot.defaultOidMap.find(rid);
+
+        for (const auto &a: result.oidAttrs)
+        {
+            if (it == snapshot.defaultOidMap.end() ||
+                    it->second.find(a.first) == it->second.end() ||
+                    it->second.at(a.first) != a.second)
+            {
+                SWSS_LOG_WARN("snapshot RID %s attribute %u value differs, snapshot is stale",
+                        sai_serialize_object_id(rid).c_str(),
+                        a.first);
+
+                return false;
+            }
+        }
+
+        for (const auto &ref: result.references)
+        {
+            if (snapshot.discoveredRids.find(ref.second) == snapshot.discoveredRids.end() &&
+                    sai_object_type_query(ref.second) != SAI_OBJECT_TYPE_STP_PORT)
+            {
+                SWSS_LOG_WARN("object %s referenced by %s on RID %s not present in snapshot, snapshot is stale",
+                        sai_serialize_object_id(ref.second).c_str(),
+                        ref.first->attridname,
+                        sai_serialize_object_id(rid).c_str());
+
+                return false;
+            }
+        }
+    }
+
+    m_discovered_rids = snapshot.discoveredRids;
+    m_defaultOidMap = snapshot.defaultOidMap;
+    m_laneMap = snapshot.laneMap;
+
+    span.addArg("objects", m_discovered_rids.size());
+    span.addArg("checked", sample.size());
+
+    SWSS_LOG_NOTICE("using discovery snapshot, %zu objects, %zu spot checked",
+            m_discovered_rids.size(),
+            sample.size());
+
+    return true;
+}
+
+void SaiSwitch::helperSaveDiscoverySnapshot() const
+{
+    SWSS_LOG_ENTER();
+
+    if (m_discoverySnapshotFile.empty())
+    {
+        return;
+    }
+
+    DiscoverySnapshot snapshot;
+
+    snapshot.key = getDiscoverySnapshotKey();
+    snapshot.discoveredRids = m_discovered_rids;
+    snapshot.defaultOidMap = m_defaultOidMap;
+    snapshot.laneMap = m_laneMap;
+
+    snapshot.save(m_discoverySnapshotFile);
+}
+
+std::string SaiSwitch::m_warmBootReadFile;
+
+void SaiSwitch::setWarmBoot(
+        _In_ const std::string &readFile)
+{
+    SWSS_LOG_ENTER();
+
+    m_warmBootReadFile = readFile;
+}
+
+std::string SaiSwitch::getWarmBootStateFile(
+        _In_ const std::string &warmBootFile) const
+{
+    SWSS_LOG_ENTER();
+
+    return warmBootFile + ".syncd." + sai_serialize_object_id(m_switch_vid);
+}
+
+std::string SaiSwitch::getWarmBootStateKey() const
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Unlike discovery snapshot, SAI library can change between warm
+     * restarts, since warm restart is also used for upgrade.
+     */
+
+    return "hw=" + m_hardware_info + "|rid=" + sai_serialize_object_id(m_switch_rid);
+}
+
+void SaiSwitch::saveWarmBootState(
+        _In_ const std::string &writeFile) const
+{
+    SWSS_LOG_ENTER();
+
+    DiscoverySnapshot state;
+
+    state.key = getWarmBootStateKey();
+    state.discoveredRids = m_discovered_rids;
+    state.defaultOidMap = m_defaultOidMap;
+    state.laneMap = m_laneMap;
+
+    memcpy(state.defaultMacAddress, m_default_mac_address, sizeof(sai_mac_t));
+
+    if (!state.save(getWarmBootStateFile(writeFile)))
+    {
+        SWSS_LOG_ERROR("failed to save warm boot state of switch %s",
+                sai_serialize_object_id(m_switch_vid).c_str());
+    }
+}
+
+void SaiSwitch::helperLoadWarmBootState()
+{
+    SWSS_LOG_ENTER();
+
+    Timeline::Span span("loadWarmBootState");
+
+    std::string path = getWarmBootStateFile(m_warmBootReadFile);
+
+    DiscoverySnapshot state;
+
+    if (!state.load(path, getWarmBootStateKey()))
+    {
+        SWSS_LOG_THROW("failed to load warm boot state %s of switch %s",
+                path.c_str(),
+                sai_serialize_object_id(m_switch_vid).c_str());
+    }
+
+    m_discovered_rids = state.discoveredRids;
+    m_defaultOidMap = state.defaultOidMap;
+
+    memcpy(m_default_mac_address, state.defaultMacAddress, sizeof(sai_mac_t));
+
+    /*
+     * Lane map is obtained from switch, and compared with redis lane map when
+     * checking lane map, this will make sure that ports didn't change.
+     */
+
+    m_laneMap = saiGetHardwareLaneMap();
+
+    if (m_laneMap != state.laneMap)
+    {
+        SWSS_LOG_THROW("lane map differs from lane map saved on warm shutdown");
+    }
+
+    span.addArg("objects", m_discovered_rids.size());
+
+    SWSS_LOG_NOTICE("loaded warm boot state, %zu existing objects", m_discovered_rids.size());
+}
+
 /*
  * NOTE: If real ID will change during hard restarts, then we need to remap all
  * VID/RID, but we can only do that if we will save entire tree with all
@@ -1214,7 +1925,22 @@ SaiSwitch::SaiSwitch(
      * be populated, and all references could be increased.
      */
 
-    helperDiscover();
+    if (m_warmBootReadFile.size())
+    {
+        helperLoadWarmBootState();
+    }
+    else if (m_lazyDiscovery)
+    {
+        helperLazyDiscover();
+    }
+    else if (!helperLoadDiscoverySnapshot())
+    {
+        helperDiscover();
+
+        m_laneMap = saiGetHardwareLaneMap();
+
+        helperSaveDiscoverySnapshot();
+    }
 
     helperPutDiscoveredRidsToRedis();
 
@@ -1224,5 +1950,8 @@ SaiSwitch::SaiSwitch(
 
     m_supported_counters = saiGetSupportedCounters();
 
-    saiGetMacAddress(m_default_mac_address);
+    if (m_warmBootReadFile.empty())
+    {
+        saiGetMacAddress(m_default_mac_address);
+    }
 }
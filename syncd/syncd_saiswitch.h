@@ -17,6 +17,24 @@ extern "C" {
  */
 #define SAI_DISCOVERY_LIST_MAX_ELEMENTS 1024
 
+/**
+ * @def SAI_DISCOVERY_SPOTTED_BATCH
+ *
+ * Maximum number of spotted objects queried in lazy discovery mode after
+ * single processed event.
+ */
+#define SAI_DISCOVERY_SPOTTED_BATCH 64
+
+class WorkerPool;
+
+/**
+ * @def SYNCD_DISCOVERY_SNAPSHOT_SAMPLE
+ *
+ * Number of objects from discovery snapshot which are queried on switch to
+ * confirm that snapshot is still valid.
+ */
+#define SYNCD_DISCOVERY_SNAPSHOT_SAMPLE 64
+
 class SaiSwitch
 {
     public:
@@ -157,6 +175,102 @@ class SaiSwitch
                 _In_ sai_object_id_t rid,
                 _In_ sai_attr_id_t attr_id);
 
+        /**
+         * @brief Sets number of threads used to query objects during
+         * discovery.
+         *
+         * Worker pool of given concurrency is created once and shared by
+         * discovery of all switches. Values bigger than 1 should be used only
+         * when vendor SAI is thread safe. Default is 1.
+         */
+        static void setDiscoveryConcurrency(
+                _In_ size_t concurrency);
+
+        /**
+         * @brief Gets worker pool shared by discovery of all switches.
+         *
+         * Pool must be used only under g_mutex.
+         */
+        static WorkerPool& getWorkerPool();
+
+        /**
+         * @brief Sets file where discovery result is persisted.
+         *
+         * When snapshot is present and was created on the same hardware, SAI
+         * library and configuration, discovery is skipped and only sample of
+         * objects is checked on the switch.
+         *
+         * @param snapshotFile Snapshot file, empty disables snapshot.
+         * @param configKey Configuration which affects discovered objects,
+         * like profile and port map.
+         */
+        static void setDiscoverySnapshot(
+                _In_ const std::string &snapshotFile,
+                _In_ const std::string &configKey);
+
+        /**
+         * @brief Enables lazy discovery.
+         *
+         * When enabled, only switch and objects directly referenced by switch
+         * attributes are discovered when switch is created. Other switch
+         * internal objects are discovered when they are returned to user
+         * for the first time, and rest of them before hard reinit or apply
+         * view, which need full view of existing objects.
+         */
+        static void setLazyDiscovery(
+                _In_ bool lazy);
+
+        /**
+         * @brief Sets warm boot read file.
+         *
+         * When set, switches are constructed from state saved by
+         * saveWarmBootState on warm shutdown, instead of discovery.
+         *
+         * @param readFile SAI warm boot read file, empty for cold start.
+         */
+        static void setWarmBoot(
+                _In_ const std::string &readFile);
+
+        /**
+         * @brief Saves existing objects of switch on warm shutdown.
+         *
+         * State is saved next to SAI warm boot file, since it's valid only
+         * together with it.
+         *
+         * @param writeFile SAI warm boot write file.
+         */
+        void saveWarmBootState(
+                _In_ const std::string &writeFile) const;
+
+        /**
+         * @brief Notifies switch that RID got VID assigned for the first time.
+         *
+         * This happens only for switch internal objects, for example when
+         * they are returned by GET. In lazy discovery mode object is queued,
+         * and it's queried later by processSpottedRids.
+         */
+        void onRidSpotted(
+                _In_ sai_object_id_t rid);
+
+        /**
+         * @brief Queries objects queued by onRidSpotted and puts them to
+         * current view.
+         *
+         * @param maxCount Maximum number of objects processed in this call.
+         */
+        void processSpottedRids(
+                _In_ size_t maxCount);
+
+        /**
+         * @brief Discovers all objects not discovered yet in lazy mode,
+         * including spotted objects.
+         *
+         * @param putToRedis Whether newly discovered objects without VID
+         * should be put to current view.
+         */
+        void completeLazyDiscovery(
+                _In_ bool putToRedis);
+
     private:
 
         /*
@@ -219,6 +333,24 @@ class SaiSwitch
          */
         std::set<sai_object_id_t> m_discovered_rids;
 
+        /**
+         * @brief Objects discovered in lazy mode whose attributes were not
+         * queried yet.
+         */
+        std::set<sai_object_id_t> m_lazyPendingRids;
+
+        /**
+         * @brief Objects spotted in lazy mode, which will be queried by
+         * processSpottedRids.
+         */
+        std::set<sai_object_id_t> m_lazySpottedRids;
+
+        /**
+         * @brief Hardware lane map obtained from switch or from discovery
+         * snapshot.
+         */
+        std::unordered_map<sai_uint32_t, sai_object_id_t> m_laneMap;
+
         /*
          * SAI Methods.
          */
@@ -227,6 +359,12 @@ class SaiSwitch
 
         std::string saiGetHardwareInfo() const;
 
+        /**
+         * @brief Gets serialized values of all firmware attributes supported
+         * by switch.
+         */
+        std::string saiGetFirmwareInfo() const;
+
         std::vector<sai_object_id_t> saiGetPortList() const;
 
         std::unordered_map<sai_uint32_t, sai_object_id_t> saiGetHardwareLaneMap() const;
@@ -279,8 +417,11 @@ class SaiSwitch
         /**
          * @brief Discover objects on the swtich.
          *
-         * Method will query recursivly all OID attributes (oid and list) on
-         * the given object.
+         * Method will query all OID attributes (oid and list) on the given
+         * object and all objects reachable from it, in breadth first order.
+         * All OID attributes of object are queried using single GET if vendor
+         * supports it. Objects on the same level are queried in parallel
+         * when discovery concurrency is set.
          *
          * This method should be called only once inside constructor right
          * after switch has beed breated to obtain actual ASIC view.
@@ -293,6 +434,31 @@ class SaiSwitch
                 _In_ sai_object_id_t rid,
                 _Inout_ std::set<sai_object_id_t> &processed);
 
+        /**
+         * @brief Discovers objects starting from given level.
+         *
+         * @param pool Worker pool querying objects of single level.
+         * @param level Objects to query, they are queried even if they are
+         * already in discovered set.
+         * @param discovered Set of discovered objects.
+         * @param maxLevels Maximum number of levels to query.
+         *
+         * @return Objects referenced by last queried level, which were not
+         * queried because of maxLevels limit.
+         */
+        std::vector<sai_object_id_t> saiDiscoverLevels(
+                _In_ WorkerPool &pool,
+                _In_ std::vector<sai_object_id_t> level,
+                _Inout_ std::set<sai_object_id_t> &discovered,
+                _In_ size_t maxLevels);
+
+        /**
+         * @brief Queries objects and marks objects they reference as
+         * discovered and pending.
+         */
+        void saiLazyDiscover(
+                _In_ const std::vector<sai_object_id_t> &rids);
+
         /**
          * @brief Discover helper.
          *
@@ -300,8 +466,35 @@ class SaiSwitch
          */
         void helperDiscover();
 
+        void helperLazyDiscover();
+
         void helperPutDiscoveredRidsToRedis();
 
+        std::string getDiscoverySnapshotKey() const;
+
+        /**
+         * @brief Loads discovery result from snapshot.
+         *
+         * @return True if snapshot was loaded and spot check passed.
+         */
+        bool helperLoadDiscoverySnapshot();
+
+        void helperSaveDiscoverySnapshot() const;
+
+        std::string getWarmBootStateFile(
+                _In_ const std::string &warmBootFile) const;
+
+        std::string getWarmBootStateKey() const;
+
+        /**
+         * @brief Loads existing objects saved on warm shutdown.
+         *
+         * Throws when state is not present or was saved on different
+         * switch, since discovery can't tell apart default and user created
+         * objects after warm boot.
+         */
+        void helperLoadWarmBootState();
+
         void helperInternalOids();
 
         /*
@@ -329,6 +522,18 @@ class SaiSwitch
          * m_defaultOidMap[0x17][SAI_SCHEDULER_GROUP_ATTR_SCHEDULER_PROFILE_ID] == 0x16
          */
         std::unordered_map<sai_object_id_t, std::unordered_map<sai_attr_id_t, sai_object_id_t>> m_defaultOidMap;
+
+        static size_t m_discoveryConcurrency;
+
+        static std::shared_ptr<WorkerPool> m_workerPool;
+
+        static std::string m_discoverySnapshotFile;
+
+        static std::string m_discoverySnapshotConfigKey;
+
+        static bool m_lazyDiscovery;
+
+        static std::string m_warmBootReadFile;
 };
 
 extern std::map<sai_object_id_t, std::shared_ptr<SaiSwitch>> switches;
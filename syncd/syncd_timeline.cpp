@@ -0,0 +1,105 @@
+#include "syncd_timeline.h"
+
+#include "swss/logger.h"
+
+#include <chrono>
+
+std::shared_ptr<ChromeTrace> Timeline::m_trace;
+std::string Timeline::m_traceFile;
+thread_local int Timeline::m_depth = 0;
+
+void Timeline::enable(
+        _In_ const std::string &traceFile)
+{
+    SWSS_LOG_ENTER();
+
+    m_traceFile = traceFile;
+
+    m_trace = std::make_shared<ChromeTrace>(SYNCD_TIMELINE_MAX_EVENTS);
+
+    SWSS_LOG_NOTICE("timeline enabled, trace file: %s", m_traceFile.c_str());
+}
+
+bool Timeline::isEnabled()
+{
+    SWSS_LOG_ENTER();
+
+    return m_trace != nullptr;
+}
+
+uint64_t Timeline::getTimestamp()
+{
+    SWSS_LOG_ENTER();
+
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+Timeline::Span::Span(
+        _In_ const std::string &name):
+    m_active(Timeline::isEnabled())
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_active)
+    {
+        return;
+    }
+
+    m_depth++;
+
+    m_event.name = name;
+    m_event.category = "syncd";
+    m_event.tid = ChromeTrace::getThreadId();
+    m_event.duration = 0;
+    m_event.start = getTimestamp();
+}
+
+Timeline::Span::~Span()
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_active)
+    {
+        return;
+    }
+
+    m_event.duration = getTimestamp() - m_event.start;
+
+    m_trace->add(std::move(m_event));
+
+    if (--m_depth == 0)
+    {
+        /*
+         * Top level phase finished, file is rewritten with whole timeline so
+         * far, which is small since only phases are recorded.
+         */
+
+        m_trace->write(m_traceFile, false);
+    }
+}
+
+void Timeline::Span::addArg(
+        _In_ const std::string &name,
+        _In_ const std::string &value)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_active)
+    {
+        m_event.args.emplace_back(name, value);
+    }
+}
+
+void Timeline::Span::addArg(
+        _In_ const std::string &name,
+        _In_ uint64_t value)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_active)
+    {
+        m_event.args.emplace_back(name, std::to_string(value));
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef __SYNCD_TIMELINE_H__
+#define __SYNCD_TIMELINE_H__
+
+extern "C" {
+#include "sai.h"
+}
+
+#include "syncd_chrome_trace.h"
+
+#include <memory>
+#include <string>
+
+/**
+ * @def SYNCD_TIMELINE_MAX_EVENTS
+ *
+ * Maximum number of spans kept in timeline, spans are recorded only for long
+ * running phases so this is plenty.
+ */
+#define SYNCD_TIMELINE_MAX_EVENTS   (1 << 16)
+
+/**
+ * @brief Timeline of syncd phases like hard reinit, discovery and apply view.
+ *
+ * Phases are recorded as nested spans and when outermost span on thread
+ * ends, whole timeline is written to file in Chrome trace format, so it can
+ * be opened in chrome://tracing or Perfetto UI. When timeline is not enabled
+ * spans are not recorded.
+ */
+class Timeline
+{
+    public:
+
+        /**
+         * @brief Enables timeline.
+         *
+         * @param traceFile Output file, rewritten each time top level span
+         * ends.
+         */
+        static void enable(
+                _In_ const std::string &traceFile);
+
+        static bool isEnabled();
+
+    public:
+
+        /**
+         * @brief Records time between construction and destruction.
+         */
+        class Span
+        {
+            public:
+
+                Span(
+                        _In_ const std::string &name);
+
+                virtual ~Span();
+
+            public:
+
+                /**
+                 * @brief Adds argument displayed in span details, usually
+                 * object count.
+                 */
+                void addArg(
+                        _In_ const std::string &name,
+                        _In_ const std::string &value);
+
+                void addArg(
+                        _In_ const std::string &name,
+                        _In_ uint64_t value);
+
+            private:
+
+                Span(const Span&);
+                Span& operator=(const Span&);
+
+                bool m_active;
+
+                ChromeTraceEvent m_event;
+        };
+
+    private:
+
+        static uint64_t getTimestamp();
+
+        static std::shared_ptr<ChromeTrace> m_trace;
+
+        static std::string m_traceFile;
+
+        static thread_local int m_depth;
+};
+
+#endif // __SYNCD_TIMELINE_H__
@@ -12,6 +12,9 @@ extern "C" {
 #include "sai_redis.h"
 #include "meta/saiserialize.h"
 #include "syncd.h"
+#include "syncd_counter_ring.h"
+#include "syncd_flex_counter.h"
+#include "syncd_notification_queue.h"
 
 #include <map>
 #include <unordered_map>
@@ -120,10 +123,7 @@ void test_enable_recording()
     ASSERT_SUCCESS("Failed to enable recording");
 }
 
-class SaiAttrWrapper;
-extern std::unordered_map<std::string,
-       std::unordered_map<sai_attr_id_t,
-       std::shared_ptr<SaiAttrWrapper>>> ObjectAttrHash;
+extern void create_object(const sai_object_meta_key_t& meta_key);
 extern void object_reference_insert(sai_object_id_t oid);
 
 sai_object_id_t create_dummy_object_id(
@@ -218,8 +218,7 @@ void test_bulk_next_hop_group_member_create()
     sai_object_id_t hopgroup = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP_GROUP);
     object_reference_insert(hopgroup);
     sai_object_meta_key_t meta_key_hopgruop = { .objecttype = SAI_OBJECT_TYPE_NEXT_HOP_GROUP, .objectkey = { .key = { .object_id = hopgroup } } };
-    std::string hopgroup_key = sai_serialize_object_meta_key(meta_key_hopgruop);
-    ObjectAttrHash[hopgroup_key] = { };
+    create_object(meta_key_hopgruop);
     sai_object_id_t hopgroup_vid = translate_rid_to_vid(hopgroup, switch_id);
 
     for (uint32_t i = 0; i <  count; ++i)
@@ -228,8 +227,7 @@ void test_bulk_next_hop_group_member_create()
         sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP);
         object_reference_insert(hop);
         sai_object_meta_key_t meta_key_hop = { .objecttype = SAI_OBJECT_TYPE_NEXT_HOP, .objectkey = { .key = { .object_id = hop } } };
-        std::string hop_key = sai_serialize_object_meta_key(meta_key_hop);
-        ObjectAttrHash[hop_key] = { };
+        create_object(meta_key_hop);
         sai_object_id_t hop_vid = translate_rid_to_vid(hop, switch_id);
 
         std::vector<sai_attribute_t> list(2);
@@ -322,15 +320,13 @@ void test_bulk_route_set()
         sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER);
         object_reference_insert(vr);
         sai_object_meta_key_t meta_key_vr = { .objecttype = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .objectkey = { .key = { .object_id = vr } } };
-        std::string vr_key = sai_serialize_object_meta_key(meta_key_vr);
-        ObjectAttrHash[vr_key] = { };
+        create_object(meta_key_vr);
 
         // next hop
         sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP);
         object_reference_insert(hop);
         sai_object_meta_key_t meta_key_hop = { .objecttype = SAI_OBJECT_TYPE_NEXT_HOP, .objectkey = { .key = { .object_id = hop } } };
-        std::string hop_key = sai_serialize_object_meta_key(meta_key_hop);
-        ObjectAttrHash[hop_key] = { };
+        create_object(meta_key_hop);
 
         route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
         route_entry.destination.addr.ip4 = htonl(0x0a000000 | i);
@@ -408,6 +404,162 @@ void test_bulk_route_set()
     // if after consume we get pop we get expectd parameters
 }
 
+void test_counter_ring()
+{
+    SWSS_LOG_ENTER();
+
+    char path[] = "/tmp/syncd_tests_counters_ring_XXXXXX";
+
+    int fd = mkstemp(path);
+
+    if (fd < 0)
+    {
+        SWSS_LOG_THROW("failed to create counter ring file: %s", strerror(errno));
+    }
+
+    close(fd);
+
+    const std::string file = path;
+
+    const uint32_t depth = 4;
+
+    CounterRing ring(file, 2, depth, 100);
+
+    CounterRingReader reader;
+
+    if (!reader.open(file))
+    {
+        SWSS_LOG_THROW("failed to open counter ring");
+    }
+
+    for (uint64_t idx = 0; idx < 6; idx++)
+    {
+        ring.beginSample();
+
+        ring.put(0x1000000000001, SAI_OBJECT_TYPE_PORT, SAI_PORT_STAT_IF_IN_OCTETS, idx);
+
+        ring.commitSample();
+    }
+
+    auto samples = reader.readHistory(10000);
+
+    /*
+     * Oldest slot is reserved for writer, so only depth - 1 samples are
+     * available.
+     */
+
+    if (samples.size() != depth - 1)
+    {
+        SWSS_LOG_THROW("expected %u samples, got %zu", depth - 1, samples.size());
+    }
+
+    for (const auto &sample: samples)
+    {
+        if (sample.values.at(0) != sample.index || sample.values.at(1) != SAI_COUNTER_RING_NO_VALUE)
+        {
+            SWSS_LOG_THROW("invalid values in sample %lu", sample.index);
+        }
+    }
+
+    ring.removeObject(0x1000000000001);
+
+    if (reader.getColumns().at(0).vid != SAI_NULL_OBJECT_ID)
+    {
+        SWSS_LOG_THROW("column was not released after object remove");
+    }
+
+    ring.beginSample();
+
+    ring.put(0x1000000000002, SAI_OBJECT_TYPE_PORT, SAI_PORT_STAT_IF_IN_OCTETS, 100);
+
+    ring.commitSample();
+
+    /*
+     * Released column is reused, history of removed object must not be
+     * reported under new object.
+     */
+
+    if (reader.getColumns().at(0).vid != 0x1000000000002)
+    {
+        SWSS_LOG_THROW("released column was not reused");
+    }
+
+    samples = reader.readHistory(10000);
+
+    for (const auto &sample: samples)
+    {
+        uint64_t expected = (sample.index == 6) ? 100 : SAI_COUNTER_RING_NO_VALUE;
+
+        if (sample.values.at(0) != expected)
+        {
+            SWSS_LOG_THROW("invalid value in reused column in sample %lu", sample.index);
+        }
+    }
+
+    unlink(file.c_str());
+}
+
+void test_flex_counter_generic_port_remove()
+{
+    SWSS_LOG_ENTER();
+
+    sai_object_id_t portVid = create_dummy_object_id(SAI_OBJECT_TYPE_PORT);
+    sai_object_id_t portRid = create_dummy_object_id(SAI_OBJECT_TYPE_PORT);
+
+    std::vector<int32_t> counterIds = { SAI_PORT_STAT_IF_IN_OCTETS, SAI_PORT_STAT_IF_OUT_OCTETS };
+
+    FlexCounter::setObjectCounterList(SAI_OBJECT_TYPE_PORT, portVid, portRid, counterIds, false);
+
+    if (!FlexCounter::isObjectRegistered(SAI_OBJECT_TYPE_PORT, portVid))
+    {
+        SWSS_LOG_THROW("port was not registered by generic counter list");
+    }
+
+    /*
+     * Port registered by generic counter list must be removed same way as
+     * object of any other type, not by legacy port remove.
+     */
+
+    FlexCounter::removeCounters(SAI_OBJECT_TYPE_PORT, portVid);
+
+    if (FlexCounter::isObjectRegistered(SAI_OBJECT_TYPE_PORT, portVid))
+    {
+        SWSS_LOG_THROW("port registered by generic counter list was not removed");
+    }
+}
+
+void test_notification_queue_critical()
+{
+    SWSS_LOG_ENTER();
+
+    NotificationQueue queue({ 2, 2 }, { true, false });
+
+    for (int idx = 0; idx < 4; idx++)
+    {
+        if (!queue.enqueue(0, swss::KeyOpFieldsValuesTuple(std::to_string(idx), "", {})))
+        {
+            SWSS_LOG_THROW("critical notification %d was dropped", idx);
+        }
+
+        queue.enqueue(1, swss::KeyOpFieldsValuesTuple(std::to_string(idx), "", {}));
+    }
+
+    if (queue.getOverflowCount(0) != 2 || queue.getDroppedCount(0) != 0 || queue.getDroppedCount(1) != 2)
+    {
+        SWSS_LOG_THROW("invalid notification queue overflow and drop counts");
+    }
+
+    swss::KeyOpFieldsValuesTuple item;
+
+    for (int idx = 0; idx < 4; idx++)
+    {
+        if (!queue.tryDequeue(0, item) || kfvKey(item) != std::to_string(idx))
+        {
+            SWSS_LOG_THROW("critical notification %d was not dequeued in order", idx);
+        }
+    }
+}
+
 int main()
 {
     swss::Logger::getInstance().setMinPrio(swss::Logger::SWSS_DEBUG);
@@ -426,6 +578,12 @@ int main()
 
         test_bulk_route_set();
 
+        test_counter_ring();
+
+        test_flex_counter_generic_port_remove();
+
+        test_notification_queue_critical();
+
         sai_api_uninitialize();
 
         printf("\n[ %s ]\n\n", sai_serialize_status(SAI_STATUS_SUCCESS).c_str());
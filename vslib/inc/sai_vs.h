@@ -5,6 +5,9 @@ extern "C" {
 #include "sai.h"
 }
 
+#include "sairedis.h"
+#include "syncd/syncd_bulk_stats_api.h"
+
 #include "swss/logger.h"
 #include "meta/sai_meta.h"
 
@@ -69,6 +72,8 @@ extern const sai_virtual_router_api_t   vs_virtual_router_api;
 extern const sai_vlan_api_t             vs_vlan_api;
 extern const sai_wred_api_t             vs_wred_api;
 
+extern const sai_bulk_stats_api_t       vs_bulk_stats_api;
+
 // CREATE
 
 sai_status_t vs_generic_create(
@@ -127,6 +132,21 @@ sai_status_t vs_generic_set_route_entry(
         _In_ const sai_route_entry_t *route_entry,
         _In_ const sai_attribute_t *attr);
 
+// STATS
+
+sai_status_t vs_generic_get_stats(
+        _In_ sai_object_type_t object_type,
+        _In_ sai_object_id_t object_id,
+        _In_ uint32_t number_of_counters,
+        _In_ const int32_t *counter_ids,
+        _Out_ uint64_t *counters);
+
+sai_status_t vs_generic_clear_stats(
+        _In_ sai_object_type_t object_type,
+        _In_ sai_object_id_t object_id,
+        _In_ uint32_t number_of_counters,
+        _In_ const int32_t *counter_ids);
+
 // GET
 
 sai_status_t vs_generic_get(
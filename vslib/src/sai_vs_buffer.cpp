@@ -11,7 +11,12 @@ sai_status_t vs_get_ingress_priority_group_stats(
 
     SWSS_LOG_ENTER();
 
-    return SAI_STATUS_NOT_IMPLEMENTED;
+    return vs_generic_get_stats(
+            SAI_OBJECT_TYPE_INGRESS_PRIORITY_GROUP,
+            ingress_pg_id,
+            number_of_counters,
+            (const int32_t*)counter_ids,
+            counters);
 }
 
 sai_status_t vs_clear_ingress_priority_group_stats(
@@ -23,7 +28,11 @@ sai_status_t vs_clear_ingress_priority_group_stats(
 
     SWSS_LOG_ENTER();
 
-    return SAI_STATUS_NOT_IMPLEMENTED;
+    return vs_generic_clear_stats(
+            SAI_OBJECT_TYPE_INGRESS_PRIORITY_GROUP,
+            ingress_pg_id,
+            number_of_counters,
+            (const int32_t*)counter_ids);
 }
 
 sai_status_t vs_get_buffer_pool_stats(
@@ -36,7 +45,12 @@ sai_status_t vs_get_buffer_pool_stats(
 
     SWSS_LOG_ENTER();
 
-    return SAI_STATUS_NOT_IMPLEMENTED;
+    return vs_generic_get_stats(
+            SAI_OBJECT_TYPE_BUFFER_POOL,
+            pool_id,
+            number_of_counters,
+            (const int32_t*)counter_ids,
+            counters);
 }
 
 sai_status_t vs_clear_buffer_pool_stats(
@@ -48,7 +62,11 @@ sai_status_t vs_clear_buffer_pool_stats(
 
     SWSS_LOG_ENTER();
 
-    return SAI_STATUS_NOT_IMPLEMENTED;
+    return vs_generic_clear_stats(
+            SAI_OBJECT_TYPE_BUFFER_POOL,
+            pool_id,
+            number_of_counters,
+            (const int32_t*)counter_ids);
 }
 
 VS_GENERIC_QUAD(BUFFER_POOL,buffer_pool);
@@ -170,6 +170,12 @@ sai_status_t sai_api_query(
         return SAI_STATUS_UNINITIALIZED;
     }
 
+    if (sai_api_id == SAI_API_BULK_STATS)
+    {
+        *(const sai_bulk_stats_api_t**)api_method_table = &vs_bulk_stats_api;
+        return SAI_STATUS_SUCCESS;
+    }
+
     switch (sai_api_id)
     {
         API_CASE(ACL,acl);
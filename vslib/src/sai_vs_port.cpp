@@ -7,9 +7,16 @@ sai_status_t vs_get_port_stats(
         _In_ const sai_port_stat_t *counter_ids,
         _Out_ uint64_t *counters)
 {
+    MUTEX();
+
     SWSS_LOG_ENTER();
 
-    return SAI_STATUS_NOT_IMPLEMENTED;
+    return vs_generic_get_stats(
+            SAI_OBJECT_TYPE_PORT,
+            port_id,
+            number_of_counters,
+            (const int32_t*)counter_ids,
+            counters);
 }
 
 sai_status_t vs_clear_port_stats(
@@ -21,7 +28,11 @@ sai_status_t vs_clear_port_stats(
 
     SWSS_LOG_ENTER();
 
-    return SAI_STATUS_NOT_IMPLEMENTED;
+    return vs_generic_clear_stats(
+            SAI_OBJECT_TYPE_PORT,
+            port_id,
+            number_of_counters,
+            (const int32_t*)counter_ids);
 }
 
 sai_status_t vs_clear_port_all_stats(
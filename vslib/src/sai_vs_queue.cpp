@@ -11,7 +11,12 @@ sai_status_t vs_get_queue_stats(
 
     SWSS_LOG_ENTER();
 
-    return SAI_STATUS_NOT_IMPLEMENTED;
+    return vs_generic_get_stats(
+            SAI_OBJECT_TYPE_QUEUE,
+            queue_id,
+            number_of_counters,
+            (const int32_t*)counter_ids,
+            counters);
 }
 
 sai_status_t vs_clear_queue_stats(
@@ -23,7 +28,11 @@ sai_status_t vs_clear_queue_stats(
 
     SWSS_LOG_ENTER();
 
-    return SAI_STATUS_NOT_IMPLEMENTED;
+    return vs_generic_clear_stats(
+            SAI_OBJECT_TYPE_QUEUE,
+            queue_id,
+            number_of_counters,
+            (const int32_t*)counter_ids);
 }
 
 VS_GENERIC_QUAD(QUEUE,queue);
@@ -0,0 +1,155 @@
+#include "sai_vs.h"
+#include "sai_vs_internal.h"
+#include "sai_vs_state.h"
+
+/*
+ * Virtual switch has no data plane, so all counters of existing objects are
+ * always zero. Both single object and bulk entry points are going through the
+ * same path, so they will return exactly same values.
+ */
+
+static sai_status_t vs_check_stats_object(
+        _In_ sai_object_type_t object_type,
+        _In_ sai_object_id_t object_id)
+{
+    SWSS_LOG_ENTER();
+
+    if (sai_object_type_query(object_id) != object_type)
+    {
+        SWSS_LOG_ERROR("object %s is not %s",
+                sai_serialize_object_id(object_id).c_str(),
+                sai_serialize_object_type(object_type).c_str());
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    sai_object_id_t switch_id = sai_switch_id_query(object_id);
+
+    auto it = g_switch_state_map.find(switch_id);
+
+    if (it == g_switch_state_map.end())
+    {
+        SWSS_LOG_ERROR("switch %s don't exists",
+                sai_serialize_object_id(switch_id).c_str());
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    auto &objectHash = it->second->objectHash.at(object_type);
+
+    if (objectHash.find(sai_serialize_object_id(object_id)) == objectHash.end())
+    {
+        SWSS_LOG_ERROR("not found %s:%s",
+                sai_serialize_object_type(object_type).c_str(),
+                sai_serialize_object_id(object_id).c_str());
+
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t vs_generic_get_stats(
+        _In_ sai_object_type_t object_type,
+        _In_ sai_object_id_t object_id,
+        _In_ uint32_t number_of_counters,
+        _In_ const int32_t *counter_ids,
+        _Out_ uint64_t *counters)
+{
+    SWSS_LOG_ENTER();
+
+    if (number_of_counters == 0 || counter_ids == NULL || counters == NULL)
+    {
+        SWSS_LOG_ERROR("invalid counters parameters");
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    CHECK_STATUS(vs_check_stats_object(object_type, object_id));
+
+    for (uint32_t idx = 0; idx < number_of_counters; idx++)
+    {
+        counters[idx] = 0;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t vs_generic_clear_stats(
+        _In_ sai_object_type_t object_type,
+        _In_ sai_object_id_t object_id,
+        _In_ uint32_t number_of_counters,
+        _In_ const int32_t *counter_ids)
+{
+    SWSS_LOG_ENTER();
+
+    if (number_of_counters == 0 || counter_ids == NULL)
+    {
+        SWSS_LOG_ERROR("invalid counters parameters");
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return vs_check_stats_object(object_type, object_id);
+}
+
+sai_status_t vs_bulk_get_stats(
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ uint32_t number_of_counters,
+        _In_ const int32_t *counter_ids,
+        _Out_ uint64_t *counters,
+        _Out_ sai_status_t *object_statuses)
+{
+    MUTEX();
+
+    SWSS_LOG_ENTER();
+
+    if (object_count == 0 || object_id == NULL || object_statuses == NULL)
+    {
+        SWSS_LOG_ERROR("invalid bulk parameters");
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    switch (object_type)
+    {
+        case SAI_OBJECT_TYPE_PORT:
+        case SAI_OBJECT_TYPE_QUEUE:
+        case SAI_OBJECT_TYPE_INGRESS_PRIORITY_GROUP:
+        case SAI_OBJECT_TYPE_BUFFER_POOL:
+            break;
+
+        default:
+
+            SWSS_LOG_WARN("bulk stats not supported on %s",
+                    sai_serialize_object_type(object_type).c_str());
+
+            return SAI_STATUS_NOT_SUPPORTED;
+    }
+
+    sai_status_t status = SAI_STATUS_SUCCESS;
+
+    for (uint32_t idx = 0; idx < object_count; idx++)
+    {
+        object_statuses[idx] = vs_generic_get_stats(
+                object_type,
+                object_id[idx],
+                number_of_counters,
+                counter_ids,
+                counters + (size_t)idx * number_of_counters);
+
+        if (object_statuses[idx] != SAI_STATUS_SUCCESS)
+        {
+            status = SAI_STATUS_FAILURE;
+        }
+    }
+
+    return status;
+}
+
+const sai_bulk_stats_api_t vs_bulk_stats_api = {
+
+    vs_bulk_get_stats,
+};
@@ -1,6 +1,7 @@
 #include <map>
 #include <string>
 #include <vector>
+#include <algorithm>
 
 #include "swss/logger.h"
 
@@ -137,6 +138,106 @@ void test_ports()
     ASSERT_TRUE(attr.value.objlist.count == expected_ports);
 }
 
+void test_bulk_stats()
+{
+    SWSS_LOG_ENTER();
+
+    uint32_t expected_ports = 32;
+
+    sai_attribute_t attr;
+
+    sai_object_id_t switch_id;
+
+    attr.id = SAI_SWITCH_ATTR_INIT_SWITCH;
+    attr.value.booldata = true;
+
+    SUCCESS(sai_metadata_sai_switch_api->create_switch(&switch_id, 1, &attr));
+
+    std::vector<sai_object_id_t> ports;
+
+    ports.resize(expected_ports);
+
+    attr.id = SAI_SWITCH_ATTR_PORT_LIST;
+    attr.value.objlist.count = expected_ports;
+    attr.value.objlist.list = ports.data();
+
+    SUCCESS(sai_metadata_sai_switch_api->get_switch_attribute(switch_id, 1, &attr));
+
+    const sai_bulk_stats_api_t *api = NULL;
+
+    SUCCESS(sai_api_query(SAI_API_BULK_STATS, (void**)&api));
+
+    ASSERT_TRUE(api != NULL && api->get_bulk_stats != NULL);
+
+    std::vector<int32_t> counter_ids = { SAI_PORT_STAT_IF_IN_OCTETS, SAI_PORT_STAT_IF_OUT_OCTETS };
+
+    std::vector<uint64_t> counters(ports.size() * counter_ids.size(), UINT64_MAX);
+
+    std::vector<sai_status_t> statuses(ports.size(), SAI_STATUS_FAILURE);
+
+    SUCCESS(api->get_bulk_stats(
+                SAI_OBJECT_TYPE_PORT,
+                (uint32_t)ports.size(),
+                ports.data(),
+                (uint32_t)counter_ids.size(),
+                counter_ids.data(),
+                counters.data(),
+                statuses.data()));
+
+    for (size_t idx = 0; idx < ports.size(); idx++)
+    {
+        ASSERT_TRUE(statuses[idx] == SAI_STATUS_SUCCESS);
+    }
+
+    for (auto counter: counters)
+    {
+        ASSERT_TRUE(counter == 0);
+    }
+
+    // single object call must return same values as bulk
+
+    std::vector<uint64_t> port_counters(counter_ids.size(), UINT64_MAX);
+
+    SUCCESS(sai_metadata_sai_port_api->get_port_stats(
+                ports[0],
+                (uint32_t)counter_ids.size(),
+                (const sai_port_stat_t*)counter_ids.data(),
+                port_counters.data()));
+
+    ASSERT_TRUE(std::equal(port_counters.begin(), port_counters.end(), counters.begin()));
+
+    SUCCESS(sai_metadata_sai_port_api->clear_port_stats(
+                ports[0],
+                (uint32_t)counter_ids.size(),
+                (const sai_port_stat_t*)counter_ids.data()));
+
+    // object which is not port must fail only on its index
+
+    ports[1] = switch_id;
+
+    ASSERT_TRUE(api->get_bulk_stats(
+                SAI_OBJECT_TYPE_PORT,
+                (uint32_t)ports.size(),
+                ports.data(),
+                (uint32_t)counter_ids.size(),
+                counter_ids.data(),
+                counters.data(),
+                statuses.data()) == SAI_STATUS_FAILURE);
+
+    ASSERT_TRUE(statuses[0] == SAI_STATUS_SUCCESS);
+    ASSERT_TRUE(statuses[1] != SAI_STATUS_SUCCESS);
+    ASSERT_TRUE(statuses[2] == SAI_STATUS_SUCCESS);
+
+    ASSERT_TRUE(api->get_bulk_stats(
+                SAI_OBJECT_TYPE_ROUTE_ENTRY,
+                (uint32_t)ports.size(),
+                ports.data(),
+                (uint32_t)counter_ids.size(),
+                counter_ids.data(),
+                counters.data(),
+                statuses.data()) == SAI_STATUS_NOT_SUPPORTED);
+}
+
 int main()
 {
     swss::Logger::getInstance().setMinPrio(swss::Logger::SWSS_DEBUG);
@@ -153,5 +254,7 @@ int main()
 
     test_ports();
 
+    test_bulk_stats();
+
     return 0;
 }